@@ -6,9 +6,21 @@ if (ENABLE_DEPRECATED_INFO)
     add_compile_definitions(_DEPRECATED_INFO_=1)
 endif()
 
+# 低于该级别的 LOGG / LOG_IF_ENABLED 调用在编译期移除, 顺序与 LogLevel 一致
+set(LOG_LEVEL_NAMES DEBUG INFO SUCCESS WARNING ERROR FATAL_ERROR)
+set(LOG_MIN_LEVEL "DEBUG" CACHE STRING "Lowest log level compiled into the binary")
+set_property(CACHE LOG_MIN_LEVEL PROPERTY STRINGS ${LOG_LEVEL_NAMES})
+
+list(FIND LOG_LEVEL_NAMES "${LOG_MIN_LEVEL}" LOG_MIN_LEVEL_INDEX)
+if (LOG_MIN_LEVEL_INDEX EQUAL -1)
+    message(FATAL_ERROR "LOG_MIN_LEVEL must be one of: ${LOG_LEVEL_NAMES} (got '${LOG_MIN_LEVEL}')")
+endif()
+add_compile_definitions(LOG_MIN_LEVEL=${LOG_MIN_LEVEL_INDEX})
+
 function(project_verbose_module_detail)
     pretty_message(DEBUG "ProjectVerbose.cmake module loaded.")
     pretty_message(VINFO_BANNER "ProjectVerbose Configuration" "=" ${BANNER_WIDTH})
     pretty_message_kv(VINFO "ENABLE_DEPRECATED_INFO" "${ENABLE_DEPRECATED_INFO}")
+    pretty_message_kv(VINFO "LOG_MIN_LEVEL" "${LOG_MIN_LEVEL}")
     pretty_message(VINFO_BANNER "=" ${BANNER_WIDTH})
 endfunction()
@@ -152,10 +152,12 @@ function(module_show_dependencies TARGET_NAME)
     endif()
 endfunction()
 
-# 用法: module_end(<module_name> <target_name> [OPTIONS])
+# 用法: module_end(<module_name> <target_name> [<target_name>...] [OPTIONS])
 function(module_end MODULE_NAME TARGET_NAME)
     set(options SHOW_SUMMARY NO_TIMING)
     cmake_parse_arguments(ARG "${options}" "" "" ${ARGN})
+    # 一个模块可以有多个目标 (例如多个独立的工具程序)
+    set(TARGET_NAMES ${TARGET_NAME} ${ARG_UNPARSED_ARGUMENTS})
     
     if (NOT ARG_NO_TIMING)
         string(TIMESTAMP MODULE_END_TIME "%s")
@@ -168,20 +170,25 @@ function(module_end MODULE_NAME TARGET_NAME)
     list(APPEND CONFIGURED_MODULES ${MODULE_NAME})
     set(CONFIGURED_MODULES ${CONFIGURED_MODULES} CACHE INTERNAL "List of configured modules")
 
-    set(MODULE_INFO_${MODULE_NAME}_TARGET ${TARGET_NAME} CACHE INTERNAL "")
+    set(MODULE_INFO_${MODULE_NAME}_TARGET "${TARGET_NAMES}" CACHE INTERNAL "")
     set(MODULE_INFO_${MODULE_NAME}_DIR    ${CMAKE_CURRENT_SOURCE_DIR} CACHE INTERNAL "")
     
     pretty_message(SUCCESS "${MODULE_NAME} module configured ${TIMING_INFO}")
 
-    if (ARG_SHOW_SUMMARY AND TARGET ${TARGET_NAME})
+    if (ARG_SHOW_SUMMARY)
         pretty_message(INFO "Module Summary: ")
-        get_target_property(target_type ${TARGET_NAME} TYPE)
-        pretty_message(INFO "  Target: ${TARGET_NAME} (${target_type})")
-        
-        get_target_property(install_dest ${TARGET_NAME} INSTALL_RPATH_USE_LINK_PATH)
-        if (install_dest)
-            pretty_message(INFO "  Will be installed: Yes")
-        endif()
+        foreach(target ${TARGET_NAMES})
+            if (NOT TARGET ${target})
+                continue()
+            endif()
+            get_target_property(target_type ${target} TYPE)
+            pretty_message(INFO "  Target: ${target} (${target_type})")
+
+            get_target_property(install_dest ${target} INSTALL_RPATH_USE_LINK_PATH)
+            if (install_dest)
+                pretty_message(INFO "  Will be installed: Yes")
+            endif()
+        endforeach()
     endif()
 
     pretty_message(VINFO_LINE "=" ${BANNER_WIDTH})
@@ -201,16 +208,20 @@ function(show_all_modules_summary)
    
     pretty_message(INFO "Configured modules: ")
     foreach(module ${CONFIGURED_MODULES})
-        set(target ${MODULE_INFO_${module}_TARGET})
-        set(dir    ${MODULE_INFO_${module}_DIR})
-
-        if (TARGET ${target})
-            get_target_property(target_type ${target} TYPE)
-            pretty_message(SUCCESS "  ✓ ${module}")
-            pretty_message(INFO    "    Target: ${target} (${target_type})")
-            pretty_message(INFO    "    Location: ${dir}")
-        else()
-            pretty_message(SUCCESS "  ✓ ${module}")
+        set(targets ${MODULE_INFO_${module}_TARGET})
+        set(dir     ${MODULE_INFO_${module}_DIR})
+
+        pretty_message(SUCCESS "  ✓ ${module}")
+        set(has_target FALSE)
+        foreach(target ${targets})
+            if (TARGET ${target})
+                get_target_property(target_type ${target} TYPE)
+                pretty_message(INFO "    Target: ${target} (${target_type})")
+                set(has_target TRUE)
+            endif()
+        endforeach()
+        if (has_target)
+            pretty_message(INFO "    Location: ${dir}")
         endif()
     endforeach()
     pretty_message(STATUS_LINE "=" ${BANNER_WIDTH})
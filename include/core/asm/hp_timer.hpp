@@ -172,6 +172,11 @@ public:
         return TimePoint{};
     }
 
+    // 仅读取周期计数, 不读取墙钟, 适合热路径上的打点
+    [[nodiscard]] static auto cycles() noexcept -> cycle_count_t {
+        return get_cpu_cycles();
+    }
+
     [[nodiscard]] static auto get_cpu_frequency() -> double {
         if (!frequency_calibarted) calibrate_frequency();
         return cpu_frequency_ghz;
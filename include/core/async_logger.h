@@ -2,32 +2,137 @@
 #define ASYNC_LOGGER_H
 
 #include "utils/singleton.h"
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <core/message_queue.hpp>
+#include <core/binary_log.hpp>
+#include <core/executor.hpp>
+#include <core/flight_recorder.hpp>
+#include <core/log_codec.hpp>
+#include <core/log_site.hpp>
+#include <core/log_throttle.hpp>
+#include <core/log_sink.hpp>
+#include <core/queue/byte_ring.hpp>
+#include <core/queue/lock_free_queue.hpp>
+#include <core/sync_wait.hpp>
 #include <csignal>
 #include <cstddef>
+#include <cstring>
+#include <fmt/format.h>
 #include <memory>
 #include <mutex>
 #include <ostream>
+#include <sstream>
 #include <thread>
 #include "core/logger.hpp"
 namespace labelimg::core::logger {
 
+namespace detail {
+
+// 每个线程一个可增长的格式化缓冲区, 容量只增不减, 稳态下格式化不再分配
+inline auto log_buffer() -> fmt::memory_buffer& {
+    thread_local fmt::memory_buffer buffer;
+    return buffer;
+}
+
+// 消息字符串回收池: 后台线程写出后归还, 生产者取出后复用其容量
+//  - 池满或字符串过大时直接释放, 避免偶发的超长消息长期占用内存
+class MessagePool: private NonCopyable {
+public:
+    static auto instance() -> MessagePool& {
+        static MessagePool pool;
+        return pool;
+    }
+
+    // 返回一个空字符串, 池中有存货时带有之前的容量
+    [[nodiscard]] auto acquire() -> std::string {
+        std::string message;
+        m_free.try_pop(message);
+        return message;
+    }
+
+    void recycle(std::string&& message) {
+        if (message.capacity() <= sso_capacity || message.capacity() > max_capacity) return;
+        message.clear();
+        m_free.try_push(std::move(message));
+    }
+private:
+    MessagePool() = default;
+
+    static constexpr size_t sso_capacity = std::string{}.capacity();
+    static constexpr size_t max_capacity = 4096;
+
+    queue::MessageQueue<std::string, queue::LockFreePolicy<1024>> m_free;
+};
+
+// 把一批消息交给 sink, 写出后把字符串归还回收池; records 是调用方复用的临时数组
+inline void write_to_sink(LogSink& sink, std::vector<std::string>& batch, std::vector<LogRecord>& records) {
+    records.clear();
+    for (const auto& message: batch) {
+        if (!message.empty()) records.push_back(LogRecord{.text = message});
+    }
+    if (!records.empty()) sink.write(records);
+
+    for (auto& message: batch) MessagePool::instance().recycle(std::move(message));
+    batch.clear();
+}
+
+template <typename T>
+concept FmtFormattable = fmt::is_formattable<T>::value;
+
+template <typename T>
+concept OstreamFormattable = requires (std::ostream& os, const T& value) { os << value; };
+
+} // namespace detail
+
+// 一条日志记录: 析构时追加换行并写入当前线程的日志环 (ThreadRingAsyncLogger), 由其后台线程输出
+//  - level 随记录交给 sink, 用于按级别过滤与立即写出 (例如 FileSinkOptions::flush_level)
+//  - 内容直接写入线程局部缓冲区, 不构造 ostringstream, 不依赖 locale
+//  - 同一线程内嵌套的 LogStream (例如 operator<< 中又打了日志) 各自使用缓冲区的不同区段
 class LogStream: private NonCopyable  {
 public:
-    LogStream();
+    explicit LogStream(LogLevel level = LogLevel::INFO);
     ~LogStream();
 
     template <typename T>
-    auto operator<<(const T& value) -> LogStream& {
-        m_oss << value;
+        requires detail::FmtFormattable<T> || detail::OstreamFormattable<T>
+    auto operator<<(const T& value) -> LogStream&;
+
+    // fmt 风格的格式化追加: async_log.format("{} / {}", done, total)
+    template <typename... Args>
+    auto format(fmt::format_string<Args...> fmt_str, Args&&... args) -> LogStream& {
+        fmt::format_to(std::back_inserter(m_buffer), fmt_str, std::forward<Args>(args)...);
         return *this;
     }
 private:
-    std::ostringstream m_oss;
+    fmt::memory_buffer& m_buffer;
+    size_t m_begin;
+    LogLevel m_level;
 };
 
+template <typename T>
+    requires detail::FmtFormattable<T> || detail::OstreamFormattable<T>
+auto LogStream::operator<<(const T& value) -> LogStream& {
+    if constexpr (std::is_same_v<T, char>) {
+        m_buffer.push_back(value);
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        std::string_view text{value};
+        m_buffer.append(text.data(), text.data() + text.size());
+    } else if constexpr (detail::FmtFormattable<T>) {
+        fmt::format_to(std::back_inserter(m_buffer), "{}", value);
+    } else {
+        // 只支持 ostream 输出的类型: 复用线程局部的 ostringstream
+        thread_local std::ostringstream oss;
+        oss.str({});
+        oss << value;
+        auto text = oss.view();
+        m_buffer.append(text.data(), text.data() + text.size());
+    }
+    return *this;
+}
+
 #define async_log LogStream()
 namespace v1 {
 
@@ -70,6 +175,9 @@ class AsyncLogger<queue::MutexPolicy>: public AsyncLoggerApi<AsyncLogger<queue::
 public:
     void log_impl(std::string message);
     void stop_impl();
+
+    // 替换输出端 (默认为标准输出); 旧 sink 先写出缓冲内容
+    void set_sink(std::shared_ptr<LogSink> sink);
 private:
     AsyncLogger();
     ~AsyncLogger();
@@ -99,24 +207,45 @@ public:
         }
     }
 
+    void set_sink(std::shared_ptr<LogSink> sink) {
+        std::lock_guard<std::mutex> lock{m_sink_mutex};
+        m_sink->flush();
+        m_sink = std::move(sink);
+    }
+
 private:
+    // 每次唤醒取走全部积压消息, 整批交给 sink; 队列已空时才让 sink 写出缓冲
     void worker_thread_func() {
+        std::vector<std::string> batch;
+        std::vector<LogRecord> records;
+
+        // stop() 会推入空消息唤醒本线程, 因此可以无限期等待而不必定时轮询 m_done
         while (!m_done) {
-            std::string message;
-            
-            if (m_queue.wait_for_pop(message, std::chrono::milliseconds(100))) {
-                if (m_done && message.empty()) break;
-                std::cout << message << std::flush;
-            }
-        }
-        std::string message;
-        while (m_queue.try_pop(message)) {
-            if (!message.empty()) std::cout << message << std::flush;
+            m_queue.wait_and_drain_into(batch);
+
+            std::lock_guard<std::mutex> lock{m_sink_mutex};
+            detail::write_to_sink(*m_sink, batch, records);
+            if (m_queue.empty()) m_sink->flush();
         }
+
+        m_queue.drain_into(batch);
+        std::lock_guard<std::mutex> lock{m_sink_mutex};
+        detail::write_to_sink(*m_sink, batch, records);
+        m_sink->flush();
     }
 
+    // 日志风暴时对生产者施加背压, 而不是无限增长内存
+    static constexpr size_t queue_capacity = 1 << 16;
+    // 后台线程空闲时休眠在 futex 上, 繁忙时生产者不产生任何唤醒调用
+    using QueuePolicy = queue::BoundedMutexPolicy<queue_capacity, queue::OverflowPolicy::Block, queue::AtomicWait>;
+
     std::atomic<bool> m_done;
-    queue::MessageQueue<std::string, queue::MutexPolicy> m_queue;
+    queue::MessageQueue<std::string, QueuePolicy> m_queue;
+
+    // 只在后台线程写出时与 set_sink 竞争
+    std::mutex m_sink_mutex;
+    std::shared_ptr<LogSink> m_sink = std::make_shared<ConsoleSink>();
+
     std::thread m_worker;
 };
 
@@ -132,6 +261,10 @@ inline void AsyncLogger<queue::MutexPolicy>::stop_impl() {
     pImpl->stop();
 }
 
+inline void AsyncLogger<queue::MutexPolicy>::set_sink(std::shared_ptr<LogSink> sink) {
+    pImpl->set_sink(std::move(sink));
+}
+
 template <>
 class AsyncLogger<queue::CoroutinePolicy>: public AsyncLoggerApi<AsyncLogger<queue::CoroutinePolicy>>
                                          , public Singleton<AsyncLogger<queue::CoroutinePolicy>> {
@@ -140,6 +273,9 @@ public:
     void log_impl(std::string message);
     void stop_impl();                                
     void run_util_complete();
+
+    // 替换输出端 (默认为标准输出); 旧 sink 先写出缓冲内容
+    void set_sink(std::shared_ptr<LogSink> sink);
 private:
     AsyncLogger();
     ~AsyncLogger();
@@ -151,10 +287,15 @@ private:
 class AsyncLogger<queue::CoroutinePolicy>::Impl {
 public:
     Impl(): m_done{false}
+          , m_queue{m_executor}
           , m_worker_task(worker_coroutine())
           { }
 
-    ~Impl() { stop(); }
+    ~Impl() { 
+        stop(); 
+        // 等执行器线程退出, 保证协程已停在 final_suspend 后再销毁协程帧
+        m_executor.shutdown();
+    }
 
     void log(std::string message) {
         m_queue.push(std::move(message));
@@ -165,33 +306,55 @@ public:
     }
 
     void run_until_complete() {
-        while (!m_worker_task.is_ready()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        }
+        queue::sync_wait(m_worker_task);
+    }
+
+    void set_sink(std::shared_ptr<LogSink> sink) {
+        std::lock_guard<std::mutex> lock{m_sink_mutex};
+        m_sink->flush();
+        m_sink = std::move(sink);
     }
 
+    // 每次恢复后顺带取走已积压的消息, 整批写出后再让 sink 写出缓冲
     auto worker_coroutine() -> queue::Task<void> {
+        std::vector<std::string> batch;
+        std::vector<LogRecord> records;
+
         while (!m_done) {
             try {                                      
                 std::string message = co_await m_queue.async_pop();
 
                 if (m_done && message.empty()) break;
 
-                if (!message.empty()) std::cout << message << std::flush;
+                batch.push_back(std::move(message));
+                while (auto more = m_queue.try_pop()) batch.push_back(std::move(*more));
+                write_batch(batch, records);
             } catch (const std::exception& e) {
                 std::cerr << "Logger coroutine error: " << e.what() << '\n';
             }
         }
         
-        while (auto msg = m_queue.try_pop()) {
-            if (msg->empty()) std::cout << *msg << std::flush;
-        }
+        while (auto more = m_queue.try_pop()) batch.push_back(std::move(*more));
+        write_batch(batch, records);
 
         co_return;
     }
 private:
+    // 积压的消息写完 (队列已空) 才让 sink 写出缓冲; 繁忙时多批合并为一次写出
+    void write_batch(std::vector<std::string>& batch, std::vector<LogRecord>& records) {
+        std::lock_guard<std::mutex> lock{m_sink_mutex};
+        detail::write_to_sink(*m_sink, batch, records);
+        if (m_queue.empty()) m_sink->flush();
+    }
+
     std::atomic<bool> m_done;
-    queue::MessageQueue<std::string, queue::CoroutinePolicy> m_queue;
+    // 消费协程在专用线程上恢复, 调用 log() 的线程不会被拖去写输出
+    queue::ThreadExecutor m_executor;
+    queue::MessageQueue<std::string, queue::BasicCoroutinePolicy<queue::ThreadExecutor>> m_queue;
+
+    std::mutex m_sink_mutex;
+    std::shared_ptr<LogSink> m_sink = std::make_shared<ConsoleSink>();
+
     queue::Task<void> m_worker_task; 
 };
 
@@ -214,8 +377,507 @@ inline void AsyncLogger<queue::CoroutinePolicy>::run_util_complete() {
     pImpl->run_until_complete();
 }
 
+inline void AsyncLogger<queue::CoroutinePolicy>::set_sink(std::shared_ptr<LogSink> sink) {
+    pImpl->set_sink(std::move(sink));
+}
+
+// 每个生产者线程写自己的 SPSC 字节环, 单个后台线程按时间戳归并后写出
+struct ThreadRingPolicy {};
+
+template <>
+class AsyncLogger<ThreadRingPolicy>: public AsyncLoggerApi<AsyncLogger<ThreadRingPolicy>>
+                                   , public Singleton<AsyncLogger<ThreadRingPolicy>> {
+    MAKE_SINGLETON_NO_DEFAULT_CTOR_DTOR(AsyncLogger<ThreadRingPolicy>)
+public:
+    void log_impl(std::string message);
+    // 热路径: 只写当前线程的环, 不加锁, 也没有读改写操作; level 交给 sink 用于过滤与写出策略
+    void write(std::string_view message, LogLevel level = LogLevel::INFO);
+
+    // 延迟格式化: 只记录格式串指针和参数的二进制编码, 由后台线程格式化并追加换行
+    // 格式串必须是编译期常量, 见 basic_deferred_format_string
+    template <DeferredLogArg... Args>
+    void log_deferred(deferred_format_string<Args...> format, const Args&... args) {
+        write_deferred<Args...>(LogLevel::INFO, &DeferredFormat<Args...>::format_line, format, args...);
+    }
+
+    // 指定级别与后台线程上的格式化函数, 用于在格式化结果外再加工 (例如 qtils 的分行与着色)
+    template <DeferredLogArg... Args>
+    void write_deferred(LogLevel level, DeferredFormatter formatter, deferred_format_string<Args...> format, const Args&... args);
+
+    // 已注册调用点的记录: 只写调用点指针、时间戳和参数编码
+    template <DeferredLogArg... Args>
+    void write_site(const LogSite& site, const Args&... args);
+
+    // 打开二进制日志后, 所有记录改为写入该文件 (调用点记录按二进制格式, 其余按文本记录)
+    [[nodiscard]] auto open_binary_log(const std::filesystem::path& path) -> bool;
+    void close_binary_log();
+
+    // 替换文本输出端 (默认为标准输出); 调用前写入的记录仍写到旧 sink
+    void set_sink(std::shared_ptr<LogSink> sink);
+
+    void stop_impl();
+private:
+    AsyncLogger();
+    ~AsyncLogger();
+
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+class AsyncLogger<ThreadRingPolicy>::Impl {
+public:
+    Impl(): m_done{false}, m_can_park{queue::detail::asymmetric_barrier_supported()} {
+        m_worker = std::thread{&AsyncLogger::Impl::drain_thread_func, this};
+    }
+
+    ~Impl() { stop(); }
+
+    void write(std::string_view message, LogLevel level) {
+        if (m_done.load(std::memory_order_relaxed)) return;
+
+        Producer& producer = local_producer();
+        const auto timestamp = now();
+
+        // 超过单条记录上限的消息拆成多条, 同一个环内保持顺序
+        do {
+            auto chunk = message.substr(0, Ring::max_record_size - sizeof(RecordHeader));
+            message.remove_prefix(chunk.size());
+
+            std::byte* bytes = reserve(producer, sizeof(RecordHeader) + chunk.size());
+            if (bytes == nullptr) return;
+            bytes = detail::store(bytes, RecordHeader{timestamp, nullptr, nullptr, level});
+            std::memcpy(bytes, chunk.data(), chunk.size());
+            producer.ring.commit();
+        } while (!message.empty());
+
+        wake_if_needed(producer);
+    }
+
+    // 记录内容: 记录头 | 格式串指针 | 格式串长度 | 参数编码
+    template <DeferredLogArg... Args>
+    void write_deferred(LogLevel level, DeferredFormatter formatter, std::string_view format, const Args&... args) {
+        if (m_done.load(std::memory_order_relaxed)) return;
+
+        const size_t size = sizeof(RecordHeader) + sizeof(const char*) + sizeof(size_t)
+                          + DeferredFormat<Args...>::encoded_size(args...);
+        // 参数过大时退回到调用方格式化, 再按文本拆分写入
+        if (size > Ring::max_record_size) [[unlikely]] {
+            std::vector<std::byte> encoded(DeferredFormat<Args...>::encoded_size(args...));
+            DeferredFormat<Args...>::encode(encoded.data(), args...);
+
+            fmt::memory_buffer text;
+            formatter(format, encoded.data(), text);
+            write({text.data(), text.size()}, level);
+            return;
+        }
+
+        Producer& producer = local_producer();
+        std::byte* bytes = reserve(producer, size);
+        if (bytes == nullptr) return;
+
+        bytes = detail::store(bytes, RecordHeader{now(), formatter, nullptr, level});
+        bytes = detail::store(bytes, format.data());
+        bytes = detail::store(bytes, format.size());
+        DeferredFormat<Args...>::encode(bytes, args...);
+        producer.ring.commit();
+
+        wake_if_needed(producer);
+    }
+
+    // 记录内容: 记录头 | 参数编码; 格式串与格式化函数从调用点取得
+    template <DeferredLogArg... Args>
+    void write_site(const LogSite& site, const Args&... args) {
+        if (m_done.load(std::memory_order_relaxed)) return;
+
+        const size_t size = sizeof(RecordHeader) + DeferredFormat<Args...>::encoded_size(args...);
+        if (size > Ring::max_record_size) [[unlikely]] {
+            write_deferred(static_cast<LogLevel>(site.info.level), site.formatter, site.info.format, args...);
+            return;
+        }
+
+        Producer& producer = local_producer();
+        std::byte* bytes = reserve(producer, size);
+        if (bytes == nullptr) return;
+
+        bytes = detail::store(bytes, RecordHeader{now(), nullptr, &site, static_cast<LogLevel>(site.info.level)});
+        DeferredFormat<Args...>::encode(bytes, args...);
+        producer.ring.commit();
+
+        wake_if_needed(producer);
+    }
+
+    auto open_binary_log(const std::filesystem::path& path) -> bool {
+        auto writer = std::make_unique<BinaryLogWriter>(path);
+        if (!writer->is_open()) return false;
+
+        // 打开前写入的记录仍按原方式输出
+        wait_drained();
+        std::lock_guard<std::mutex> lock{m_output_mutex};
+        m_binary = std::move(writer);
+        return true;
+    }
+
+    // 先等后台线程排空调用前写入的记录, 再关闭文件
+    void close_binary_log() {
+        wait_drained();
+        std::lock_guard<std::mutex> lock{m_output_mutex};
+        m_binary.reset();
+    }
+
+    void set_sink(std::shared_ptr<LogSink> sink) {
+        wait_drained();
+        std::lock_guard<std::mutex> lock{m_output_mutex};
+        m_sink->flush();
+        m_sink = std::move(sink);
+    }
+
+    void stop() {
+        if (!m_done.exchange(true)) {
+            wake();
+            if (m_worker.joinable()) m_worker.join();
+        }
+    }
+private:
+    static constexpr size_t ring_capacity = 64 * 1024;
+    // 空闲时的轮询间隔从 min 起逐次加倍; 超过 max 后停放 (无限期休眠), 由下一条记录的生产者唤醒
+    // 繁忙时生产者不通知后台线程, 靠这段定时轮询取走记录
+    static constexpr auto min_idle_interval = std::chrono::milliseconds(1);
+    static constexpr auto max_idle_interval = std::chrono::milliseconds(16);
+    // 输出缓冲积累到该大小时先写出一次
+    static constexpr size_t write_threshold = 64 * 1024;
+
+    using Ring = queue::SpscByteRing<ring_capacity>;
+
+    // 每条记录的开头; formatter 与 site 都为空表示其后是已格式化的文本
+    struct RecordHeader {
+        std::uint64_t timestamp;
+        DeferredFormatter formatter;
+        const LogSite* site;
+        LogLevel level;
+    };
+
+    // 周期计数器比 steady_clock 便宜, 二进制日志按文件头中的频率换算为墙钟
+    [[nodiscard]] static auto now() noexcept -> std::uint64_t {
+        return asm_::HighPrecisionTimer::cycles();
+    }
+
+    struct Producer {
+        Ring ring;
+        // 所属线程已退出, 环排空后即可移除
+        std::atomic<bool> retired{false};
+    };
+
+    // 线程退出时标记环已退役; shared_ptr 保证环在后台线程排空前有效
+    struct LocalProducer {
+        std::shared_ptr<Producer> producer;
+
+        ~LocalProducer() {
+            if (producer) producer->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    auto local_producer() -> Producer& {
+        thread_local LocalProducer local;
+        if (!local.producer) [[unlikely]] {
+            local.producer = std::make_shared<Producer>();
+            std::lock_guard<std::mutex> lock{m_registry_mutex};
+            m_registry.push_back(local.producer);
+            m_registry_version.fetch_add(1, std::memory_order_release);
+        }
+        return *local.producer;
+    }
+
+    // 环已满时唤醒后台线程并退避等待, 日志器停止后放弃
+    auto reserve(Producer& producer, size_t size) -> std::byte* {
+        queue::detail::Backoff backoff;
+        for (;;) {
+            if (std::byte* bytes = producer.ring.try_reserve(size)) return bytes;
+            if (m_done.load(std::memory_order_relaxed)) return nullptr;
+            wake();
+            backoff.pause();
+        }
+    }
+
+    // 后台线程已停放时唤醒它; 定时休眠期间只在生产者视角的积压过半时唤醒
+    // 与 park() 构成 Dekker 式配对: 要么这里看到停放, 要么后台线程停放前看到这条记录
+    void wake_if_needed(Producer& producer) {
+        if (m_can_park) {
+            // 支持非对称屏障时才会停放, 此时这里只是编译器屏障
+            queue::detail::light_barrier();
+            if (m_parked.load(std::memory_order_relaxed)) [[unlikely]] {
+                wake();
+                return;
+            }
+        }
+        if (producer.ring.used_bytes_estimate() >= ring_capacity / 2 && m_sleeping.load(std::memory_order_relaxed))
+            wake();
+    }
+
+    void wake() {
+        m_wake_epoch.fetch_add(1, std::memory_order_release);
+        queue::detail::atomic_notify_one(m_wake_epoch);
+    }
+
+    // 等待两轮完整的排空: 调用时可能正处于一轮中间, 这一轮不一定包含调用前的记录
+    void wait_drained() {
+        const std::uint32_t target = m_drain_passes.load(std::memory_order_acquire) + 2;
+        for (;;) {
+            const std::uint32_t passes = m_drain_passes.load(std::memory_order_acquire);
+            if (static_cast<std::int32_t>(passes - target) >= 0 || m_done.load(std::memory_order_acquire)) return;
+            wake();
+            m_drain_passes.wait(passes, std::memory_order_acquire);
+        }
+    }
+
+    void drain_thread_func() {
+        std::vector<std::shared_ptr<Producer>> producers;
+        std::uint64_t version = 0;
+        fmt::memory_buffer buffer;
+        auto idle_interval = min_idle_interval;
+
+        for (;;) {
+            const bool done = m_done.load(std::memory_order_acquire);
+
+            if (auto current = m_registry_version.load(std::memory_order_acquire); current != version) {
+                std::lock_guard<std::mutex> lock{m_registry_mutex};
+                producers = m_registry;
+                version = current;
+            }
+
+            size_t written = 0;
+            {
+                std::lock_guard<std::mutex> lock{m_output_mutex};
+                written = drain(producers, buffer);
+                // 这一轮没有新记录, 即将休眠: 让 sink 写出缓冲内容
+                if (written == 0 || done) m_sink->flush();
+            }
+            remove_retired(producers, version);
+            m_drain_passes.fetch_add(1, std::memory_order_release);
+            m_drain_passes.notify_all();
+
+            if (done) break;
+            if (written != 0) {
+                idle_interval = min_idle_interval;
+                continue;
+            }
+
+            if (idle_interval > max_idle_interval) {
+                if (m_can_park) {
+                    park(producers, version);
+                    idle_interval = min_idle_interval;
+                    continue;
+                }
+                idle_interval = max_idle_interval;
+            }
+
+            std::uint32_t epoch = m_wake_epoch.load(std::memory_order_acquire);
+            m_sleeping.store(true, std::memory_order_seq_cst);
+            queue::detail::atomic_wait_for(m_wake_epoch, epoch, idle_interval);
+            m_sleeping.store(false, std::memory_order_relaxed);
+            idle_interval *= 2;
+        }
+    }
+
+    // 无限期休眠, 直到生产者写入新记录、新线程注册或 wake() 被调用
+    void park(const std::vector<std::shared_ptr<Producer>>& producers, std::uint64_t version) {
+        const std::uint32_t epoch = m_wake_epoch.load(std::memory_order_acquire);
+        m_parked.store(true, std::memory_order_relaxed);
+        queue::detail::heavy_barrier();
+
+        const bool pending = m_registry_version.load(std::memory_order_acquire) != version
+                          || std::ranges::any_of(producers, [](const auto& producer) { return !producer->ring.front().empty(); });
+        if (!pending && !m_done.load(std::memory_order_acquire)) {
+            while (m_wake_epoch.load(std::memory_order_acquire) == epoch) queue::detail::atomic_wait(m_wake_epoch, epoch);
+        }
+        m_parked.store(false, std::memory_order_relaxed);
+    }
+
+    // 多路归并: 每次取各环队首中时间戳最小的记录; 返回写出的记录数
+    // 一轮只处理开始时各环已发布的记录: 持续写入时也会按时返回, 让外层刷新生产者列表、推进轮次并写出缓冲
+    auto drain(const std::vector<std::shared_ptr<Producer>>& producers, fmt::memory_buffer& buffer) -> size_t {
+        size_t written = 0;
+
+        m_limits.clear();
+        for (const auto& producer: producers) m_limits.push_back(producer->ring.published());
+
+        for (;;) {
+            Producer* earliest = nullptr;
+            std::span<const std::byte> earliest_record;
+            RecordHeader earliest_header{};
+
+            for (size_t i = 0; i < producers.size(); ++i) {
+                const auto& producer = producers[i];
+                auto record = producer->ring.front(m_limits[i]);
+                if (record.empty()) continue;
+
+                RecordHeader header;
+                std::memcpy(&header, record.data(), sizeof(header));
+                if (earliest == nullptr || header.timestamp < earliest_header.timestamp) {
+                    earliest = producer.get();
+                    earliest_record = record;
+                    earliest_header = header;
+                }
+            }
+            if (earliest == nullptr) break;
+
+            auto payload = earliest_record.subspan(sizeof(RecordHeader));
+            const size_t begin = buffer.size();
+            if (m_binary) append_binary_record(earliest_header, payload, buffer);
+            else          append_record(earliest_header, payload, buffer);
+            if (buffer.size() != begin) m_bounds.push_back({begin, earliest_header.level});
+            earliest->ring.pop();
+            ++written;
+
+            if (buffer.size() >= write_threshold) write_buffer(buffer);
+            if (m_binary && m_binary->pending_bytes() >= write_threshold) m_binary->flush();
+        }
+
+        write_buffer(buffer);
+        if (m_binary) m_binary->flush();
+        return written;
+    }
+
+    static void append_record(const RecordHeader& header, std::span<const std::byte> payload, fmt::memory_buffer& buffer) {
+        if (header.site != nullptr) {
+            format_record(header.site->formatter, header.site->info.format, payload.data(), buffer);
+            return;
+        }
+        if (header.formatter == nullptr) {
+            auto* text = reinterpret_cast<const char*>(payload.data());
+            buffer.append(text, text + payload.size());
+            return;
+        }
+
+        const std::byte* cursor = payload.data();
+        auto* format_data = detail::load<const char*>(cursor);
+        auto  format_size = detail::load<size_t>(cursor);
+        format_record(header.formatter, {format_data, format_size}, cursor, buffer);
+    }
+
+    static void format_record(DeferredFormatter formatter, std::string_view format, const std::byte* args, fmt::memory_buffer& buffer) {
+        try {
+            formatter(format, args, buffer);
+        } catch (const fmt::format_error& e) {
+            fmt::format_to(std::back_inserter(buffer), "[log format error: {}] {}\n", e.what(), format);
+        }
+    }
+
+    // 调用点记录直接转为二进制事件; 文本与延迟格式化记录先格式化, 再作为文本记录写入
+    void append_binary_record(const RecordHeader& header, std::span<const std::byte> payload, fmt::memory_buffer& scratch) {
+        if (header.site != nullptr) {
+            m_binary->append_event(*header.site, header.timestamp, payload.data());
+            return;
+        }
+
+        const size_t begin = scratch.size();
+        append_record(header, payload, scratch);
+        m_binary->append_text(header.timestamp, {scratch.data() + begin, scratch.size() - begin});
+        scratch.resize(begin);
+    }
+
+    // 按记录边界切分缓冲区交给 sink, 文本不再拷贝; 级别用于 sink 的过滤与写出策略
+    void write_buffer(fmt::memory_buffer& buffer) {
+        if (buffer.size() == 0) return;
+
+        m_records.clear();
+        for (size_t i = 0; i < m_bounds.size(); ++i) {
+            const size_t end = i + 1 < m_bounds.size() ? m_bounds[i + 1].begin : buffer.size();
+            m_records.push_back({{buffer.data() + m_bounds[i].begin, end - m_bounds[i].begin}, m_bounds[i].level});
+        }
+        m_sink->write(m_records);
+
+        buffer.clear();
+        m_bounds.clear();
+    }
+
+    // 移除线程已退出且已排空的环
+    void remove_retired(std::vector<std::shared_ptr<Producer>>& producers, std::uint64_t& version) {
+        auto drained = [](const std::shared_ptr<Producer>& producer) {
+            return producer->retired.load(std::memory_order_acquire) && producer->ring.front().empty();
+        };
+        if (std::ranges::none_of(producers, drained)) return;
+
+        std::lock_guard<std::mutex> lock{m_registry_mutex};
+        std::erase_if(m_registry, drained);
+        producers = m_registry;
+        version = m_registry_version.load(std::memory_order_relaxed);
+    }
+
+    std::atomic<bool> m_done;
+    // 是否支持非对称屏障; 不支持时后台线程只做有上限的定时休眠, 生产者快路径上不加屏障
+    const bool m_can_park;
+    alignas(queue::detail::cache_line_size) std::atomic<bool> m_sleeping{false};
+    std::atomic<bool> m_parked{false};
+    std::atomic<std::uint32_t> m_wake_epoch{0};
+
+    std::mutex m_registry_mutex;
+    std::vector<std::shared_ptr<Producer>> m_registry;
+    std::atomic<std::uint64_t> m_registry_version{0};
+
+    // 后台线程在一轮排空期间持有, 切换输出时等待当前一轮结束
+    std::mutex m_output_mutex;
+    std::unique_ptr<BinaryLogWriter> m_binary;
+    std::shared_ptr<LogSink> m_sink = std::make_shared<ConsoleSink>();
+
+    // 后台线程专用: 输出缓冲区中每条记录的起点与级别
+    struct RecordBound {
+        size_t begin;
+        LogLevel level;
+    };
+    std::vector<RecordBound> m_bounds;
+    std::vector<LogRecord> m_records;
+    // 本轮排空各环的上限位置, 与 producers 一一对应
+    std::vector<size_t> m_limits;
+    std::atomic<std::uint32_t> m_drain_passes{0};
+
+    std::thread m_worker;
+};
+
+inline AsyncLogger<ThreadRingPolicy>::AsyncLogger(): pImpl(std::make_unique<Impl>()) {}
+
+// 停止前先写出各限流调用点尚未报告的计数
+inline AsyncLogger<ThreadRingPolicy>::~AsyncLogger() {
+    detail::close_throttles();
+}
+
+inline void AsyncLogger<ThreadRingPolicy>::log_impl(std::string message) {
+    pImpl->write(message, LogLevel::INFO);
+}
+
+inline void AsyncLogger<ThreadRingPolicy>::write(std::string_view message, LogLevel level) {
+    pImpl->write(message, level);
+}
+
+template <DeferredLogArg... Args>
+void AsyncLogger<ThreadRingPolicy>::write_deferred(LogLevel level, DeferredFormatter formatter, deferred_format_string<Args...> format, const Args&... args) {
+    pImpl->write_deferred(level, formatter, format.get(), args...);
+}
+
+template <DeferredLogArg... Args>
+void AsyncLogger<ThreadRingPolicy>::write_site(const LogSite& site, const Args&... args) {
+    pImpl->write_site(site, args...);
+}
+
+inline auto AsyncLogger<ThreadRingPolicy>::open_binary_log(const std::filesystem::path& path) -> bool {
+    return pImpl->open_binary_log(path);
+}
+
+inline void AsyncLogger<ThreadRingPolicy>::close_binary_log() {
+    pImpl->close_binary_log();
+}
+
+inline void AsyncLogger<ThreadRingPolicy>::set_sink(std::shared_ptr<LogSink> sink) {
+    pImpl->set_sink(std::move(sink));
+}
+
+inline void AsyncLogger<ThreadRingPolicy>::stop_impl() {
+    detail::close_throttles();
+    pImpl->stop();
+}
+
 using MutexAsyncLogger = AsyncLogger<queue::MutexPolicy>;
 using CoroutineAsncLogger = AsyncLogger<queue::CoroutinePolicy>;
+using ThreadRingAsyncLogger = AsyncLogger<ThreadRingPolicy>;
 
 template <typename T>
 concept AsyncLoggerConcept = requires(T logger, std::string message) {
@@ -249,44 +911,92 @@ struct ImmediateStrategy {
     needs_flush() const -> bool { return false; }
 };
 
+// 攒批后合并为一条消息交给后端
+//  - 批次大小按观测到的消息速率自适应: 突发时增大, 空闲时缩小, 目标是约 1/4 个刷新间隔攒满一批
+//  - 每批最晚在首条消息之后 FlushIntervalMs 写出, 由持有者 (BatchAsyncLogger 的刷新线程) 按 deadline() 调用 flush
 template <size_t BatchSize = 100, size_t FlushIntervalMs = 50>
 struct BatchStrategy {
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t min_batch_size = std::max<size_t>(1, BatchSize / 8);
+    static constexpr size_t max_batch_size = BatchSize * 8;
+    static constexpr auto   flush_interval = std::chrono::milliseconds(FlushIntervalMs);
+
     std::vector<std::string> batch;
-    std::chrono::steady_clock::time_point last_flush;
 
-    BatchStrategy(): last_flush{std::chrono::steady_clock::now()} {
+    BatchStrategy() {
         batch.reserve(BatchSize);
     }
 
     template <AsyncLoggerConcept Logger>
     void process(Logger& logger, std::string message) {
-        batch.push_back(std::move(message));
-        
-        if (should_flush()) flush(logger);
+        if (add(std::move(message))) flush(logger);
     }
 
     template <AsyncLoggerConcept Logger>
     void flush(Logger& logger) {
-        if (!batch.empty()) {
-            std::string combined;
-            // for (const auto& msg: batch) combined += msg;
-            combined = std::accumulate(batch.begin(), batch.end(), std::string{});
-            logger.log_impl(std::move(combined));
-            batch.clear();
+        if (batch.empty()) return;
+        logger.log_impl(take());
+    }
+
+    // 加入一条消息, 返回本批是否已攒满
+    auto add(std::string message) -> bool {
+        // 批次的第一条消息记下开始时间, 之后的消息不再读取时钟
+        if (batch.empty()) m_started = Clock::now();
+        batch.push_back(std::move(message));
+        return should_flush();
+    }
+
+    // 取走当前批次: 按总长度预留一次后顺序拼接, 消息字符串归还回收池
+    // 与 add 分开, 持有者可以在锁内取走批次, 在锁外交给后端
+    [[nodiscard]] auto take() -> std::string {
+        adapt(Clock::now() - m_started);
+
+        size_t total = 0;
+        for (const auto& message: batch) total += message.size();
+
+        std::string combined = detail::MessagePool::instance().acquire();
+        combined.reserve(total);
+        for (auto& message: batch) {
+            combined += message;
+            detail::MessagePool::instance().recycle(std::move(message));
         }
-        last_flush = std::chrono::steady_clock::now();
+        batch.clear();
+        ++m_generation;
+        return combined;
     }
 
     [[nodiscard]] auto 
     should_flush() const -> bool {
-        return batch.size() >= BatchSize || 
-               std::chrono::duration_cast<std::chrono::milliseconds>(
-                    std::chrono::steady_clock::now() - last_flush
-               ).count() >= FlushIntervalMs;
+        return batch.size() >= m_target;
+    }
+
+    // 当前批次最晚的写出时间, 批次为空时没有意义
+    [[nodiscard]] auto 
+    deadline() const -> Clock::time_point {
+        return m_started + flush_interval;
     }
 
+    // 每写出一批加一, 等待者据此判断等待期间批次是否已被写出
+    [[nodiscard]] auto generation() const -> std::uint64_t { return m_generation; }
+
     [[nodiscard]] constexpr auto needs_flush() -> bool { return true; }
-    [[nodiscard]] constexpr auto get_batch_size() const -> size_t { return BatchSize; } 
+    [[nodiscard]] auto get_batch_size() const -> size_t { return m_target; } 
+private:
+    // 用本批的到达速率估算 1/4 间隔内的消息数, 指数平滑后作为下一批的大小
+    void adapt(Clock::duration elapsed) {
+        const auto window = std::max<Clock::duration>(elapsed, std::chrono::microseconds(100));
+        const double expected = static_cast<double>(batch.size())
+                              * std::chrono::duration<double>(flush_interval / 4).count()
+                              / std::chrono::duration<double>(window).count();
+        m_rate   = m_rate * 0.75 + expected * 0.25;
+        m_target = std::clamp(static_cast<size_t>(m_rate), min_batch_size, max_batch_size);
+    }
+
+    size_t m_target{BatchSize};
+    double m_rate{BatchSize};
+    std::uint64_t m_generation{0};
+    Clock::time_point m_started;
 };
 
 
@@ -419,22 +1129,57 @@ public:
         stop();
     }
 
+    void log(std::string message) {
+        // 批次缓冲中的消息可能要等一个刷新间隔才写出, 先写入飞行记录
+        flight_record(message);
+
+        bool stopped = false;
+        bool full    = false;
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            stopped = m_done.load(std::memory_order_relaxed);
+            if (!stopped) {
+                const bool starts_batch = m_strategy.batch.empty();
+                full = m_strategy.add(std::move(message));
+                // 每批只通知一次, 让刷新线程按新批次的截止时间等待
+                if (starts_batch) m_wakeup.notify_one();
+            }
+        }
+        // 停止后不再攒批, 直接交给后端
+        if (stopped) m_backend_logger.log_impl(std::move(message));
+        else if (full) flush();
+    }
+
+    // 只写出本 logger 的积压; 后端是共享的单例, 仍由其他使用者继续写入, 不在这里停止
     void stop() {
         if (!m_done.exchange(true)) {
-            flush_internal();
-            m_backend_logger.stop_impl();
-            
+            {
+                // 持锁通知, 避免刷新线程在检查 m_done 与进入等待之间错过唤醒
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_wakeup.notify_one();
+            }
             if (m_worker.joinable()) m_worker.join();
+
+            flush();
         }
     }
 
+    // 在 m_mutex 内取走批次, 在锁外交给后端: 生产者不会等待后端的入队
+    // m_send_mutex 让取走与交付按同一顺序进行, 批次之间不会乱序
     void flush() {
-        std::lock_guard<std::mutex> lock{m_mutex};
-        flush_internal();
+        std::lock_guard<std::mutex> send_lock{m_send_mutex};
+        std::string combined;
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (m_strategy.batch.empty()) return;
+            combined = m_strategy.take();
+        }
+        m_backend_logger.log_impl(std::move(combined));
     }
     
     auto get_batch_size() const -> size_t {
-        return Traits::BatchSize_;
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_strategy.get_batch_size();
     }
 
     auto get_pending_count() const -> size_t {
@@ -443,29 +1188,36 @@ public:
     }
 
 private:
+    // 常驻的刷新线程: 没有积压时无限期等待; 有积压时等到当前批次的截止时间,
+    // 期间批次已被生产者写出 (代数变化) 则重新计算
     void worker_thread_func() {
-        std::this_thread::sleep_for(std::chrono::milliseconds(Traits::FlushIntervalMs_ / 2));
-
-        {
-            std::lock_guard<std::mutex> lock{m_mutex};
-            if (m_strategy.should_flush()) flush_internal();
-        }
+        std::unique_lock<std::mutex> lock{m_mutex};
+        while (!m_done.load(std::memory_order_relaxed)) {
+            if (m_strategy.batch.empty()) {
+                m_wakeup.wait(lock, [this] { return m_done.load(std::memory_order_relaxed) || !m_strategy.batch.empty(); });
+                continue;
+            }
 
-        {
-            std::lock_guard<std::mutex> lock{m_mutex};
-            flush_internal();
+            const auto generation = m_strategy.generation();
+            const bool flushed = m_wakeup.wait_until(lock, m_strategy.deadline(), [this, generation] {
+                return m_done.load(std::memory_order_relaxed) || m_strategy.generation() != generation;
+            });
+            if (!flushed) {
+                lock.unlock();
+                flush();
+                lock.lock();
+            }
         }
     }
 
-    void flush_internal() {
-        m_strategy.flush(m_backend_logger);
-    }
-
     std::atomic<bool> m_done;
     mutable std::mutex m_mutex;
+    // 交付批次时持有, 先于 m_mutex 加锁
+    std::mutex m_send_mutex;
+    std::condition_variable m_wakeup;
 
     BatchStrategy<Traits::BatchSize_, Traits::FlushIntervalMs_> m_strategy;
-    AsyncLogger<typename Traits::BackendPolicy_> m_backend_logger;
+    AsyncLogger<typename Traits::BackendPolicy_>& m_backend_logger = AsyncLogger<typename Traits::BackendPolicy_>::instance();
     std::thread m_worker;
 };
 
@@ -0,0 +1,506 @@
+#ifndef BINARY_LOG_HPP
+#define BINARY_LOG_HPP
+
+#include <core/asm/hp_timer.hpp>
+#include <core/log_site.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fmt/args.h>
+#include <fmt/format.h>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 二进制日志文件格式 (小端, 按本机字节序写入):
+//
+//   文件头  magic "LIMGBLOG" | u32 版本 | u32 保留 | f64 每纳秒周期数 | i64 起始墙钟 (ns) | u64 起始周期数
+//   数据块  u32 内容长度 | u32 记录数 | u64 基准周期数 | 记录...
+//
+// 记录以 1 字节类型开头:
+//   SITE   u32 id | u8 级别 | u32 行号 | u16 参数个数 | 参数类型标记... | 级别名 | 文件 | 函数 | 格式串
+//   EVENT  varint id | varint 时间差 | 按 SITE 中的类型标记编码的参数
+//   TEXT   varint 时间差 | 文本
+// 时间差是与块内上一条记录 (第一条与基准) 的周期数之差, zigzag 编码以容忍跨核的微小回退.
+// 字符串均为 u32 长度 + 内容. 调用点在文件中第一次出现前写入对应的 SITE 记录
+//
+// 每个数据块可以独立解码, 离线解码时先顺序收集 SITE 记录, 再并行格式化各块
+namespace labelimg::core::logger {
+namespace detail {
+
+inline constexpr std::string_view binary_log_magic = "LIMGBLOG";
+inline constexpr std::uint32_t    binary_log_version = 1;
+
+template <typename T>
+void append_raw(fmt::memory_buffer& out, const T& value) {
+    auto* bytes = reinterpret_cast<const char*>(&value);
+    out.append(bytes, bytes + sizeof(T));
+}
+
+inline void append_varint(fmt::memory_buffer& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+[[nodiscard]] constexpr auto zigzag(std::int64_t value) noexcept -> std::uint64_t {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+[[nodiscard]] constexpr auto unzigzag(std::uint64_t value) noexcept -> std::int64_t {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+inline void append_string(fmt::memory_buffer& out, std::string_view text) {
+    append_raw(out, static_cast<std::uint32_t>(text.size()));
+    out.append(text.data(), text.data() + text.size());
+}
+
+// 带边界检查的读取游标, 越界后 ok() 为 false 且之后的读取都返回零值
+class ByteReader {
+public:
+    ByteReader(const std::byte* begin, const std::byte* end): m_cursor{begin}, m_end{end} {}
+
+    template <typename T>
+    auto read() -> T {
+        T value{};
+        if (!take(sizeof(T))) return value;
+        std::memcpy(&value, m_cursor - sizeof(T), sizeof(T));
+        return value;
+    }
+
+    auto read_varint() -> std::uint64_t {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            auto byte = std::to_integer<std::uint8_t>(read<std::byte>());
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0 || !m_ok) return value;
+        }
+        m_ok = false;
+        return value;
+    }
+
+    auto read_string() -> std::string_view {
+        auto length = read<std::uint32_t>();
+        if (!take(length)) return {};
+        return {reinterpret_cast<const char*>(m_cursor - length), length};
+    }
+
+    [[nodiscard]] auto ok() const noexcept -> bool { return m_ok; }
+    [[nodiscard]] auto done() const noexcept -> bool { return !m_ok || m_cursor == m_end; }
+private:
+    auto take(size_t size) -> bool {
+        if (!m_ok || static_cast<size_t>(m_end - m_cursor) < size) {
+            m_ok = false;
+            return false;
+        }
+        m_cursor += size;
+        return true;
+    }
+
+    const std::byte* m_cursor;
+    const std::byte* m_end;
+    bool m_ok{true};
+};
+
+} // namespace detail
+
+inline namespace v2 {
+
+enum class BinaryRecordKind: std::uint8_t {
+    SITE  = 1,
+    EVENT = 2,
+    TEXT  = 3,
+};
+
+struct BinaryLogHeader {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    double        ticks_per_ns;
+    std::int64_t  start_wall_ns;
+    std::uint64_t start_ticks;
+};
+static_assert(sizeof(BinaryLogHeader) == 40);
+
+struct BinaryBlockHeader {
+    std::uint32_t size;
+    std::uint32_t records;
+    std::uint64_t base_ticks;
+};
+static_assert(sizeof(BinaryBlockHeader) == 16);
+
+// 写入端: 由日志后台线程独占使用, 记录先积累在块缓冲中, flush() 时整块写出
+class BinaryLogWriter: private NonCopyable {
+public:
+    explicit BinaryLogWriter(const std::filesystem::path& path)
+        : m_file{path, std::ios::binary | std::ios::trunc} {
+        if (!m_file) return;
+
+        BinaryLogHeader header{};
+        std::memcpy(header.magic, detail::binary_log_magic.data(), sizeof(header.magic));
+        header.version       = detail::binary_log_version;
+        header.ticks_per_ns  = asm_::HighPrecisionTimer::get_cpu_frequency();
+        header.start_ticks   = asm_::HighPrecisionTimer::cycles();
+        header.start_wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        write_bytes(&header, sizeof(header));
+    }
+
+    ~BinaryLogWriter() { flush(); }
+
+    [[nodiscard]] auto is_open() const -> bool { return m_file.is_open() && m_file.good(); }
+
+    void append_event(const LogSite& site, std::uint64_t ticks, const std::byte* args) {
+        if (site.id >= m_written_sites.size()) m_written_sites.resize(site.id + 1, false);
+        if (!m_written_sites[site.id]) append_site(site);
+
+        detail::append_raw(m_block, BinaryRecordKind::EVENT);
+        detail::append_varint(m_block, site.id);
+        append_ticks(ticks);
+        site.encoder(args, m_block);
+        ++m_records;
+    }
+
+    void append_text(std::uint64_t ticks, std::string_view text) {
+        detail::append_raw(m_block, BinaryRecordKind::TEXT);
+        append_ticks(ticks);
+        detail::append_string(m_block, text);
+        ++m_records;
+    }
+
+    [[nodiscard]] auto pending_bytes() const noexcept -> size_t { return m_block.size(); }
+    [[nodiscard]] auto bytes_written() const noexcept -> std::uint64_t { return m_bytes_written; }
+
+    void flush() {
+        if (m_records == 0) return;
+
+        BinaryBlockHeader header{static_cast<std::uint32_t>(m_block.size()), m_records, m_base_ticks};
+        write_bytes(&header, sizeof(header));
+        write_bytes(m_block.data(), m_block.size());
+        m_file.flush();
+
+        m_block.clear();
+        m_records = 0;
+        m_has_ticks = false;
+    }
+private:
+    void append_ticks(std::uint64_t ticks) {
+        if (!m_has_ticks) {
+            m_base_ticks = m_last_ticks = ticks;
+            m_has_ticks  = true;
+        }
+        detail::append_varint(m_block, detail::zigzag(static_cast<std::int64_t>(ticks - m_last_ticks)));
+        m_last_ticks = ticks;
+    }
+
+    void append_site(const LogSite& site) {
+        detail::append_raw(m_block, BinaryRecordKind::SITE);
+        detail::append_raw(m_block, site.id);
+        detail::append_raw(m_block, site.info.level);
+        detail::append_raw(m_block, site.info.line);
+        detail::append_raw(m_block, static_cast<std::uint16_t>(site.arg_tags.size()));
+        for (ArgTag tag: site.arg_tags) detail::append_raw(m_block, tag);
+        detail::append_string(m_block, site.info.level_name);
+        detail::append_string(m_block, site.info.file);
+        detail::append_string(m_block, site.info.function);
+        detail::append_string(m_block, site.info.format);
+        m_written_sites[site.id] = true;
+        ++m_records;
+    }
+
+    void write_bytes(const void* data, size_t size) {
+        m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        m_bytes_written += size;
+    }
+
+    std::ofstream m_file;
+    fmt::memory_buffer m_block;
+    std::uint32_t m_records{0};
+    bool          m_has_ticks{false};
+    std::uint64_t m_base_ticks{0};
+    std::uint64_t m_last_ticks{0};
+    std::uint64_t m_bytes_written{0};
+    std::vector<bool> m_written_sites;
+};
+
+// 离线解码: 整个文件读入内存, 建立块索引与调用点表后按块并行格式化
+class BinaryLogDecoder {
+public:
+    struct Site {
+        std::uint8_t        level;
+        std::uint32_t       line;
+        std::vector<ArgTag> arg_tags;
+        std::string_view    level_name;
+        std::string_view    file;
+        std::string_view    function;
+        std::string_view    format;
+    };
+
+    [[nodiscard]] auto open(const std::filesystem::path& path) -> bool {
+        std::ifstream file{path, std::ios::binary};
+        if (!file) return fail("cannot open file");
+
+        std::vector<std::byte> data(std::filesystem::file_size(path));
+        file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) return fail("cannot read file");
+        return parse(std::move(data));
+    }
+
+    [[nodiscard]] auto parse(std::vector<std::byte> data) -> bool {
+        m_data = std::move(data);
+        m_blocks.clear();
+        m_sites.clear();
+        m_truncated = false;
+
+        if (m_data.size() < sizeof(BinaryLogHeader)) return fail("file too small");
+        std::memcpy(&m_header, m_data.data(), sizeof(m_header));
+        if (std::string_view{m_header.magic, sizeof(m_header.magic)} != detail::binary_log_magic)
+            return fail("not a binary log file");
+        if (m_header.version != detail::binary_log_version)
+            return fail("unsupported version");
+
+        // 块索引; 进程异常退出时最后一块可能不完整, 忽略之
+        size_t offset = sizeof(BinaryLogHeader);
+        while (offset + sizeof(BinaryBlockHeader) <= m_data.size()) {
+            BinaryBlockHeader block;
+            std::memcpy(&block, m_data.data() + offset, sizeof(block));
+            offset += sizeof(block);
+            if (block.size > m_data.size() - offset) break;
+
+            m_blocks.push_back({m_data.data() + offset, m_data.data() + offset + block.size, block.base_ticks});
+            offset += block.size;
+        }
+        m_truncated = offset != m_data.size();
+
+        for (const auto& block: m_blocks) {
+            if (!collect_sites(block)) return fail("corrupted block");
+        }
+        return true;
+    }
+
+    [[nodiscard]] auto header() const noexcept -> const BinaryLogHeader& { return m_header; }
+    [[nodiscard]] auto block_count() const noexcept -> size_t { return m_blocks.size(); }
+    [[nodiscard]] auto site_count() const noexcept -> size_t { return m_sites.size(); }
+    [[nodiscard]] auto truncated() const noexcept -> bool { return m_truncated; }
+    [[nodiscard]] auto error() const noexcept -> std::string_view { return m_error; }
+
+    // 把一个块解码为文本追加到 out
+    void decode_block(size_t index, std::string& out) const {
+        const auto& block = m_blocks[index];
+        detail::ByteReader reader{block.begin, block.end};
+        TimeCache time_cache;
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+        std::uint64_t ticks = block.base_ticks;
+
+        while (!reader.done()) {
+            auto kind = reader.read<BinaryRecordKind>();
+            switch (kind) {
+                case BinaryRecordKind::SITE:
+                    skip_site(reader);
+                    break;
+                case BinaryRecordKind::EVENT: {
+                    auto id = static_cast<std::uint32_t>(reader.read_varint());
+                    ticks += static_cast<std::uint64_t>(detail::unzigzag(reader.read_varint()));
+                    auto found = m_sites.find(id);
+                    if (found == m_sites.end()) return;
+
+                    const Site& site = found->second;
+                    store.clear();
+                    for (ArgTag tag: site.arg_tags) push_arg(reader, tag, store);
+                    if (!reader.ok()) return;
+
+                    time_cache.append(*this, ticks, out);
+                    fmt::format_to(std::back_inserter(out), " [{}] {}:{} {}: ", site.level_name, site.file, site.line, site.function);
+                    try {
+                        fmt::vformat_to(std::back_inserter(out), site.format, store);
+                    } catch (const fmt::format_error& e) {
+                        fmt::format_to(std::back_inserter(out), "[log format error: {}] {}", e.what(), site.format);
+                    }
+                    out.push_back('\n');
+                    break;
+                }
+                case BinaryRecordKind::TEXT: {
+                    ticks += static_cast<std::uint64_t>(detail::unzigzag(reader.read_varint()));
+                    auto text = reader.read_string();
+                    if (!reader.ok()) return;
+
+                    time_cache.append(*this, ticks, out);
+                    out.push_back(' ');
+                    out.append(text);
+                    if (!text.empty() && text.back() != '\n') out.push_back('\n');
+                    break;
+                }
+                default:
+                    return;
+            }
+        }
+    }
+
+    // 按块并行解码, 每轮处理 threads * blocks_per_thread 个块后按顺序写出, 限制内存占用
+    void decode(std::ostream& out, unsigned threads = std::thread::hardware_concurrency()) const {
+        threads = std::max(threads, 1u);
+        constexpr size_t blocks_per_thread = 8;
+        const size_t round_size = threads * blocks_per_thread;
+
+        std::vector<std::string> texts;
+        for (size_t first = 0; first < m_blocks.size(); first += round_size) {
+            const size_t count = std::min(round_size, m_blocks.size() - first);
+            texts.assign(count, {});
+
+            std::atomic<size_t> next{0};
+            auto worker = [&] {
+                for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+                    decode_block(first + i, texts[i]);
+            };
+
+            std::vector<std::jthread> workers;
+            for (unsigned t = 1; t < std::min<size_t>(threads, count); ++t) workers.emplace_back(worker);
+            worker();
+            workers.clear();
+
+            for (const auto& text: texts) out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        }
+    }
+private:
+    struct Block {
+        const std::byte* begin;
+        const std::byte* end;
+        std::uint64_t    base_ticks;
+    };
+
+    // 同一秒内的记录复用已格式化的日期时间部分
+    struct TimeCache {
+        std::int64_t second{-1};
+        char         prefix[32]{};
+        size_t       prefix_size{0};
+
+        void append(const BinaryLogDecoder& decoder, std::uint64_t ticks, std::string& out) {
+            const std::int64_t wall_ns = decoder.wall_time_ns(ticks);
+            const std::int64_t current = wall_ns >= 0 ? wall_ns / 1'000'000'000 : (wall_ns + 1) / 1'000'000'000 - 1;
+            if (current != second) {
+                second = current;
+                std::time_t time = static_cast<std::time_t>(current);
+                std::tm local{};
+#if defined(_WIN32)
+                localtime_s(&local, &time);
+#else
+                localtime_r(&time, &local);
+#endif
+                prefix_size = std::strftime(prefix, sizeof(prefix), "%Y-%m-%d %H:%M:%S", &local);
+            }
+            out.append(prefix, prefix_size);
+            fmt::format_to(std::back_inserter(out), ".{:06}", (wall_ns - current * 1'000'000'000) / 1000);
+        }
+    };
+
+    [[nodiscard]] auto wall_time_ns(std::uint64_t ticks) const noexcept -> std::int64_t {
+        const double elapsed_ticks = static_cast<double>(static_cast<std::int64_t>(ticks - m_header.start_ticks));
+        const double ticks_per_ns  = m_header.ticks_per_ns > 0.0 ? m_header.ticks_per_ns : 1.0;
+        return m_header.start_wall_ns + static_cast<std::int64_t>(elapsed_ticks / ticks_per_ns);
+    }
+
+    auto fail(std::string_view message) -> bool {
+        m_error = message;
+        return false;
+    }
+
+    static auto read_site(detail::ByteReader& reader, std::uint32_t& id) -> Site {
+        Site site;
+        id         = reader.read<std::uint32_t>();
+        site.level = reader.read<std::uint8_t>();
+        site.line  = reader.read<std::uint32_t>();
+
+        auto argc = reader.read<std::uint16_t>();
+        for (std::uint16_t i = 0; i < argc && reader.ok(); ++i) site.arg_tags.push_back(reader.read<ArgTag>());
+
+        site.level_name = reader.read_string();
+        site.file       = reader.read_string();
+        site.function   = reader.read_string();
+        site.format     = reader.read_string();
+        return site;
+    }
+
+    static void skip_site(detail::ByteReader& reader) {
+        std::uint32_t id;
+        [[maybe_unused]] auto site = read_site(reader, id);
+    }
+
+    // 顺序扫描一个块, 只解析 SITE 记录, 其余记录按类型标记跳过
+    auto collect_sites(const Block& block) -> bool {
+        detail::ByteReader reader{block.begin, block.end};
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+
+        while (!reader.done()) {
+            switch (reader.read<BinaryRecordKind>()) {
+                case BinaryRecordKind::SITE: {
+                    std::uint32_t id;
+                    Site site = read_site(reader, id);
+                    if (reader.ok()) m_sites.insert_or_assign(id, std::move(site));
+                    break;
+                }
+                case BinaryRecordKind::EVENT: {
+                    auto id = static_cast<std::uint32_t>(reader.read_varint());
+                    reader.read_varint();
+                    auto found = m_sites.find(id);
+                    if (found == m_sites.end()) return false;
+
+                    store.clear();
+                    for (ArgTag tag: found->second.arg_tags) push_arg(reader, tag, store);
+                    break;
+                }
+                case BinaryRecordKind::TEXT:
+                    reader.read_varint();
+                    reader.read_string();
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return reader.ok();
+    }
+
+    static void push_arg(detail::ByteReader& reader, ArgTag tag, fmt::dynamic_format_arg_store<fmt::format_context>& store) {
+        switch (tag) {
+            case ArgTag::BOOL:    store.push_back(reader.read<bool>());          break;
+            case ArgTag::CHAR:    store.push_back(reader.read<char>());          break;
+            case ArgTag::I8:      store.push_back(reader.read<std::int8_t>());   break;
+            case ArgTag::U8:      store.push_back(reader.read<std::uint8_t>());  break;
+            case ArgTag::I16:     store.push_back(reader.read<std::int16_t>());  break;
+            case ArgTag::U16:     store.push_back(reader.read<std::uint16_t>()); break;
+            case ArgTag::I32:     store.push_back(reader.read<std::int32_t>());  break;
+            case ArgTag::U32:     store.push_back(reader.read<std::uint32_t>()); break;
+            case ArgTag::I64:     store.push_back(reader.read<std::int64_t>());  break;
+            case ArgTag::U64:     store.push_back(reader.read<std::uint64_t>()); break;
+            case ArgTag::F32:     store.push_back(reader.read<float>());         break;
+            case ArgTag::F64:     store.push_back(reader.read<double>());        break;
+            case ArgTag::STRING:  store.push_back(reader.read_string());         break;
+            case ArgTag::POINTER:
+                store.push_back(reinterpret_cast<const void*>(static_cast<std::uintptr_t>(reader.read<std::uint64_t>())));
+                break;
+        }
+    }
+
+    std::vector<std::byte> m_data;
+    BinaryLogHeader m_header{};
+    std::vector<Block> m_blocks;
+    std::unordered_map<std::uint32_t, Site> m_sites;
+    bool m_truncated{false};
+    std::string_view m_error;
+};
+
+} // namespace v2
+} // namespace labelimg::core::logger
+
+#endif // BINARY_LOG_HPP
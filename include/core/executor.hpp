@@ -0,0 +1,50 @@
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include <core/message_queue.hpp>
+
+namespace labelimg::core::queue {
+inline namespace v2 {
+
+// 单线程执行器: 所有投递的协程都在同一个后台线程上恢复
+class ThreadExecutor: private NonCopyable {
+public:
+    ThreadExecutor(): m_worker{&ThreadExecutor::run, this} {}
+
+    ~ThreadExecutor() { shutdown(); }
+
+    // 先执行完已投递的协程, 再结束后台线程
+    void shutdown() {
+        if (m_worker.joinable() && !is_current_thread()) {
+            m_queue.push(std::coroutine_handle<>{});
+            m_worker.join();
+        }
+    }
+
+    void post(std::coroutine_handle<> handle) {
+        m_queue.push(handle);
+    }
+
+    [[nodiscard]] auto 
+    is_current_thread() 
+    const noexcept -> bool { return std::this_thread::get_id() == m_worker.get_id(); }
+private:
+    void run() {
+        for (;;) {
+            std::coroutine_handle<> handle;
+            m_queue.wait_and_pop(handle);
+            if (!handle) break;
+            handle.resume();
+        }
+    }
+
+    MessageQueue<std::coroutine_handle<>, BoundedMutexPolicy<0, OverflowPolicy::Block, AtomicWait>> m_queue;
+    std::thread m_worker;
+};
+
+static_assert(CoroutineExecutor<ThreadExecutor>);
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // EXECUTOR_HPP
@@ -0,0 +1,206 @@
+#ifndef FLIGHT_RECORDER_HPP
+#define FLIGHT_RECORDER_HPP
+
+#include <core/log_sink.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 飞行记录文件格式 (按本机字节序, 整个文件以 MAP_SHARED 映射):
+//
+//   文件头 (64 字节)  magic "LIMGFREC" | u32 版本 | u32 槽大小 | u64 槽数 | u64 下一个序号 | 保留
+//   槽 (槽大小字节)   u64 序号 + 1 (0 表示空或正在写) | u32 本槽内容长度 | u16 标记 | u16 保留 | 内容
+//
+// 一条记录占连续序号的若干槽, 首槽带 FIRST 标记, 末槽带 LAST 标记; 序号对槽数取模得到槽位置.
+// 写入方先把槽的序号清零, 拷贝内容后再写入序号, 因此进程在拷贝中途被杀死时该槽会被解码方跳过.
+// 进程崩溃或 SIGKILL 后页缓存中的内容仍会写回文件; 断电不在保护范围内
+namespace labelimg::core::logger {
+namespace detail {
+
+inline constexpr std::string_view flight_recorder_magic = "LIMGFREC";
+inline constexpr std::uint32_t    flight_recorder_version = 1;
+
+struct FlightRecorderHeader {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t slot_size;
+    std::uint64_t slot_count;
+    std::uint64_t next_sequence;   // 以 std::atomic_ref 访问
+    std::uint64_t reserved[4];
+};
+static_assert(sizeof(FlightRecorderHeader) == 64);
+
+struct FlightSlotHeader {
+    std::uint64_t sequence;        // 以 std::atomic_ref 访问
+    std::uint32_t size;
+    std::uint16_t flags;
+    std::uint16_t reserved;
+};
+static_assert(sizeof(FlightSlotHeader) == 16);
+
+inline constexpr std::uint16_t flight_slot_first = 1;
+inline constexpr std::uint16_t flight_slot_last  = 2;
+
+} // namespace detail
+
+inline namespace v2 {
+
+struct FlightRecorderOptions {
+    std::filesystem::path path;
+
+    // 文件中保留的历史大小, 按槽大小向下取整
+    size_t capacity  = 4 * 1024 * 1024;
+    // 2 的幂; 一条记录按内容长度占用一个或多个槽
+    size_t slot_size = 128;
+};
+
+// 以内存映射的环形文件保存最近的日志记录
+//  - record() 可被任意线程并发调用, 只有一次原子加和 memcpy, 没有系统调用和锁
+//  - 生产者侧记录 (install 之后由 async_log / BatchAsyncLogger 在入队前写入), 队列或批次缓冲中
+//    尚未写出的日志在崩溃后仍可由 label_img_flightdecode 解出
+//  - 也可以作为普通 sink 挂在日志线程之后 (例如 FanoutSink 的一路), 记录格式化后的输出
+//  - 再次打开同一文件且槽的布局不变时接着上次的序号写入, 不会覆盖上次崩溃前的记录
+class FlightRecorder final: public LogSink {
+public:
+    explicit FlightRecorder(FlightRecorderOptions options);
+    ~FlightRecorder() override;
+
+    [[nodiscard]] auto is_open() const noexcept -> bool;
+    [[nodiscard]] auto path() const noexcept -> const std::filesystem::path&;
+    [[nodiscard]] auto slot_count() const noexcept -> size_t;
+
+    // 写入一条记录; 超过环容量的记录只保留末尾部分, 未打开时忽略
+    void record(std::string_view text) noexcept;
+
+    void write(std::span<const LogRecord> records) override;
+    // 内容已在映射的页中, 不需要写出
+    void flush() override {}
+
+    // 设置进程内的生产者侧记录器, 传入空指针取消; 被替换的记录器保留到进程退出,
+    // 避免与正在记录的线程竞争
+    static void install(std::shared_ptr<FlightRecorder> recorder);
+
+    [[nodiscard]] static auto active() noexcept -> FlightRecorder* {
+        return s_active.load(std::memory_order_acquire);
+    }
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+
+    static inline std::atomic<FlightRecorder*> s_active{nullptr};
+};
+
+// 生产者侧记录的入口: 没有安装记录器时只是一次原子读
+inline void flight_record(std::string_view text) noexcept {
+    if (auto* recorder = FlightRecorder::active()) recorder->record(text);
+}
+
+// 离线读取飞行记录文件, 只依赖标准库, 供 label_img_flightdecode 与测试使用
+class FlightRecordReader {
+public:
+    [[nodiscard]] auto open(const std::filesystem::path& path) -> bool {
+        std::ifstream file{path, std::ios::binary};
+        if (!file) return fail("cannot open file");
+
+        std::vector<char> data(std::filesystem::file_size(path));
+        file.read(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file) return fail("cannot read file");
+        return parse(data);
+    }
+
+    // 按序号排序后把各槽拼回记录; 序号不连续或缺少首尾槽的记录视为损坏并跳过
+    [[nodiscard]] auto parse(std::span<const char> data) -> bool {
+        m_records.clear();
+        m_torn = 0;
+
+        detail::FlightRecorderHeader header;
+        if (data.size() < sizeof(header)) return fail("file too small");
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (std::string_view{header.magic, sizeof(header.magic)} != detail::flight_recorder_magic)
+            return fail("not a flight recorder file");
+        if (header.version != detail::flight_recorder_version)
+            return fail("unsupported version");
+        if (header.slot_size <= sizeof(detail::FlightSlotHeader)
+            || header.slot_count > (data.size() - sizeof(header)) / header.slot_size)
+            return fail("corrupted header");
+        m_next_sequence = header.next_sequence;
+
+        struct Slot {
+            std::uint64_t sequence;
+            std::uint16_t flags;
+            std::string_view text;
+        };
+        std::vector<Slot> slots;
+        slots.reserve(header.slot_count);
+
+        const size_t payload = header.slot_size - sizeof(detail::FlightSlotHeader);
+        for (std::uint64_t i = 0; i < header.slot_count; ++i) {
+            const char* base = data.data() + sizeof(header) + i * header.slot_size;
+            detail::FlightSlotHeader slot;
+            std::memcpy(&slot, base, sizeof(slot));
+            if (slot.sequence == 0) continue;
+            if (slot.size > payload) {
+                ++m_torn;
+                continue;
+            }
+            slots.push_back({slot.sequence - 1, slot.flags, {base + sizeof(slot), slot.size}});
+        }
+        std::ranges::sort(slots, {}, &Slot::sequence);
+
+        std::string current;
+        std::uint64_t expected = 0;
+        bool in_record = false;
+        for (const auto& slot: slots) {
+            if (slot.flags & detail::flight_slot_first) {
+                if (in_record) ++m_torn;
+                current.assign(slot.text);
+                in_record = true;
+            } else if (in_record && slot.sequence == expected) {
+                current.append(slot.text);
+            } else {
+                ++m_torn;
+                in_record = false;
+                continue;
+            }
+
+            expected = slot.sequence + 1;
+            if (slot.flags & detail::flight_slot_last) {
+                m_records.push_back(std::move(current));
+                current.clear();
+                in_record = false;
+            }
+        }
+        if (in_record) ++m_torn;
+        return true;
+    }
+
+    // 按写入顺序排列的完整记录
+    [[nodiscard]] auto records() const noexcept -> const std::vector<std::string>& { return m_records; }
+    // 被覆盖了一部分或写到一半的记录 (片段) 数
+    [[nodiscard]] auto torn() const noexcept -> size_t { return m_torn; }
+    [[nodiscard]] auto next_sequence() const noexcept -> std::uint64_t { return m_next_sequence; }
+    [[nodiscard]] auto error() const noexcept -> std::string_view { return m_error; }
+private:
+    auto fail(std::string_view message) -> bool {
+        m_error = message;
+        return false;
+    }
+
+    std::vector<std::string> m_records;
+    size_t m_torn = 0;
+    std::uint64_t m_next_sequence = 0;
+    std::string m_error;
+};
+
+} // namespace v2
+} // namespace labelimg::core::logger
+
+#endif // FLIGHT_RECORDER_HPP
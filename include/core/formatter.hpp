@@ -5,12 +5,12 @@
 #include <fmt/base.h>
 #include <chrono>
 #include <cstdint>
-#include <ctime>
-#include <iomanip>
 #include <locale>
 #include <magic_enum/magic_enum.hpp>
 
 #include <core/async_logger.h>
+#include <core/formatter/log_level.h>
+#include <core/formatter/timestamp.h>
 #include <spanstream>
 #include <sstream>
 #include <thread>
@@ -57,14 +57,6 @@ constexpr auto has_field(LogField fields, LogField field) -> bool {
     return (fields & field) == field;
 }
 
-enum class TimestampFormat: std::uint8_t {
-    IOS8601,    // 2025-01-01T12:12:12.123Z
-    SIMPLE,     // 2025-01-01 12:12:12
-    TIME_ONLY,  // 12:12:12.123
-    COMPACT,    // 20250101_121212
-    RELATIVE,   // +1.234s
-};
-
 
 
 namespace detail {
@@ -164,57 +156,6 @@ consteval auto build_style_string() {
         return head_str;
 }
 
-class TimestampFormatter {
-private:
-    static inline auto start_time = std::chrono::steady_clock::now();
-public:
-    static auto format_timestamp(TimestampFormat format) -> std::string {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()
-        ) % 1000;
-
-        std::ostringstream oss;
-        
-        switch(format) {
-            case TimestampFormat::IOS8601: {
-                oss << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%S");
-                oss << "." << std::setfill('0') << std::setw(3) << ms.count() << 'Z';
-                break;
-            }
-            case TimestampFormat::SIMPLE: {
-                oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-                break;
-            }
-            case TimestampFormat::TIME_ONLY: {
-                oss << std::put_time(std::localtime(&time_t), "%H%M%S");
-                oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-                break;
-            }
-            case TimestampFormat::COMPACT: {
-                oss << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S");
-                break;
-            }
-            case TimestampFormat::RELATIVE: {
-                auto steady_now = std::chrono::steady_clock::now();
-                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    steady_now - start_time
-                );
-                oss << '+' << elapsed.count() / 1000.0 << 's';
-                break;
-            }
-        }
-        return oss.str();
-    }
-
-    static auto format_timestamp_fixed_width(TimestampFormat format, size_t width = 0) -> std::string {
-        auto timestamp = format_timestamp(format);
-        if (width > 0 && timestamp.length() < width) timestamp.resize(width, ' ');
-        return timestamp;
-    }
-};
-
 inline auto format_thread_id() -> std::string {
     std::ostringstream oss;
     oss << std::this_thread::get_id();
@@ -392,18 +333,11 @@ using LoggerRetType = std::conditional_t<is_test_build, bool, void>;
 
 #if defined(USE_STD_FMT) || defined(USE_EXTERNAL_FMT)
 
-enum class LogLevel: std::int8_t {
-    INFO,
-    SUCCESS,
-    WARNING,
-    ERROR,
-    FATAL_ERROR
-};
-
 constexpr auto 
 level2style(LogLevel level) 
 noexcept -> console_style::PresetStyle {
     switch (level) {
+        case LogLevel::DEBUG:       return console_style::PresetStyle::B_BLUE;
         case LogLevel::INFO:        return console_style::PresetStyle::B_GREEN;
         case LogLevel::SUCCESS:     return console_style::PresetStyle::B_CYAN;
         case LogLevel::WARNING:     return console_style::PresetStyle::B_YELLOW;
@@ -632,17 +566,20 @@ auto logg( app_format_string<fmt_arg_type_t<Args>...> fmt_str
 
     using namespace labelimg::core::logger;
 
-    if (!lines.empty())
-        async_log << console_style::get_preset_style_code<style>().c_str() << tag
-                  << console_style::get_preset_style_code<console_style::PresetStyle::C_RESET>().c_str()
-                  << lines[0];
-    
-    if (lines.size() > 1) {
-        std::string indent = detail::create_indent_from(tag);
-        for (size_t i = 1; i < lines.size(); ++i)     
-                async_log << console_style::get_preset_style_code<style>().c_str() << indent
-                  << console_style::get_preset_style_code<console_style::PresetStyle::C_RESET>().c_str()
-                  << lines[i];
+    // 多行消息写入同一条记录, 只提交一次
+    if (!lines.empty()) {
+        LogStream record;
+        record << console_style::get_preset_style_code<style>().c_str() << tag
+               << console_style::get_preset_style_code<console_style::PresetStyle::C_RESET>().c_str()
+               << lines[0];
+
+        if (lines.size() > 1) {
+            std::string indent = detail::create_indent_from(tag);
+            for (size_t i = 1; i < lines.size(); ++i)
+                record << '\n' << console_style::get_preset_style_code<style>().c_str() << indent
+                       << console_style::get_preset_style_code<console_style::PresetStyle::C_RESET>().c_str()
+                       << lines[i];
+        }
     }
 
 
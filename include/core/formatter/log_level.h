@@ -0,0 +1,149 @@
+#ifndef LOG_LEVEL_H
+#define LOG_LEVEL_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// 编译期最低级别 (LogLevel 的数值), 低于它的 LOG_IF_ENABLED / LOGG 调用整体消除, 由 CMake 的 LOG_MIN_LEVEL 设置
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+namespace labelimg::core::formatter {
+
+enum class LogLevel: std::int8_t {
+    DEBUG,
+    INFO,
+    SUCCESS,
+    WARNING,
+    ERROR,
+    FATAL_ERROR
+};
+
+// 按模块划分的日志分类, 各自有独立的运行期阈值
+enum class LogCategory: std::uint8_t {
+    GENERAL,
+    CORE,
+    QTILS,
+    WIDGET,
+    WINDOW,
+    PAGE
+};
+
+inline constexpr std::size_t log_category_count = 6;
+inline constexpr auto        min_log_level      = static_cast<LogLevel>(LOG_MIN_LEVEL);
+
+template <LogLevel level>
+inline constexpr bool log_level_compiled = level >= min_log_level;
+
+namespace detail {
+
+inline constexpr std::array<std::string_view, 6> log_level_names{
+    "debug", "info", "success", "warning", "error", "fatal_error"
+};
+
+inline constexpr std::array<std::string_view, log_category_count> log_category_names{
+    "general", "core", "qtils", "widget", "window", "page"
+};
+
+template <std::size_t N>
+constexpr auto find_name(const std::array<std::string_view, N>& names, std::string_view name) -> std::size_t {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (names[i] == name) return i;
+    }
+    return N;
+}
+
+} // namespace detail
+
+// 运行期级别过滤: 每个分类一个阈值, 判断只有一次 relaxed 原子读取
+//  - 阈值是常量初始化的静态成员, 读取时没有函数内静态变量的初始化检查
+//  - 默认阈值为 INFO, DEBUG 日志需要显式打开
+class LogFilter {
+public:
+    [[nodiscard]] static auto
+    enabled(LogCategory category, LogLevel level)
+    noexcept -> bool {
+        return static_cast<std::int8_t>(level)
+            >= s_thresholds[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static auto
+    threshold(LogCategory category)
+    noexcept -> LogLevel {
+        return static_cast<LogLevel>(s_thresholds[static_cast<std::size_t>(category)].load(std::memory_order_relaxed));
+    }
+
+    static void set_threshold(LogCategory category, LogLevel level) noexcept {
+        s_thresholds[static_cast<std::size_t>(category)].store(static_cast<std::int8_t>(level), std::memory_order_relaxed);
+    }
+
+    // 设置所有分类
+    static void set_threshold(LogLevel level) noexcept {
+        for (auto& threshold: s_thresholds) threshold.store(static_cast<std::int8_t>(level), std::memory_order_relaxed);
+    }
+
+    // 解析 "warning" 或 "info,widget=debug,core=error" 形式的配置 (例如来自环境变量);
+    // 不带分类的项作用于所有分类, 按出现顺序生效. 有无法识别的项时返回 false, 其余项仍然生效
+    static auto configure(std::string_view spec) noexcept -> bool {
+        bool ok = true;
+        while (!spec.empty()) {
+            const std::size_t comma = spec.find(',');
+            std::string_view item = spec.substr(0, comma);
+            spec = comma == std::string_view::npos ? std::string_view{} : spec.substr(comma + 1);
+            if (item.empty()) continue;
+
+            std::string_view category_name;
+            if (const std::size_t equal = item.find('='); equal != std::string_view::npos) {
+                category_name = item.substr(0, equal);
+                item          = item.substr(equal + 1);
+            }
+
+            const std::size_t level = detail::find_name(detail::log_level_names, item);
+            if (level == detail::log_level_names.size()) {
+                ok = false;
+                continue;
+            }
+
+            if (category_name.empty()) {
+                set_threshold(static_cast<LogLevel>(level));
+                continue;
+            }
+
+            const std::size_t category = detail::find_name(detail::log_category_names, category_name);
+            if (category == log_category_count) {
+                ok = false;
+                continue;
+            }
+            set_threshold(static_cast<LogCategory>(category), static_cast<LogLevel>(level));
+        }
+        return ok;
+    }
+private:
+    static constexpr auto default_threshold = static_cast<std::int8_t>(LogLevel::INFO);
+    static_assert(log_category_count == 6, "initialize a threshold for every category");
+
+    // 所有阈值放在同一条缓存行, 只读为主
+    alignas(64) static inline std::array<std::atomic<std::int8_t>, log_category_count> s_thresholds{
+        default_threshold, default_threshold, default_threshold,
+        default_threshold, default_threshold, default_threshold
+    };
+};
+
+} // namespace labelimg::core::formatter
+
+// 先判断级别再执行语句, 关闭时参数表达式都不会求值:
+//  - 低于 LOG_MIN_LEVEL 的调用在编译期丢弃, 不生成代码也不注册调用点
+//  - 否则读取一次所属分类的阈值
+//     LOG_IF_ENABLED(LogCategory::WIDGET, LogLevel::DEBUG, logger.write(expensive()));
+#define LOG_IF_ENABLED(category, level, ...)                                                    \
+    do {                                                                                        \
+        if constexpr (::labelimg::core::formatter::log_level_compiled<level>) {                 \
+            if (::labelimg::core::formatter::LogFilter::enabled(category, level)) { __VA_ARGS__; } \
+        }                                                                                       \
+    } while (false)
+
+#endif // LOG_LEVEL_H
@@ -1,6 +1,10 @@
 #ifndef REFLECTION_H
 #define REFLECTION_H
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
 
 namespace labelimg::core::formatter::reflection {
 
@@ -0,0 +1,177 @@
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace labelimg::core::formatter {
+
+enum class TimestampFormat: std::uint8_t {
+    IOS8601,    // 2025-01-01T12:12:12.123Z
+    SIMPLE,     // 2025-01-01 12:12:12
+    TIME_ONLY,  // 12:12:12.123
+    COMPACT,    // 20250101_121212
+    RELATIVE,   // +1.234s
+};
+
+inline constexpr size_t timestamp_format_count = 5;
+
+namespace detail {
+
+// 时间戳格式化
+//  - 每个线程、每种格式缓存当前这一秒的日期时间前缀, 只在秒变化时用 gmtime_r / localtime_r 重新计算
+//  - 同一秒内只拷贝前缀并填入毫秒, 不分配内存, 不加锁, 不依赖 locale
+class TimestampFormatter {
+public:
+    using Clock = std::chrono::system_clock;
+
+    // 任一格式的最大长度
+    static constexpr size_t max_length = 32;
+
+    // 写入 out (至少 max_length 字节), 返回写入的长度
+    static auto format_to(TimestampFormat format, Clock::time_point now, char* out) noexcept -> size_t {
+        if (format == TimestampFormat::RELATIVE) return format_relative(out);
+
+        const auto since_epoch = now.time_since_epoch();
+        const auto second = std::chrono::floor<std::chrono::seconds>(since_epoch);
+        const auto millis = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch - second).count());
+
+        auto& cache = cache_for(format);
+        if (cache.second != second.count()) cache.update(format, second.count());
+
+        std::memcpy(out, cache.prefix.data(), cache.size);
+        size_t size = cache.size;
+        if (format == TimestampFormat::IOS8601 || format == TimestampFormat::TIME_ONLY) {
+            write_digits<3>(out + size, millis);
+            size += 3;
+        }
+        if (format == TimestampFormat::IOS8601) out[size++] = 'Z';
+        return size;
+    }
+
+    // 指向当前线程的缓冲区, 在该线程下一次调用前有效
+    static auto view(TimestampFormat format, Clock::time_point now = Clock::now()) noexcept -> std::string_view {
+        thread_local std::array<char, max_length> buffer;
+        return {buffer.data(), format_to(format, now, buffer.data())};
+    }
+
+    static auto format_timestamp(TimestampFormat format) -> std::string {
+        return std::string{view(format)};
+    }
+
+    static auto format_timestamp_fixed_width(TimestampFormat format, size_t width = 0) -> std::string {
+        auto timestamp = format_timestamp(format);
+        if (width > 0 && timestamp.length() < width) timestamp.resize(width, ' ');
+        return timestamp;
+    }
+private:
+    static inline auto start_time = std::chrono::steady_clock::now();
+
+    template <size_t N>
+    static void write_digits(char* out, int value) noexcept {
+        for (size_t i = N; i-- > 0; value /= 10) out[i] = static_cast<char>('0' + value % 10);
+    }
+
+    struct Cache {
+        std::int64_t second = std::numeric_limits<std::int64_t>::min();
+        std::array<char, 24> prefix{};
+        size_t size = 0;
+
+        void update(TimestampFormat format, std::int64_t current) noexcept {
+            second = current;
+
+            const auto time = static_cast<std::time_t>(current);
+            std::tm parts{};
+            // ISO 8601 输出 UTC, 其余为本地时间
+#if defined(_WIN32)
+            if (format == TimestampFormat::IOS8601) gmtime_s(&parts, &time);
+            else                                    localtime_s(&parts, &time);
+#else
+            if (format == TimestampFormat::IOS8601) gmtime_r(&time, &parts);
+            else                                    localtime_r(&time, &parts);
+#endif
+
+            char* out = prefix.data();
+            auto date = [&out, &parts](bool separated) {
+                write_digits<4>(out, parts.tm_year + 1900);
+                out += 4;
+                if (separated) *out++ = '-';
+                write_digits<2>(out, parts.tm_mon + 1);
+                out += 2;
+                if (separated) *out++ = '-';
+                write_digits<2>(out, parts.tm_mday);
+                out += 2;
+            };
+            auto time_of_day = [&out, &parts](bool separated) {
+                write_digits<2>(out, parts.tm_hour);
+                out += 2;
+                if (separated) *out++ = ':';
+                write_digits<2>(out, parts.tm_min);
+                out += 2;
+                if (separated) *out++ = ':';
+                write_digits<2>(out, parts.tm_sec);
+                out += 2;
+            };
+
+            switch (format) {
+                case TimestampFormat::IOS8601:
+                    date(true);
+                    *out++ = 'T';
+                    time_of_day(true);
+                    *out++ = '.';
+                    break;
+                case TimestampFormat::SIMPLE:
+                    date(true);
+                    *out++ = ' ';
+                    time_of_day(true);
+                    break;
+                case TimestampFormat::TIME_ONLY:
+                    time_of_day(true);
+                    *out++ = '.';
+                    break;
+                case TimestampFormat::COMPACT:
+                    date(false);
+                    *out++ = '_';
+                    time_of_day(false);
+                    break;
+                case TimestampFormat::RELATIVE:
+                    break;
+            }
+            size = static_cast<size_t>(out - prefix.data());
+        }
+    };
+
+    static auto cache_for(TimestampFormat format) noexcept -> Cache& {
+        thread_local std::array<Cache, timestamp_format_count> caches;
+        return caches[static_cast<size_t>(format)];
+    }
+
+    // +秒.毫秒s, 从进程启动 (首次使用本类) 起计
+    static auto format_relative(char* out) noexcept -> size_t {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time
+        ).count();
+
+        char* end = out + max_length;
+        *out++ = '+';
+        out = std::to_chars(out, end, elapsed / 1000).ptr;
+        *out++ = '.';
+        write_digits<3>(out, static_cast<int>(elapsed % 1000));
+        out += 3;
+        *out++ = 's';
+        return static_cast<size_t>(max_length - (end - out));
+    }
+};
+
+} // namespace detail
+} // namespace labelimg::core::formatter
+
+#endif // TIMESTAMP_H
@@ -0,0 +1,203 @@
+#ifndef LOG_CODEC_HPP
+#define LOG_CODEC_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fmt/format.h>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace labelimg::core::logger {
+namespace detail {
+
+template <typename T>
+auto store(std::byte* out, const T& value) noexcept -> std::byte* {
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+template <typename T>
+auto load(const std::byte*& in) noexcept -> T {
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return value;
+}
+
+// 字符串统一编码为 4 字节长度 + 内容, 解码为指向缓冲区的 string_view
+struct StringCodec {
+    using decoded_type = std::string_view;
+
+    static auto size(std::string_view text) noexcept -> size_t { return sizeof(std::uint32_t) + text.size(); }
+
+    static auto encode(std::byte* out, std::string_view text) noexcept -> std::byte* {
+        out = store(out, static_cast<std::uint32_t>(text.size()));
+        std::memcpy(out, text.data(), text.size());
+        return out + text.size();
+    }
+
+    static auto decode(const std::byte*& in) noexcept -> std::string_view {
+        auto length = load<std::uint32_t>(in);
+        std::string_view text{reinterpret_cast<const char*>(in), length};
+        in += length;
+        return text;
+    }
+};
+
+// C 字符串可能是空指针, 按 "(null)" 编码 (与 printf 一致), 避免对空指针调用 strlen
+struct CStringCodec: StringCodec {
+    static auto view(const char* text) noexcept -> std::string_view { return text != nullptr ? text : "(null)"; }
+
+    static auto size(const char* text) noexcept -> size_t { return StringCodec::size(view(text)); }
+
+    static auto encode(std::byte* out, const char* text) noexcept -> std::byte* { return StringCodec::encode(out, view(text)); }
+};
+
+} // namespace detail
+
+inline namespace v2 {
+
+// 延迟格式化: 调用方只把格式串指针和参数的二进制编码写入日志缓冲区, 由日志线程完成格式化
+//
+// 每种参数类型由 LogArgCodec<T> 描述:
+//  - decoded_type      日志线程上交给 fmt 的类型
+//  - size(value)       编码后的字节数
+//  - encode(out, value) 写入编码, 返回写入末尾
+//  - decode(in)        读出一个参数并推进 in
+// 其他模块 (例如 qtils 中的 QString) 通过特化 LogArgCodec 扩展
+template <typename T>
+struct LogArgCodec;
+
+// 算术类型与指针按原样拷贝
+template <typename T>
+    requires std::is_arithmetic_v<T> || std::is_same_v<T, const void*> || std::is_same_v<T, void*>
+struct LogArgCodec<T> {
+    using decoded_type = T;
+
+    static constexpr auto size(const T&) noexcept -> size_t { return sizeof(T); }
+    static auto encode(std::byte* out, const T& value) noexcept -> std::byte* { return detail::store(out, value); }
+    static auto decode(const std::byte*& in) noexcept -> T { return detail::load<T>(in); }
+};
+
+// 枚举按底层整数传递
+template <typename T>
+    requires std::is_enum_v<T>
+struct LogArgCodec<T> {
+    using underlying   = std::underlying_type_t<T>;
+    using decoded_type = underlying;
+
+    static constexpr auto size(const T&) noexcept -> size_t { return sizeof(underlying); }
+    static auto encode(std::byte* out, const T& value) noexcept -> std::byte* { return detail::store(out, static_cast<underlying>(value)); }
+    static auto decode(const std::byte*& in) noexcept -> underlying { return detail::load<underlying>(in); }
+};
+
+template <> struct LogArgCodec<std::string_view>: detail::StringCodec {};
+template <> struct LogArgCodec<std::string>: detail::StringCodec {};
+template <> struct LogArgCodec<const char*>: detail::CStringCodec {};
+template <> struct LogArgCodec<char*>: detail::CStringCodec {};
+
+// 路径在调用方按原生编码拷贝, 在日志线程转换为 UTF-8; 原生编码是 char 时直接引用缓冲区
+template <>
+struct LogArgCodec<std::filesystem::path> {
+    using value_type   = std::filesystem::path::value_type;
+    using decoded_type = std::conditional_t<std::is_same_v<value_type, char>, std::string_view, std::string>;
+
+    static auto size(const std::filesystem::path& path) noexcept -> size_t {
+        return sizeof(std::uint32_t) + path.native().size() * sizeof(value_type);
+    }
+
+    static auto encode(std::byte* out, const std::filesystem::path& path) noexcept -> std::byte* {
+        const auto& native = path.native();
+        out = detail::store(out, static_cast<std::uint32_t>(native.size()));
+        std::memcpy(out, native.data(), native.size() * sizeof(value_type));
+        return out + native.size() * sizeof(value_type);
+    }
+
+    static auto decode(const std::byte*& in) -> decoded_type {
+        auto length = detail::load<std::uint32_t>(in);
+        if constexpr (std::is_same_v<value_type, char>) {
+            decoded_type native{reinterpret_cast<const char*>(in), length};
+            in += length;
+            return native;
+        } else {
+            std::basic_string<value_type> native(length, value_type{});
+            std::memcpy(native.data(), in, length * sizeof(value_type));
+            in += length * sizeof(value_type);
+
+            auto utf8 = std::filesystem::path{std::move(native)}.u8string();
+            return decoded_type{reinterpret_cast<const char*>(utf8.data()), utf8.size()};
+        }
+    }
+};
+
+// 先加 const 再退化, 字符数组统一按 const char* 处理
+template <typename T>
+using log_codec_t = LogArgCodec<std::decay_t<const T>>;
+
+template <typename T>
+concept DeferredLogArg = requires (const T& value, std::byte* out, const std::byte*& in) {
+    typename log_codec_t<T>::decoded_type;
+    { log_codec_t<T>::size(value) } -> std::convertible_to<size_t>;
+    { log_codec_t<T>::encode(out, value) } -> std::same_as<std::byte*>;
+    { log_codec_t<T>::decode(in) } -> std::convertible_to<typename log_codec_t<T>::decoded_type>;
+};
+
+// 延迟格式化的格式串: 记录里只保存格式串指针, 日志线程格式化时它必须仍然有效,
+// 因此只接受编译期常量 (字符串字面量等静态存储的字符串), 不接受 fmt::runtime 或运行时拼出的字符串
+template <typename... Decoded>
+class basic_deferred_format_string {
+public:
+    template <typename S>
+        requires std::is_convertible_v<const S&, std::string_view>
+    consteval basic_deferred_format_string(const S& format): m_format{format} {
+        [[maybe_unused]] fmt::format_string<Decoded...> checked{format};
+    }
+
+    [[nodiscard]] constexpr auto
+    get()
+    const noexcept -> std::string_view { return m_format; }
+private:
+    std::string_view m_format;
+};
+
+// 按解码后的类型做编译期格式串检查, 例如 QString 参数按 std::string 检查
+template <typename... Args>
+using deferred_format_string = basic_deferred_format_string<typename log_codec_t<Args>::decoded_type...>;
+
+// 日志线程上的格式化入口: 读出参数并把结果追加到 out
+using DeferredFormatter = void (*)(std::string_view format, const std::byte* args, fmt::memory_buffer& out);
+
+template <DeferredLogArg... Args>
+struct DeferredFormat {
+    [[nodiscard]] static auto
+    encoded_size(const Args&... args)
+    noexcept -> size_t { return (size_t{0} + ... + log_codec_t<Args>::size(args)); }
+
+    static auto encode(std::byte* out, const Args&... args) noexcept -> std::byte* {
+        ((out = log_codec_t<Args>::encode(out, args)), ...);
+        return out;
+    }
+
+    // 花括号初始化保证按参数顺序解码
+    static void format(std::string_view format, [[maybe_unused]] const std::byte* args, fmt::memory_buffer& out) {
+        std::tuple<typename log_codec_t<Args>::decoded_type...> values{log_codec_t<Args>::decode(args)...};
+        std::apply([&](auto&... value) {
+            fmt::vformat_to(std::back_inserter(out), format, fmt::make_format_args(value...));
+        }, values);
+    }
+
+    // format 之后追加换行, 作为一条完整日志
+    static void format_line(std::string_view format, const std::byte* args, fmt::memory_buffer& out) {
+        DeferredFormat::format(format, args, out);
+        out.push_back('\n');
+    }
+};
+
+} // namespace v2
+} // namespace labelimg::core::logger
+
+#endif // LOG_CODEC_HPP
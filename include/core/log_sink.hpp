@@ -0,0 +1,141 @@
+#ifndef LOG_SINK_HPP
+#define LOG_SINK_HPP
+
+#include "utils/non-copyable.h"
+#include <chrono>
+#include <core/formatter/log_level.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace labelimg::core::logger {
+inline namespace v2 {
+
+using formatter::LogLevel;
+
+// 交给 sink 的一段已格式化文本 (含结尾换行), 可以是一条记录, 也可以是日志线程拼好的一批
+struct LogRecord {
+    std::string_view text;
+    // 这段文本中最高的级别, 未知时为 INFO
+    LogLevel level = LogLevel::INFO;
+};
+
+// 日志输出端: 只由日志线程调用, 同一个 sink 不会被并发调用
+class LogSink: private NonCopyable {
+public:
+    virtual ~LogSink() = default;
+
+    // 写入一批记录; 实现可以先缓冲, 但必须保持顺序
+    virtual void write(std::span<const LogRecord> records) = 0;
+
+    // 日志线程排空队列、即将休眠时调用, 写出全部缓冲内容
+    virtual void flush() = 0;
+};
+
+// 标准输出, 每批写入后在 flush 时刷新
+class ConsoleSink final: public LogSink {
+public:
+    void write(std::span<const LogRecord> records) override;
+    void flush() override;
+};
+
+struct FileSinkOptions {
+    std::filesystem::path path;
+
+    // 写出策略: 满足任一条件时把缓冲内容与当前批次合并为一次 writev
+    size_t                    flush_bytes    = 64 * 1024;
+    std::chrono::milliseconds flush_interval = std::chrono::milliseconds(200);
+    LogLevel                  flush_level    = LogLevel::ERROR;
+
+    // 轮转策略: 为 0 的条件不生效
+    size_t                    rotate_bytes    = 64 * 1024 * 1024;
+    std::chrono::seconds      rotate_interval = std::chrono::seconds(0);
+    // 保留 path.1 ... path.N (path.1 最新); 为 0 时轮转只截断当前文件
+    size_t                    max_files       = 5;
+};
+
+// 以 O_APPEND 打开的日志文件
+//  - 每批记录不拷贝, 直接由 iovec 指向各条文本, 一次 writev 写出
+//  - 轮转在日志线程上 rename 后重新打开, 生产者只写队列, 不会因此阻塞
+//  - 写入失败时丢弃该批内容, 日志线程上不抛异常
+class FileSink final: public LogSink {
+public:
+    explicit FileSink(FileSinkOptions options);
+    ~FileSink() override;
+
+    [[nodiscard]] auto is_open() const noexcept -> bool;
+    [[nodiscard]] auto path() const noexcept -> const std::filesystem::path&;
+
+    // 当前文件已写入的字节数, 包括打开时已有的内容
+    [[nodiscard]] auto file_bytes() const noexcept -> std::uint64_t;
+    // 尚在缓冲区中未写出的字节数
+    [[nodiscard]] auto pending_bytes() const noexcept -> size_t;
+    // 累计 writev 调用次数
+    [[nodiscard]] auto write_calls() const noexcept -> std::uint64_t;
+
+    void write(std::span<const LogRecord> records) override;
+    void flush() override;
+
+    // 立即轮转, 先写出缓冲内容
+    void rotate();
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+// 保留最近 capacity 字节日志的内存环, 供界面或崩溃报告读取; 可被任意线程读取
+class RingSink final: public LogSink {
+public:
+    explicit RingSink(size_t capacity);
+
+    void write(std::span<const LogRecord> records) override;
+    void flush() override {}
+
+    // 按时间顺序取出当前内容; 环已回绕时去掉开头不完整的一行
+    [[nodiscard]] auto snapshot() const -> std::string;
+private:
+    void append(std::string_view text);
+
+    mutable std::mutex m_mutex;
+    std::vector<char> m_data;
+    size_t m_head = 0;     // 下一个写入位置
+    bool   m_wrapped = false;
+};
+
+// 把同一批记录分发给多个 sink, 每个 sink 有自己的有界队列与写线程
+//  - 一批记录只拷贝一次, 由各 sink 的队列共享, 不会按 sink 重复格式化或拷贝
+//  - 队列满时丢弃该 sink 最旧的批次, 慢的终端或网络盘不会拖慢其他 sink 和调用方
+//  - 每个 sink 有自己的最低级别, 低于它的记录不交给该 sink
+class FanoutSink final: public LogSink {
+public:
+    FanoutSink();
+    // 写完各队列中已有的批次后停止写线程
+    ~FanoutSink() override;
+
+    // 需在开始写入前添加; 返回该 sink 的序号
+    auto add(std::shared_ptr<LogSink> sink, LogLevel min_level = LogLevel::DEBUG) -> size_t;
+
+    void write(std::span<const LogRecord> records) override;
+    // 各写线程在自己的队列排空时 flush 对应 sink, 这里不需要等待
+    void flush() override {}
+
+    // 等待目前为止分发的批次全部写出 (或被丢弃)
+    void wait_idle();
+
+    // 第 index 个 sink 因队列满被丢弃的批次数
+    [[nodiscard]] auto dropped(size_t index) const -> size_t;
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace v2
+} // namespace labelimg::core::logger
+
+#endif // LOG_SINK_HPP
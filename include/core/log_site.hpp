@@ -0,0 +1,149 @@
+#ifndef LOG_SITE_HPP
+#define LOG_SITE_HPP
+
+#include <core/log_codec.hpp>
+#include "utils/non-copyable.h"
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace labelimg::core::logger {
+inline namespace v2 {
+
+// 二进制日志中参数的类型标记, 离线解码时据此读出参数并交给 fmt
+enum class ArgTag: std::uint8_t {
+    BOOL, CHAR,
+    I8, U8, I16, U16, I32, U32, I64, U64,
+    F32, F64,
+    STRING,   // 4 字节长度 + UTF-8 内容
+    POINTER,  // 8 字节地址
+};
+
+} // namespace v2
+
+namespace detail {
+
+template <typename T>
+consteval auto integral_tag() -> ArgTag {
+    constexpr bool is_signed = std::is_signed_v<T>;
+    if constexpr (sizeof(T) == 1) return is_signed ? ArgTag::I8  : ArgTag::U8;
+    if constexpr (sizeof(T) == 2) return is_signed ? ArgTag::I16 : ArgTag::U16;
+    if constexpr (sizeof(T) == 4) return is_signed ? ArgTag::I32 : ArgTag::U32;
+    return is_signed ? ArgTag::I64 : ArgTag::U64;
+}
+
+// 解码后的参数类型到写入文件的类型标记; 其余可格式化类型在日志线程上转成字符串
+template <typename T>
+consteval auto wire_tag() -> ArgTag {
+    if constexpr (std::is_same_v<T, bool>)                                 return ArgTag::BOOL;
+    else if constexpr (std::is_same_v<T, char>)                            return ArgTag::CHAR;
+    else if constexpr (std::is_integral_v<T>)                              return integral_tag<T>();
+    else if constexpr (std::is_same_v<T, float>)                           return ArgTag::F32;
+    else if constexpr (std::is_floating_point_v<T>)                        return ArgTag::F64;
+    else if constexpr (std::is_pointer_v<T>)                               return ArgTag::POINTER;
+    else                                                                   return ArgTag::STRING;
+}
+
+template <typename T>
+void write_wire(fmt::memory_buffer& out, const T& value) {
+    constexpr ArgTag tag = wire_tag<T>();
+
+    auto append = [&out]<typename U>(const U& raw) {
+        auto* bytes = reinterpret_cast<const char*>(&raw);
+        out.append(bytes, bytes + sizeof(U));
+    };
+    auto append_string = [&](std::string_view text) {
+        append(static_cast<std::uint32_t>(text.size()));
+        out.append(text.data(), text.data() + text.size());
+    };
+
+    if constexpr (tag == ArgTag::F64)          append(static_cast<double>(value));
+    else if constexpr (tag == ArgTag::POINTER) append(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value)));
+    else if constexpr (tag != ArgTag::STRING)  append(value);
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>) append_string(value);
+    else {
+        fmt::memory_buffer text;
+        fmt::format_to(std::back_inserter(text), "{}", value);
+        append_string({text.data(), text.size()});
+    }
+}
+
+} // namespace detail
+
+inline namespace v2 {
+
+// 日志线程上的二进制编码入口: 读出环中的参数编码, 按类型标记重新编码后追加到 out
+using BinaryArgEncoder = void (*)(const std::byte* args, fmt::memory_buffer& out);
+
+template <DeferredLogArg... Args>
+struct BinaryArgs {
+    static constexpr std::array<ArgTag, sizeof...(Args)> tags{
+        detail::wire_tag<typename log_codec_t<Args>::decoded_type>()...
+    };
+
+    // 逗号折叠保证按参数顺序解码
+    static void encode([[maybe_unused]] const std::byte* args, [[maybe_unused]] fmt::memory_buffer& out) {
+        (detail::write_wire<typename log_codec_t<Args>::decoded_type>(out, log_codec_t<Args>::decode(args)), ...);
+    }
+};
+
+// 调用点的编译期信息, 由宏在调用处以 static constexpr 构造
+struct LogSiteInfo {
+    std::uint8_t     level;
+    std::string_view level_name;
+    std::string_view file;
+    std::uint32_t    line;
+    std::string_view function;
+    std::string_view format;
+};
+
+// 已注册的调用点; 地址在进程内稳定, 记录中只保存其指针或 id
+struct LogSite {
+    LogSiteInfo            info;
+    std::span<const ArgTag> arg_tags;
+    // 没有二进制输出时用于格式化成文本
+    DeferredFormatter      formatter;
+    BinaryArgEncoder       encoder;
+    std::uint32_t          id;
+};
+
+// 进程内所有调用点的注册表, 每个调用点首次执行时注册一次
+class LogSiteRegistry: private NonCopyable {
+public:
+    static auto instance() -> LogSiteRegistry& {
+        static LogSiteRegistry registry;
+        return registry;
+    }
+
+    template <DeferredLogArg... Args>
+    [[nodiscard]] auto add(const LogSiteInfo& info, DeferredFormatter formatter) -> const LogSite& {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_sites.emplace_back(LogSite{
+            .info      = info,
+            .arg_tags  = BinaryArgs<Args...>::tags,
+            .formatter = formatter,
+            .encoder   = &BinaryArgs<Args...>::encode,
+            .id        = static_cast<std::uint32_t>(m_sites.size())
+        });
+    }
+
+    [[nodiscard]] auto size() const -> size_t {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_sites.size();
+    }
+private:
+    LogSiteRegistry() = default;
+
+    mutable std::mutex m_mutex;
+    // deque 追加时不移动已有元素
+    std::deque<LogSite> m_sites;
+};
+
+} // namespace v2
+} // namespace labelimg::core::logger
+
+#endif // LOG_SITE_HPP
@@ -0,0 +1,200 @@
+#ifndef LOG_THROTTLE_HPP
+#define LOG_THROTTLE_HPP
+
+#include "core/refl/detail/hash.hpp"
+#include "utils/non-copyable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <source_location>
+#include <string_view>
+#include <utility>
+
+namespace labelimg::core::logger {
+inline namespace v2 {
+
+struct ThrottlePolicy {
+    // 令牌桶: 每秒补充 per_second 个, 最多积攒 burst 个; 每写出一条 (含汇总) 消耗一个
+    double        per_second = 20.0;
+    std::uint32_t burst      = 20;
+    // 同一条消息持续重复时, 每隔 report_interval 写出一次 "重复 N 次" 的汇总
+    std::chrono::milliseconds report_interval = std::chrono::seconds(1);
+};
+
+struct ThrottleDecision {
+    bool          emit       = false;  // 是否写出本条消息
+    std::uint32_t repeated   = 0;      // 需先报告的: 上一条消息被折叠的重复次数
+    std::uint32_t suppressed = 0;      // 需先报告的: 被限流丢弃的消息数
+
+    [[nodiscard]] auto has_report() const noexcept -> bool { return repeated != 0 || suppressed != 0; }
+};
+
+// 写出汇总行的函数; 调用点不再写日志时, 尚未报告的计数由它写出 (emit 恒为 false)
+using ThrottleReporter = void (*)(const ThrottleDecision&);
+
+class LogThrottle;
+
+// 写出所有调用点尚未报告的计数 (不必等 report_interval)
+void flush_throttles();
+
+} // namespace v2
+
+namespace detail {
+// 带 reporter 的 LogThrottle 在构造时登记, 析构时写出未报告的计数并注销; 定时汇总只作用于仍在登记中的调用点
+void register_throttle(LogThrottle& throttle);
+void unregister_throttle(LogThrottle& throttle);
+// 在共享计时器上登记一次 deadline 到期的汇总
+void schedule_throttle_report(LogThrottle& throttle, std::chrono::steady_clock::time_point deadline);
+// 日志后台停止前调用: 写出所有未报告的计数, 之后不再定时汇总 (后台已不再接收记录)
+void close_throttles();
+} // namespace detail
+
+inline namespace v2 {
+
+// 调用点的键: 文件名的 FNV-1a 与行号组合, 编译期计算
+[[nodiscard]] consteval auto make_throttle_site_key(const std::source_location& location) -> std::size_t {
+    return refl::hash::hash_combine(refl::hash::string_hash(location.file_name()), location.line());
+}
+
+// 每个调用点一份的限流与去重状态
+//  - 以调用点与格式化后内容的哈希判断是否与上一条相同, 相同则只计数不写出
+//  - 内容变化时先报告上一条的重复次数; 持续重复时按 report_interval 定期报告
+//  - 不同内容按令牌桶限流, 被丢弃的条数在下一次写出时一并报告
+//  - 指定 reporter 时, 调用点停止写日志后未报告的计数在 report_interval 后由共享计时器写出, 日志停止时也会写出
+// 日志风暴下每个调用点每秒最多写出 per_second 条, 队列与 I/O 有界, 且不会丢失 "发生过" 这一信号
+class LogThrottle: private NonCopyable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit LogThrottle(std::size_t site_key, ThrottlePolicy policy = {}, ThrottleReporter reporter = nullptr)
+        : m_site_key{site_key}, m_policy{policy}, m_reporter{reporter}, m_tokens{static_cast<double>(policy.burst)} {
+        if (m_reporter) detail::register_throttle(*this);
+    }
+
+    ~LogThrottle() {
+        if (m_reporter) detail::unregister_throttle(*this);
+    }
+
+    [[nodiscard]] auto site_key() const noexcept -> std::size_t { return m_site_key; }
+
+    [[nodiscard]] auto admit(std::string_view payload, Clock::time_point now = Clock::now()) -> ThrottleDecision {
+        const std::size_t key = refl::hash::hash_combine(m_site_key, refl::hash::string_hash(payload));
+
+        ThrottleDecision decision;
+        Clock::time_point deadline{};
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            decision = admit_locked(key, now);
+            deadline = arm_report();
+        }
+        // 计时器有自己的锁, 在本调用点的锁外登记
+        if (deadline != Clock::time_point{}) detail::schedule_throttle_report(*this, deadline);
+        return decision;
+    }
+
+    // 取出尚未报告的计数, 不消耗令牌; 没有时返回空结果
+    [[nodiscard]] auto take_pending(Clock::time_point now = Clock::now()) -> ThrottleDecision {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return take_pending_locked(now);
+    }
+
+    // 写出尚未报告的计数 (没有 reporter 时什么也不做)
+    void report_pending(Clock::time_point now = Clock::now()) {
+        if (!m_reporter) return;
+        if (const auto decision = take_pending(now); decision.has_report()) m_reporter(decision);
+    }
+
+    // 计时器到期: 距上次报告已满 report_interval 时写出未报告的计数, 期间有过报告则重新计时
+    void report_due(Clock::time_point now = Clock::now()) {
+        ThrottleDecision decision;
+        Clock::time_point deadline{};
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_report_armed = false;
+            if (now - m_last_report >= m_policy.report_interval) decision = take_pending_locked(now);
+            else                                                 deadline = arm_report();
+        }
+        if (decision.has_report()) m_reporter(decision);
+        else if (deadline != Clock::time_point{}) detail::schedule_throttle_report(*this, deadline);
+    }
+private:
+    auto admit_locked(std::size_t key, Clock::time_point now) -> ThrottleDecision {
+        refill(now);
+
+        if (m_has_last && key == m_last_key) {
+            // 上一条没有写出时, 它的重复也只算作被丢弃
+            if (m_last_emitted) ++m_repeated;
+            else                ++m_suppressed;
+
+            if (now - m_last_report < m_policy.report_interval || !take_token()) return {};
+            m_last_report = now;
+            return {.emit = false, .repeated = std::exchange(m_repeated, 0), .suppressed = std::exchange(m_suppressed, 0)};
+        }
+
+        m_last_key = key;
+        m_has_last = true;
+        m_last_emitted = take_token();
+        if (!m_last_emitted) {
+            m_suppressed += 1 + std::exchange(m_repeated, 0);
+            return {};
+        }
+
+        m_last_report = now;
+        return {.emit = true, .repeated = std::exchange(m_repeated, 0), .suppressed = std::exchange(m_suppressed, 0)};
+    }
+
+    auto take_pending_locked(Clock::time_point now) -> ThrottleDecision {
+        if (m_repeated == 0 && m_suppressed == 0) return {};
+        m_last_report = now;
+        return {.emit = false, .repeated = std::exchange(m_repeated, 0), .suppressed = std::exchange(m_suppressed, 0)};
+    }
+
+    // 有未报告的计数且尚未计时: 返回下一次汇总的时刻, 否则返回空
+    auto arm_report() -> Clock::time_point {
+        if (!m_reporter || m_report_armed || (m_repeated == 0 && m_suppressed == 0)) return {};
+        m_report_armed = true;
+        return m_last_report + m_policy.report_interval;
+    }
+
+    void refill(Clock::time_point now) {
+        if (m_refilled == Clock::time_point{}) m_refilled = now;
+        const std::chrono::duration<double> elapsed = now - m_refilled;
+        m_tokens   = std::min<double>(m_policy.burst, m_tokens + elapsed.count() * m_policy.per_second);
+        m_refilled = now;
+    }
+
+    auto take_token() -> bool {
+        if (m_tokens < 1.0) return false;
+        m_tokens -= 1.0;
+        return true;
+    }
+
+    const std::size_t    m_site_key;
+    const ThrottlePolicy m_policy;
+    const ThrottleReporter m_reporter;
+
+    std::mutex        m_mutex;
+    double            m_tokens;
+    Clock::time_point m_refilled{};
+    Clock::time_point m_last_report{};
+
+    std::size_t   m_last_key     = 0;
+    bool          m_has_last     = false;
+    bool          m_last_emitted = false;
+    std::uint32_t m_repeated     = 0;
+    std::uint32_t m_suppressed   = 0;
+    bool          m_report_armed = false;
+};
+
+} // namespace v2
+} // namespace labelimg::core::logger
+
+// 在调用处定义该调用点的 LogThrottle (静态变量, 每个调用点一份)
+#define LOG_THROTTLE_AT_SITE(name, ...)                                                                 \
+    static ::labelimg::core::logger::LogThrottle name {                                                \
+        ::labelimg::core::logger::make_throttle_site_key(::std::source_location::current())            \
+        __VA_OPT__(,) __VA_ARGS__ }
+
+#endif // LOG_THROTTLE_HPP
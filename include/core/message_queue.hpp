@@ -2,6 +2,10 @@
 #define MESSAGE_QUEUE_H
 
 #include <core/queue.hpp>
+#include <core/queue/detail/queue_utils.hpp>
+#include <core/queue/frame_allocator.hpp>
+#include <core/queue/wait_strategy.hpp>
+#include <ranges>
 
 namespace labelimg::core::queue {
 namespace v1 {
@@ -67,16 +71,47 @@ inline namespace v2 {
 template <typename P>
 concept IsTagPolicy = std::is_empty_v<P> && std::is_default_constructible_v<P>;
 
-struct MutexPolicy {};
-struct CoroutinePolicy {};
+// 队列已满时的处理策略
+enum class OverflowPolicy: std::uint8_t {
+    Block,       // 阻塞生产者直到有空位
+    DropNewest,  // 丢弃新元素
+    DropOldest,  // 丢弃最旧的元素
+    Spill        // 交给溢出处理函数 (如写入磁盘)
+};
+
+// Capacity == 0 表示无界, 此时溢出策略不生效
+// Wait 为消费者 (以及 Block 策略下生产者) 的等待方式, 见 core/queue/wait_strategy.hpp
+template <std::size_t Capacity = 0, OverflowPolicy Overflow = OverflowPolicy::Block, WaitStrategy Wait = CondVarWait>
+struct BoundedMutexPolicy {};
+
+using MutexPolicy = BoundedMutexPolicy<>;
+
+// 协程队列恢复等待者时使用的执行器
+template <typename E>
+concept CoroutineExecutor = requires (E& executor, std::coroutine_handle<> handle) {
+    executor.post(handle);
+};
+
+// 在调用 post 的线程上直接恢复 (生产者线程会变成消费者)
+struct InlineExecutor {
+    void post(std::coroutine_handle<> handle) { handle.resume(); }
+};
+
+template <CoroutineExecutor Executor = InlineExecutor>
+struct BasicCoroutinePolicy {};
+
+using CoroutinePolicy = BasicCoroutinePolicy<>;
 
 template <typename T, IsTagPolicy ConcurrencyPolicy = MutexPolicy>
 class MessageQueue;
 
-template <typename T>
-class MessageQueue<T, MutexPolicy>: public Queue<MessageQueue<T, MutexPolicy>, T>
-                                  , private NonCopyable {
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+class MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>
+    : public Queue<MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>, T>
+    , private NonCopyable {
 public:
+    using SpillHandler = std::function<void(T&&)>;
+
     MessageQueue() = default;
     ~MessageQueue() = default;
 
@@ -84,107 +119,367 @@ public:
     auto try_pop(T&) -> bool;
     auto wait_for_pop(T&, std::chrono::milliseconds timeout) -> bool;
 
+    // 不阻塞; 元素未入队时返回 false 且 value 不会被移动
+    // DropOldest 策略下总是成功 (淘汰最旧元素)
+    template <typename U>
+    auto try_push(U&& value) -> bool;
+
+    // 批量接口: 每次调用只加锁 / 唤醒一次
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    void push_bulk(R&& range);
+
+    // 最多弹出 max 个元素写入 out, 返回实际弹出数量
+    template <std::output_iterator<T> OutIt>
+    auto try_pop_bulk(OutIt out, size_t max) -> size_t;
+
+    // 一次性换出全部积压元素, 返回追加到 out 的数量
+    template <typename Container>
+        requires requires (Container& c, T v) { c.push_back(std::move(v)); }
+    auto drain_into(Container& out) -> size_t;
+
+    // 等待至少一个元素后换出全部积压元素
+    template <typename Container>
+        requires requires (Container& c, T v) { c.push_back(std::move(v)); }
+    auto wait_and_drain_into(Container& out) -> size_t;
+
+    // 等待至少一个元素 (或超时) 后换出全部积压元素
+    template <typename Container>
+        requires requires (Container& c, T v) { c.push_back(std::move(v)); }
+    auto wait_for_drain_into(Container& out, std::chrono::milliseconds timeout) -> size_t;
+
+    void set_spill_handler(SpillHandler handler) requires (Overflow == OverflowPolicy::Spill) {
+        auto lock = acquire_lock();
+        m_spill_handler = std::move(handler);
+    }
+
+    [[nodiscard]] static constexpr auto
+    capacity() noexcept -> size_t { return Capacity; }
+
+    [[nodiscard]] static constexpr auto
+    is_bounded() noexcept -> bool { return Capacity != 0; }
+
+    // 统计: 被丢弃 / 曾被阻塞 / 被溢出处理的元素数量
+    [[nodiscard]] auto dropped_count() const noexcept -> size_t { return m_dropped.load(std::memory_order_relaxed); }
+    [[nodiscard]] auto blocked_count() const noexcept -> size_t { return m_blocked.load(std::memory_order_relaxed); }
+    [[nodiscard]] auto spilled_count() const noexcept -> size_t { return m_spilled.load(std::memory_order_relaxed); }
+    // 加锁时发生竞争的次数, 仅在 Instrumented<> 内部统计
+    [[nodiscard]] auto contended_count() const noexcept -> size_t { return m_lock_counter.contended(); }
+
     void push_impl(T);
     void pop_impl();
     auto front_impl() -> T&;
     [[nodiscard]] auto empty_impl() const -> bool;
     [[nodiscard]] auto size_impl()  const -> size_t;
 private:
+    [[nodiscard]] auto acquire_lock() const -> std::unique_lock<std::mutex> { return m_lock_counter.lock(m_mutex); }
+
+    [[nodiscard]] auto full() const noexcept -> bool {
+        if constexpr (Capacity == 0) return false;
+        else return m_queue.size() >= Capacity;
+    }
+
+    // 在持锁状态下按溢出策略入队一个元素; 返回 false 表示需要在锁外交给溢出处理函数
+    auto enqueue_locked(std::unique_lock<std::mutex>& lock, T& value) -> bool;
+    void spill(T&& value);
+    // 消费者腾出空位后唤醒被阻塞的生产者
+    void notify_not_full(size_t freed);
+
+    template <typename Container>
+    static auto move_backlog(std::queue<T>& backlog, Container& out) -> size_t;
+
     std::queue<T> m_queue;
     mutable std::mutex m_mutex;
-    std::condition_variable m_cond;
+    [[no_unique_address]] mutable detail::LockCounter<detail::counts_lock_contention<T>> m_lock_counter;
+    // 等待器自带等待者计数, 没有线程等待时 notify 为空操作
+    detail::Waiter<Wait> m_not_empty;
+    detail::Waiter<Wait> m_not_full;
+    SpillHandler m_spill_handler;
+
+    std::atomic<size_t> m_dropped{0};
+    std::atomic<size_t> m_blocked{0};
+    std::atomic<size_t> m_spilled{0};
 };
 
-template <typename T>
-void MessageQueue<T, MutexPolicy>::push_impl(T value) {
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::enqueue_locked(std::unique_lock<std::mutex>& lock, T& value) -> bool {
+    if (full()) {
+        if constexpr (Overflow == OverflowPolicy::Block) {
+            m_blocked.fetch_add(1, std::memory_order_relaxed);
+            m_not_full.wait(lock, [this] { return !full(); });
+        } else if constexpr (Overflow == OverflowPolicy::DropNewest) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        } else if constexpr (Overflow == OverflowPolicy::DropOldest) {
+            m_queue.pop();
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            return false;
+        }
+    }
+    m_queue.push(std::move(value));
+    return true;
+}
+
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+void MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::spill(T&& value) {
+    SpillHandler handler;
     {
-        std::lock_guard<std::mutex> lock{m_mutex};
-        m_queue.push(std::move(value));
+        auto lock = acquire_lock();
+        handler = m_spill_handler;
+    }
+
+    if (handler) {
+        m_spilled.fetch_add(1, std::memory_order_relaxed);
+        handler(std::move(value));
+    } else {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
     }
-    m_cond.notify_one();
 }
 
-template <typename T>
-void MessageQueue<T, MutexPolicy>::pop_impl() {
-    std::lock_guard<std::mutex> lock{m_mutex};
-    if (!m_queue.empty()) m_queue.pop();
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+void MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::notify_not_full(size_t freed) {
+    if constexpr (Capacity != 0 && Overflow == OverflowPolicy::Block) {
+        if (freed == 1) m_not_full.notify_one();
+        else if (freed > 1) m_not_full.notify_all();
+    }
+}
+
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+void MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::push_impl(T value) {
+    bool enqueued = false;
+    {
+        auto lock = acquire_lock();
+        enqueued = enqueue_locked(lock, value);
+    }
+
+    if (enqueued) m_not_empty.notify_one();
+    else spill(std::move(value));
+}
+
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+template <typename U>
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::try_push(U&& value) -> bool {
+    {
+        auto lock = acquire_lock();
+        if (full()) {
+            if constexpr (Overflow != OverflowPolicy::DropOldest) return false;
+            else {
+                m_queue.pop();
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        m_queue.emplace(std::forward<U>(value));
+    }
+    m_not_empty.notify_one();
+    return true;
+}
+
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+void MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::pop_impl() {
+    size_t freed = 0;
+    {
+        auto lock = acquire_lock();
+        if (!m_queue.empty()) {
+            m_queue.pop();
+            freed = 1;
+        }
+    }
+    notify_not_full(freed);
 } 
 
-template <typename T>
-auto MessageQueue<T, MutexPolicy>::front_impl() -> T& {
-    std::lock_guard<std::mutex> lock{m_mutex};
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::front_impl() -> T& {
+    auto lock = acquire_lock();
     return m_queue.front();
 }
 
-template <typename T>
-auto MessageQueue<T, MutexPolicy>::empty_impl() const -> bool {
-    std::lock_guard<std::mutex> lock{m_mutex};
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::empty_impl() const -> bool {
+    auto lock = acquire_lock();
     return m_queue.empty();
 }
 
-template <typename T>
-auto MessageQueue<T, MutexPolicy>::size_impl() const -> size_t {
-    std::lock_guard<std::mutex> lock{m_mutex};
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::size_impl() const -> size_t {
+    auto lock = acquire_lock();
     return m_queue.size();
 }
 
-template <typename T>
-void MessageQueue<T>::wait_and_pop(T& value) {
-    std::unique_lock<std::mutex> lock{m_mutex};
-    m_cond.wait(lock, [this] { return !m_queue.empty(); });
-    value = std::move(m_queue.front());
-    m_queue.pop();
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+void MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::wait_and_pop(T& value) {
+    {
+        auto lock = acquire_lock();
+        m_not_empty.wait(lock, [this] { return !m_queue.empty(); });
+        value = std::move(m_queue.front());
+        m_queue.pop();
+    }
+    notify_not_full(1);
 }
 
-template <typename T>
-auto MessageQueue<T>::try_pop(T& value) -> bool {
-    std::lock_guard<std::mutex> lock{m_mutex};
-    if (m_queue.empty()) return false;
-    value = std::move(m_queue.front());
-    m_queue.pop();
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::try_pop(T& value) -> bool {
+    {
+        auto lock = acquire_lock();
+        if (m_queue.empty()) return false;
+        value = std::move(m_queue.front());
+        m_queue.pop();
+    }
+    notify_not_full(1);
     return true;
 }
 
-template <typename T>
-auto MessageQueue<T>::wait_for_pop(T& value, std::chrono::milliseconds timeout) -> bool {
-    std::unique_lock<std::mutex> lock{m_mutex};
-    if (!m_cond.wait_for(lock, timeout, [this] { return !m_queue.empty(); })) 
-        return false;
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::wait_for_pop(T& value, std::chrono::milliseconds timeout) -> bool {
+    {
+        auto lock = acquire_lock();
+        if (!m_not_empty.wait_for(lock, timeout, [this] { return !m_queue.empty(); })) 
+            return false;
 
-    value = std::move(m_queue.front());
-    m_queue.pop();
+        value = std::move(m_queue.front());
+        m_queue.pop();
+    }
+    notify_not_full(1);
     return true;
 }
 
-template <typename T>
-class MessageQueue<T, CoroutinePolicy>: public Queue<MessageQueue<T, CoroutinePolicy>, T>
-                                      , private NonCopyable {
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+void MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::push_bulk(R&& range) {
+    size_t pushed = 0;
+    std::vector<T> overflow;
+    {
+        auto lock = acquire_lock();
+        for (auto&& element: range) {
+            T value = [&]() -> T {
+                if constexpr (std::is_rvalue_reference_v<R&&> && !std::ranges::borrowed_range<R>)
+                    return std::move(element);
+                else
+                    return element;
+            }();
+
+            if (enqueue_locked(lock, value)) ++pushed;
+            else overflow.push_back(std::move(value));
+
+            // Block 策略下等待空位前先唤醒消费者, 避免互相等待
+            if constexpr (Capacity != 0 && Overflow == OverflowPolicy::Block) {
+                if (full()) m_not_empty.notify_all();
+            }
+        }
+    }
+
+    if (pushed == 1) m_not_empty.notify_one();
+    else if (pushed > 1) m_not_empty.notify_all();
+
+    for (auto& value: overflow) spill(std::move(value));
+}
+
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+template <std::output_iterator<T> OutIt>
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::try_pop_bulk(OutIt out, size_t max) -> size_t {
+    size_t count = 0;
+    {
+        auto lock = acquire_lock();
+        count = std::min(max, m_queue.size());
+        for (size_t i = 0; i < count; ++i) {
+            *out++ = std::move(m_queue.front());
+            m_queue.pop();
+        }
+    }
+    notify_not_full(count);
+    return count;
+}
+
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+template <typename Container>
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::move_backlog(std::queue<T>& backlog, Container& out) -> size_t {
+    size_t count = backlog.size();
+    if constexpr (requires { out.reserve(out.size() + count); }) 
+        out.reserve(out.size() + count);
+
+    while (!backlog.empty()) {
+        out.push_back(std::move(backlog.front()));
+        backlog.pop();
+    }
+    return count;
+}
+
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+template <typename Container>
+    requires requires (Container& c, T v) { c.push_back(std::move(v)); }
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::drain_into(Container& out) -> size_t {
+    std::queue<T> backlog;
+    {
+        auto lock = acquire_lock();
+        if (m_queue.empty()) return 0;
+        std::swap(backlog, m_queue);
+    }
+    notify_not_full(backlog.size());
+    return move_backlog(backlog, out);
+}
+
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+template <typename Container>
+    requires requires (Container& c, T v) { c.push_back(std::move(v)); }
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::wait_and_drain_into(Container& out) -> size_t {
+    std::queue<T> backlog;
+    {
+        auto lock = acquire_lock();
+        m_not_empty.wait(lock, [this] { return !m_queue.empty(); });
+        std::swap(backlog, m_queue);
+    }
+    notify_not_full(backlog.size());
+    return move_backlog(backlog, out);
+}
+
+template <typename T, std::size_t Capacity, OverflowPolicy Overflow, WaitStrategy Wait>
+template <typename Container>
+    requires requires (Container& c, T v) { c.push_back(std::move(v)); }
+auto MessageQueue<T, BoundedMutexPolicy<Capacity, Overflow, Wait>>::wait_for_drain_into(Container& out, std::chrono::milliseconds timeout) -> size_t {
+    std::queue<T> backlog;
+    {
+        auto lock = acquire_lock();
+        if (!m_not_empty.wait_for(lock, timeout, [this] { return !m_queue.empty(); }))
+            return 0;
+        std::swap(backlog, m_queue);
+    }
+    notify_not_full(backlog.size());
+    return move_backlog(backlog, out);
+}
+
+template <typename T, typename Executor>
+class MessageQueue<T, BasicCoroutinePolicy<Executor>>: public Queue<MessageQueue<T, BasicCoroutinePolicy<Executor>>, T>
+                                                     , private NonCopyable {
 public:
-    MessageQueue() = default;
-    ~MessageQueue() = default;
+    // 无状态执行器 (如 InlineExecutor) 可以直接默认构造
+    MessageQueue() requires std::is_empty_v<Executor> && std::default_initializable<Executor>
+        : m_executor{&default_executor()} {}
 
-    struct PopPolicy {};
-    struct PushPolicy {};
-    // template args
+    explicit MessageQueue(Executor& executor): m_executor{&executor} {}
+    ~MessageQueue() = default;
 
+    // 侵入式等待节点, 存放在等待者的协程帧中, 无需额外分配
     struct PopAwaiter {
         MessageQueue* queue;
         std::optional<T> value;
+        std::coroutine_handle<> handle{};
+        PopAwaiter* next = nullptr;
 
         [[nodiscard]] auto 
-        await_ready() const noexcept -> bool {
-            return !queue->m_queue.empty();
+        await_ready() -> bool {
+            value = queue->try_pop();
+            return value.has_value();
         }
 
-        void await_suspend(std::coroutine_handle<> handle) {
-            queue->m_waiting_cosumers.push_back(handle);
+        void await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            queue->push_waiter(this);
+            // 注册后再检查一次, 避免与生产者交错时丢失唤醒
+            queue->dispatch();
         }
 
         auto await_resume() -> T {
-            if (!value.has_value()) {
-                value = std::move(queue->m_queue.front());
-                queue->m_queue.pop();
-            }
             return std::move(value.value());
         }
     };
@@ -204,7 +499,7 @@ public:
 
         void await_suspend([[maybe_unused]]std::coroutine_handle<> handle) noexcept {}
 
-        auto await_resume() -> T {
+        void await_resume() {
             queue->push_impl(std::move(value));
         }
     };
@@ -213,6 +508,9 @@ public:
         return PushAwaiter{this, std::move(value)};
     }
 
+    void set_executor(Executor& executor) noexcept { m_executor = &executor; }
+
+    // 可在任意线程调用; 等待中的消费者交给执行器恢复, 而不是在生产者线程上内联执行
     void push_impl(T);
     void pop_impl();
     auto front_impl() -> T&;
@@ -221,71 +519,181 @@ public:
     
     auto try_pop() -> std::optional<T>;
 private:
-    std::queue<T> m_queue;
-    std::list<std::coroutine_handle<>> m_waiting_cosumers;
+    static auto default_executor() -> Executor& {
+        static Executor executor;
+        return executor;
+    }
+
+    // 等待者入栈: 无锁 (Treiber stack)
+    void push_waiter(PopAwaiter* waiter) noexcept {
+        PopAwaiter* head = m_waiters.load(std::memory_order_relaxed);
+        do {
+            waiter->next = head;
+        } while (!m_waiters.compare_exchange_weak(head, waiter, 
+                                                  std::memory_order_release, 
+                                                  std::memory_order_relaxed));
+    }
+
+    // 等待者出栈: 只在持有 m_mutex 时调用, 单一出栈者不存在 ABA 问题
+    auto pop_waiter() noexcept -> PopAwaiter* {
+        PopAwaiter* head = m_waiters.load(std::memory_order_acquire);
+        while (head && !m_waiters.compare_exchange_weak(head, head->next, 
+                                                        std::memory_order_acquire, 
+                                                        std::memory_order_acquire)) {}
+        return head;
+    }
 
-    void resume_one_waiter() {
-        if (!m_waiting_cosumers.empty()) {
-            auto handle = m_waiting_cosumers.front();
-            m_waiting_cosumers.pop_front();
-            handle.resume();
+    // 把队列中的元素逐个交给等待者, 并投递到执行器
+    void dispatch() {
+        while (m_waiters.load(std::memory_order_acquire) != nullptr) {
+            PopAwaiter* waiter = nullptr;
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                if (m_queue.empty()) return;
+                waiter = pop_waiter();
+                if (!waiter) return;
+
+                waiter->value.emplace(std::move(m_queue.front()));
+                m_queue.pop();
+            }
+            m_executor->post(waiter->handle);
         }
     }
+
+    std::queue<T> m_queue;
+    mutable std::mutex m_mutex;
+    std::atomic<PopAwaiter*> m_waiters{nullptr};
+    Executor* m_executor;
 };
 
-template <typename T>
-void MessageQueue<T, CoroutinePolicy>::push_impl(T value) {
-    m_queue.push(std::move(value));
-    resume_one_waiter();
+template <typename T, typename Executor>
+void MessageQueue<T, BasicCoroutinePolicy<Executor>>::push_impl(T value) {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_queue.push(std::move(value));
+    }
+    dispatch();
 }
 
-template <typename T>
-void MessageQueue<T, CoroutinePolicy>::pop_impl() {
+template <typename T, typename Executor>
+void MessageQueue<T, BasicCoroutinePolicy<Executor>>::pop_impl() {
+    std::lock_guard<std::mutex> lock{m_mutex};
     if (!m_queue.empty()) m_queue.pop();
 }
 
-template <typename T>
-auto MessageQueue<T, CoroutinePolicy>::front_impl() -> T& {
+template <typename T, typename Executor>
+auto MessageQueue<T, BasicCoroutinePolicy<Executor>>::front_impl() -> T& {
+    std::lock_guard<std::mutex> lock{m_mutex};
     return m_queue.front();
 }
 
-template <typename T>
-auto MessageQueue<T, CoroutinePolicy>::empty_impl() const -> bool {
+template <typename T, typename Executor>
+auto MessageQueue<T, BasicCoroutinePolicy<Executor>>::empty_impl() const -> bool {
+    std::lock_guard<std::mutex> lock{m_mutex};
     return m_queue.empty();
 }
 
-template <typename T>
-auto MessageQueue<T, CoroutinePolicy>::size_impl() const -> size_t {
+template <typename T, typename Executor>
+auto MessageQueue<T, BasicCoroutinePolicy<Executor>>::size_impl() const -> size_t {
+    std::lock_guard<std::mutex> lock{m_mutex};
     return m_queue.size();
 }
 
-template <typename T>
-auto MessageQueue<T, CoroutinePolicy>::try_pop() -> std::optional<T> {
+template <typename T, typename Executor>
+auto MessageQueue<T, BasicCoroutinePolicy<Executor>>::try_pop() -> std::optional<T> {
+    std::lock_guard<std::mutex> lock{m_mutex};
     if (m_queue.empty()) return std::nullopt;
     T value = std::move(m_queue.front());
     m_queue.pop();
     return value;
 }
 
+} // namespace v2
+
+namespace detail {
+
+// Task 的续体槽位: 保存等待者的协程句柄, 或标记 "已完成"
+// 由于 Task 是立即启动的, 等待者登记与任务完成可能并发发生, 用一次 CAS / exchange 决出先后
+class ContinuationSlot {
+public:
+    // 登记等待者; 任务已经完成时返回 false, 调用方应直接继续执行
+    auto set(std::coroutine_handle<> waiter) noexcept -> bool {
+        void* expected = nullptr;
+        return m_state.compare_exchange_strong(expected, waiter.address(),
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire);
+    }
+
+    // 标记完成, 返回需要恢复的等待者 (没有时返回 noop_coroutine)
+    auto complete() noexcept -> std::coroutine_handle<> {
+        void* waiter = m_state.exchange(completed(), std::memory_order_acq_rel);
+        return waiter != nullptr ? std::coroutine_handle<>::from_address(waiter)
+                                 : std::noop_coroutine();
+    }
+
+    [[nodiscard]] auto
+    is_completed()
+    const noexcept -> bool { return m_state.load(std::memory_order_acquire) == completed(); }
+private:
+    static auto completed() noexcept -> void* {
+        static char sentinel;
+        return &sentinel;
+    }
+
+    std::atomic<void*> m_state{nullptr};
+};
+
+struct TaskPromiseBase {
+    // 结束时通过对称转移直接切换到等待者, 不增加调用栈深度
+    struct FinalAwaiter {
+        [[nodiscard]] constexpr auto
+        await_ready() const noexcept -> bool { return false; }
+
+        template <typename Promise>
+        auto await_suspend(std::coroutine_handle<Promise> handle) noexcept -> std::coroutine_handle<> {
+            return handle.promise().continuation.complete();
+        }
+
+        constexpr void await_resume() const noexcept {}
+    };
+
+    auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+    auto final_suspend()   noexcept -> FinalAwaiter { return {}; }
+
+    // 协程帧走线程本地的分级空闲链表, 大量短生命周期任务不再争用全局 malloc
+    static auto operator new(std::size_t size) -> void* { return FrameAllocator::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) noexcept { FrameAllocator::deallocate(ptr, size); }
+
+    ContinuationSlot continuation;
+};
+
+} // namespace detail
+
+inline namespace v2 {
+
 template <typename T = void>
 class Task {
 public:
-    struct promise_type {
+    struct promise_type: detail::TaskPromiseBase {
         std::variant<std::monostate, T, std::exception_ptr> result;
         
         auto get_return_object() -> Task {
             return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
         }
 
-        auto initial_suspend() noexcept -> std::suspend_never  { return {}; }
-        auto final_suspend()   noexcept -> std::suspend_always { return {}; }
+        template <typename U = T>
+            requires std::convertible_to<U, T>
+        void return_value(U&& value) {
+            result.template emplace<1>(std::forward<U>(value));
+        }
 
-        void return_value(T value) {
-            result = std::move(value);
+        void unhandled_exception() {
+            result.template emplace<2>(std::current_exception());
         }
 
-        void unhanled_exception() {
-            result = std::current_exception();
+        auto take() -> T {
+            if (result.index() == 2) std::rethrow_exception(std::get<2>(result));
+            return std::move(std::get<1>(result));
         }
     };
 
@@ -310,42 +718,64 @@ public:
     Task(const Task&) = delete;
     auto operator=(const Task&) -> Task& = delete;
 
-    auto get() -> T {
-        if (!m_handle || !m_handle.done()) {
-            throw std::runtime_error("Task not completed");
-        }
-
+    auto get() & -> T {
+        check_ready();
         auto& result = m_handle.promise().result;
-        if (std::holds_alternative<std::exception_ptr>(result)) {
-            std::rethrow_exception(std::get<std::exception_ptr>(result));
-        }
-        return std::get<T>(result);
+        if (result.index() == 2) std::rethrow_exception(std::get<2>(result));
+        return std::get<1>(result);
+    }
+
+    auto get() && -> T {
+        check_ready();
+        return m_handle.promise().take();
     }
 
     [[nodiscard]] auto 
     is_ready() const -> bool {
-        return m_handle && m_handle.done();
+        return m_handle && m_handle.promise().continuation.is_completed();
     }
+
+    struct Awaiter {
+        handle_type handle;
+
+        [[nodiscard]] auto
+        await_ready() const noexcept -> bool { return handle.promise().continuation.is_completed(); }
+
+        auto await_suspend(std::coroutine_handle<> waiter) noexcept -> bool {
+            return handle.promise().continuation.set(waiter);
+        }
+
+        auto await_resume() -> T { return handle.promise().take(); }
+    };
+
+    // co_await task: 等待任务完成并取走结果 (结果只能取一次)
+    auto operator co_await() noexcept -> Awaiter { return Awaiter{m_handle}; }
 private:
+    void check_ready() const {
+        if (!is_ready()) throw std::runtime_error("Task not completed");
+    }
+
     handle_type m_handle;
 };
+
 template <>
 class Task<void> {
 public:
-    struct promise_type {
+    struct promise_type: detail::TaskPromiseBase {
         std::exception_ptr exception;
         
         auto get_return_object() -> Task {
             return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
         }
 
-        auto initial_suspend() noexcept -> std::suspend_never { return {}; }
-        auto final_suspend() noexcept -> std::suspend_always { return {}; }
-
         void return_void() { }
         void unhandled_exception() {
             exception = std::current_exception();
         }
+
+        void take() {
+            if (exception) std::rethrow_exception(exception);
+        }
     };
 
     using handle_type = std::coroutine_handle<promise_type>;
@@ -364,24 +794,35 @@ public:
         return *this;
     }
 
-    Task(const Task&) = default;
+    Task(const Task&) = delete;
     auto operator=(const Task&) -> Task& = delete;
 
     void get() {
-        if (!m_handle || m_handle.done()) {
+        if (!is_ready()) {
             throw std::runtime_error("Task not completed");
         }
-
-        if (m_handle.promise().exception) {
-            std::rethrow_exception(m_handle.promise().exception);
-        }
+        m_handle.promise().take();
     }
 
     [[nodiscard]] auto
-    is_ready() -> bool {
-        return m_handle && m_handle.done();
+    is_ready() const -> bool {
+        return m_handle && m_handle.promise().continuation.is_completed();
     } 
 
+    struct Awaiter {
+        handle_type handle;
+
+        [[nodiscard]] auto
+        await_ready() const noexcept -> bool { return handle.promise().continuation.is_completed(); }
+
+        auto await_suspend(std::coroutine_handle<> waiter) noexcept -> bool {
+            return handle.promise().continuation.set(waiter);
+        }
+
+        void await_resume() { handle.promise().take(); }
+    };
+
+    auto operator co_await() noexcept -> Awaiter { return Awaiter{m_handle}; }
 private:
     handle_type m_handle;
 };
@@ -42,12 +42,12 @@ public:
 
     [[nodiscard]] auto empty() 
     const -> bool { 
-        return static_cast<Derived*>(this)->empty_impl(); 
+        return static_cast<const Derived*>(this)->empty_impl(); 
     }
 
     [[nodiscard]] auto size()
     const -> size_t {
-        return static_cast<Derived*>(this)->size_impl(); 
+        return static_cast<const Derived*>(this)->size_impl(); 
     }
 protected:
     ~Queue() = default;
@@ -0,0 +1,178 @@
+#ifndef BYTE_RING_HPP
+#define BYTE_RING_HPP
+
+#include <core/queue/detail/queue_utils.hpp>
+#include <cstring>
+#include <memory>
+#include <span>
+
+namespace labelimg::core::queue {
+inline namespace v2 {
+
+// 单生产者单消费者的变长记录环形缓冲区
+//  - 每条记录是连续的字节块: 8 字节长度头 + 按 8 字节对齐的内容
+//  - 末尾剩余空间放不下一条记录时写入回绕标记, 记录从下一圈开头开始
+//  - 生产者只写 m_head, 消费者只写 m_tail, 各自缓存对端位置; 快路径上没有读改写操作
+//
+// 生产者:
+//     if (auto* bytes = ring.try_reserve(size)) { std::memcpy(bytes, data, size); ring.commit(); }
+// 消费者:
+//     while (auto record = ring.front(); !record.empty()) { consume(record); ring.pop(); }
+template <std::size_t Capacity = 64 * 1024>
+    requires (detail::is_power_of_two(Capacity) && Capacity >= 64)
+class SpscByteRing: private NonCopyable {
+public:
+    SpscByteRing(): m_buffer{std::make_unique<Storage[]>(Capacity / sizeof(Storage))} {}
+    ~SpscByteRing() = default;
+
+    // 单条记录内容的上限 (扣除 8 字节长度头)
+    static constexpr std::size_t max_record_size = Capacity / 2 - 8;
+
+    // ---- 生产者端 ----
+    // 预留 size (>= 1) 字节的连续空间, 空间不足时返回 nullptr; 写完内容后调用 commit()
+    // 不支持空记录: front() 以空 span 表示没有记录
+    [[nodiscard]] auto try_reserve(std::size_t size) noexcept -> std::byte*;
+    // 发布最近一次 try_reserve 的记录
+    void commit() noexcept;
+
+    // ---- 消费者端 ----
+    // 下一条已发布记录的内容, 没有时返回空 span
+    [[nodiscard]] auto front() noexcept -> std::span<const std::byte>;
+    void pop() noexcept;
+
+    // 当前已发布的写入位置; 配合 front(limit) 只消费该位置之前的记录, 用于给一轮消费设上限
+    [[nodiscard]] auto published() noexcept -> std::size_t;
+    // 同 front(), 但读到 limit 处即视为没有记录
+    [[nodiscard]] auto front(std::size_t limit) noexcept -> std::span<const std::byte>;
+
+    // 生产者端: 按缓存的消费位置估算积压, 不读取共享状态 (可能偏大)
+    [[nodiscard]] auto
+    used_bytes_estimate()
+    const noexcept -> std::size_t { return m_head.load(std::memory_order_relaxed) - m_cached_tail; }
+
+    // 生产者和消费者都可调用, 并发下只是近似值
+    [[nodiscard]] auto
+    used_bytes()
+    const noexcept -> std::size_t {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] static constexpr auto
+    capacity() noexcept -> std::size_t { return Capacity; }
+private:
+    struct alignas(8) Storage {
+        std::byte data[8];
+    };
+
+    struct Header {
+        std::uint32_t size;
+        std::uint32_t reserved;
+    };
+    static_assert(sizeof(Header) == 8);
+
+    static constexpr std::size_t   mask        = Capacity - 1;
+    static constexpr std::uint32_t wrap_marker = std::numeric_limits<std::uint32_t>::max();
+
+    [[nodiscard]] static constexpr auto
+    record_size(std::size_t size) noexcept -> std::size_t { return sizeof(Header) + ((size + 7) & ~std::size_t{7}); }
+
+    auto at(std::size_t position) noexcept -> std::byte* {
+        return reinterpret_cast<std::byte*>(m_buffer.get()) + (position & mask);
+    }
+
+    std::unique_ptr<Storage[]> m_buffer;
+
+    // 消费者独占的缓存行
+    alignas(detail::cache_line_size) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_cached_head{0};
+
+    // 生产者独占的缓存行
+    alignas(detail::cache_line_size) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cached_tail{0};
+    // 已预留但未发布的位置 (含可能的回绕填充)
+    std::size_t m_reserved{0};
+};
+
+template <std::size_t Capacity>
+    requires (detail::is_power_of_two(Capacity) && Capacity >= 64)
+auto SpscByteRing<Capacity>::try_reserve(std::size_t size) noexcept -> std::byte* {
+    if (size == 0 || size > max_record_size) return nullptr;
+
+    const std::size_t head   = m_head.load(std::memory_order_relaxed);
+    const std::size_t needed = record_size(size);
+    // 本圈剩余空间不够时, 跳过剩余部分从下一圈开头写
+    const std::size_t to_end = Capacity - (head & mask);
+    const std::size_t skip   = to_end < needed ? to_end : 0;
+
+    if (head + skip + needed - m_cached_tail > Capacity) {
+        m_cached_tail = m_tail.load(std::memory_order_acquire);
+        if (head + skip + needed - m_cached_tail > Capacity) return nullptr;
+    }
+
+    if (skip != 0) {
+        Header marker{wrap_marker, 0};
+        std::memcpy(at(head), &marker, sizeof(marker));
+    }
+
+    Header header{static_cast<std::uint32_t>(size), 0};
+    std::memcpy(at(head + skip), &header, sizeof(header));
+    m_reserved = head + skip + needed;
+    return at(head + skip) + sizeof(Header);
+}
+
+template <std::size_t Capacity>
+    requires (detail::is_power_of_two(Capacity) && Capacity >= 64)
+void SpscByteRing<Capacity>::commit() noexcept {
+    m_head.store(m_reserved, std::memory_order_release);
+}
+
+template <std::size_t Capacity>
+    requires (detail::is_power_of_two(Capacity) && Capacity >= 64)
+auto SpscByteRing<Capacity>::front() noexcept -> std::span<const std::byte> {
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+
+    for (;;) {
+        if (tail == m_cached_head) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail == m_cached_head) return {};
+        }
+
+        Header header;
+        std::memcpy(&header, at(tail), sizeof(header));
+        if (header.size != wrap_marker) return {at(tail) + sizeof(Header), header.size};
+
+        // 跳过回绕填充; 填充与其后的记录一同发布, 不需要额外同步
+        tail += Capacity - (tail & mask);
+        m_tail.store(tail, std::memory_order_release);
+    }
+}
+
+template <std::size_t Capacity>
+    requires (detail::is_power_of_two(Capacity) && Capacity >= 64)
+auto SpscByteRing<Capacity>::published() noexcept -> std::size_t {
+    m_cached_head = m_head.load(std::memory_order_acquire);
+    return m_cached_head;
+}
+
+// 发布的位置总在记录边界上 (回绕填充与其后的记录一同发布), 因此消费位置会恰好停在 limit
+template <std::size_t Capacity>
+    requires (detail::is_power_of_two(Capacity) && Capacity >= 64)
+auto SpscByteRing<Capacity>::front(std::size_t limit) noexcept -> std::span<const std::byte> {
+    if (m_tail.load(std::memory_order_relaxed) == limit) return {};
+    return front();
+}
+
+template <std::size_t Capacity>
+    requires (detail::is_power_of_two(Capacity) && Capacity >= 64)
+void SpscByteRing<Capacity>::pop() noexcept {
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+
+    Header header;
+    std::memcpy(&header, at(tail), sizeof(header));
+    m_tail.store(tail + record_size(header.size), std::memory_order_release);
+}
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // BYTE_RING_HPP
@@ -0,0 +1,125 @@
+#ifndef CHASE_LEV_DEQUE_HPP
+#define CHASE_LEV_DEQUE_HPP
+
+#include <core/queue/detail/queue_utils.hpp>
+#include <bit>
+
+namespace labelimg::core::queue::detail {
+
+// Chase-Lev 工作窃取双端队列 (Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models")
+// 拥有者在 bottom 端 push / pop (LIFO), 其他线程在 top 端 steal (FIFO)
+// T 必须是可平凡复制且能放进 std::atomic 的类型 (如指针)
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class ChaseLevDeque: private NonCopyable {
+public:
+    explicit ChaseLevDeque(std::size_t initial_capacity = 256)
+        : m_array{new Array(std::bit_ceil(std::max<std::size_t>(initial_capacity, 2)))} {
+        m_retired.emplace_back(m_array.load(std::memory_order_relaxed));
+    }
+
+    ~ChaseLevDeque() = default;
+
+    // 仅拥有者线程调用
+    void push(T value) {
+        std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        std::int64_t top    = m_top.load(std::memory_order_acquire);
+        Array* array        = m_array.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<std::int64_t>(array->capacity) - 1)
+            array = grow(array, top, bottom);
+
+        array->put(bottom, value);
+        // 以 release 写 bottom 发布槽位 (等价于 release fence + relaxed store)
+        m_bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    // 仅拥有者线程调用
+    auto pop() -> std::optional<T> {
+        std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Array* array        = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        T value = array->get(bottom);
+        if (top == bottom) {
+            // 最后一个元素, 与窃取者竞争
+            bool won = m_top.compare_exchange_strong(top, top + 1,
+                                                     std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            if (!won) return std::nullopt;
+        }
+        return value;
+    }
+
+    // 任意线程调用
+    auto steal() -> std::optional<T> {
+        std::int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom) return std::nullopt;
+
+        Array* array = m_array.load(std::memory_order_acquire);
+        T value = array->get(top);
+        if (!m_top.compare_exchange_strong(top, top + 1,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed))
+            return std::nullopt;
+        return value;
+    }
+
+    [[nodiscard]] auto
+    size()
+    const noexcept -> std::size_t {
+        std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        std::int64_t top    = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    [[nodiscard]] auto
+    empty()
+    const noexcept -> bool { return size() == 0; }
+private:
+    struct Array {
+        std::size_t capacity;
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+
+        explicit Array(std::size_t cap)
+            : capacity{cap}, mask{cap - 1}, slots{std::make_unique<std::atomic<T>[]>(cap)} {}
+
+        void put(std::int64_t index, T value) noexcept {
+            slots[static_cast<std::size_t>(index) & mask].store(value, std::memory_order_relaxed);
+        }
+
+        auto get(std::int64_t index) const noexcept -> T {
+            return slots[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+    };
+
+    // 扩容时旧数组可能仍被窃取者读取, 因此保留到析构时再释放
+    auto grow(Array* old, std::int64_t top, std::int64_t bottom) -> Array* {
+        auto* array = new Array(old->capacity * 2);
+        for (std::int64_t i = top; i < bottom; ++i) array->put(i, old->get(i));
+        m_retired.emplace_back(array);
+        m_array.store(array, std::memory_order_release);
+        return array;
+    }
+
+    alignas(cache_line_size) std::atomic<std::int64_t> m_top{0};
+    alignas(cache_line_size) std::atomic<std::int64_t> m_bottom{0};
+    alignas(cache_line_size) std::atomic<Array*> m_array;
+    std::vector<std::unique_ptr<Array>> m_retired;
+};
+
+} // namespace labelimg::core::queue::detail
+
+#endif // CHASE_LEV_DEQUE_HPP
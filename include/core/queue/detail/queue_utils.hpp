@@ -0,0 +1,99 @@
+#ifndef QUEUE_UTILS_HPP
+#define QUEUE_UTILS_HPP
+
+#include <pch.h>
+#include <mutex>
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386) || defined (_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace labelimg::core::queue::detail {
+
+// 不直接使用 std::hardware_destructive_interference_size, 避免 ABI 不一致的告警
+inline constexpr std::size_t cache_line_size = 64;
+
+[[nodiscard]] constexpr auto 
+is_power_of_two(std::size_t value) 
+noexcept -> bool {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+// 自旋等待时提示 CPU 降低流水线压力
+inline void cpu_relax() noexcept {
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386) || defined (_M_IX86)
+    _mm_pause();
+#elif defined (__aarch64__) || defined (_M_ARM64)
+    __asm__ volatile ("yield" ::: "memory");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// 指数退避: 先自旋, 再让出时间片, 最后短暂休眠
+class Backoff {
+public:
+    void pause() noexcept {
+        if (m_step < spin_limit) {
+            for (std::uint32_t i = 0; i < (1U << m_step); ++i) cpu_relax();
+        } else if (m_step < yield_limit) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        if (m_step < yield_limit) ++m_step;
+    }
+
+    void reset() noexcept { m_step = 0; }
+
+    [[nodiscard]] auto 
+    is_sleeping() 
+    const noexcept -> bool { return m_step >= yield_limit; }
+private:
+    static constexpr std::uint32_t spin_limit  = 6;
+    static constexpr std::uint32_t yield_limit = 10;
+
+    std::uint32_t m_step = 0;
+};
+
+// 元素类型声明 counts_lock_contention 时 (Instrumented<> 内部的带时间戳元素), 加锁策略统计锁竞争
+// 统计与否由模板实参决定, 不同编译选项的翻译单元不会得到布局不同的同一个类
+template <typename T>
+inline constexpr bool counts_lock_contention = requires { requires T::counts_lock_contention; };
+
+// 加锁并统计锁竞争次数 (先 try_lock, 失败才计数后阻塞)
+// Enabled 为 false 时退化为普通加锁, 是空类型
+template <bool Enabled>
+class LockCounter {
+public:
+    [[nodiscard]] auto
+    lock(std::mutex& mutex) -> std::unique_lock<std::mutex> {
+        std::unique_lock<std::mutex> lock{mutex, std::try_to_lock};
+        if (!lock.owns_lock()) {
+            m_contended.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
+        }
+        return lock;
+    }
+
+    [[nodiscard]] auto
+    contended()
+    const noexcept -> std::size_t { return m_contended.load(std::memory_order_relaxed); }
+private:
+    std::atomic<std::size_t> m_contended{0};
+};
+
+template <>
+class LockCounter<false> {
+public:
+    [[nodiscard]] auto
+    lock(std::mutex& mutex) -> std::unique_lock<std::mutex> { return std::unique_lock<std::mutex>{mutex}; }
+
+    [[nodiscard]] constexpr auto
+    contended()
+    const noexcept -> std::size_t { return 0; }
+};
+
+} // namespace labelimg::core::queue::detail
+
+#endif // QUEUE_UTILS_HPP
@@ -0,0 +1,213 @@
+#ifndef FRAME_ALLOCATOR_HPP
+#define FRAME_ALLOCATOR_HPP
+
+#include <pch.h>
+#include <bit>
+#include <mutex>
+
+namespace labelimg::core::queue {
+inline namespace v2 {
+
+struct FrameAllocatorStats {
+    std::size_t hits{0};              // 从空闲链表取得
+    std::size_t misses{0};            // 链表为空, 向全局堆申请
+    std::size_t oversized{0};         // 超过最大尺寸类别, 直接走全局堆
+    std::size_t peak_pooled_bytes{0}; // 各线程空闲链表峰值之和
+
+    [[nodiscard]] auto
+    hit_rate()
+    const noexcept -> double {
+        std::size_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+// 协程帧分配器
+//  - 按 2 的幂划分尺寸类别 (64B ~ 4KB), 每个线程各自维护空闲链表, 分配 / 释放不加锁
+//  - 在 A 线程创建, 在 B 线程结束的帧会进入 B 的链表; 每个链表有长度上限, 超出部分还给全局堆
+//  - 所有块都以类别尺寸从全局堆申请, 因此任意线程都可以把它还给全局堆
+class FrameAllocator {
+public:
+    static constexpr std::size_t min_class_size = 64;
+    static constexpr std::size_t max_class_size = 4096;
+    static constexpr std::size_t class_count    = 7;
+    static constexpr std::size_t max_cached_per_class = 256;
+
+    static auto allocate(std::size_t size) -> void*;
+    static void deallocate(void* ptr, std::size_t size) noexcept;
+
+    // 所有线程 (含已退出线程) 的累计统计
+    [[nodiscard]] static auto stats() -> FrameAllocatorStats;
+    // 仅当前线程
+    [[nodiscard]] static auto thread_stats() -> FrameAllocatorStats;
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct ThreadCache;
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<ThreadCache*> caches;
+        FrameAllocatorStats retired;
+    };
+
+    static auto class_index(std::size_t size) noexcept -> std::size_t {
+        std::size_t rounded = std::bit_ceil(std::max(size, min_class_size));
+        return static_cast<std::size_t>(std::countr_zero(rounded) - std::countr_zero(min_class_size));
+    }
+
+    static constexpr auto class_size(std::size_t index) noexcept -> std::size_t {
+        return min_class_size << index;
+    }
+
+    static auto registry() -> Registry& {
+        static Registry instance;
+        return instance;
+    }
+
+    static auto thread_cache() noexcept -> ThreadCache*;
+    static auto init_thread_cache() noexcept -> ThreadCache*;
+
+    // 快路径只读这个可平凡析构的指针, 避免每次访问 thread_local 对象的初始化检查
+    static inline thread_local ThreadCache* t_cache = nullptr;
+    static inline thread_local bool t_cache_destroyed = false;
+};
+
+struct FrameAllocator::ThreadCache {
+    std::array<FreeBlock*, class_count> heads{};
+    std::array<std::size_t, class_count> counts{};
+    std::size_t pooled_bytes{0};
+
+    // 只由所属线程写入, stats() 从其他线程读取
+    std::atomic<std::size_t> hits{0};
+    std::atomic<std::size_t> misses{0};
+    std::atomic<std::size_t> oversized{0};
+    std::atomic<std::size_t> peak_pooled_bytes{0};
+
+    ThreadCache() {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock{reg.mutex};
+        reg.caches.push_back(this);
+    }
+
+    ~ThreadCache() {
+        for (std::size_t i = 0; i < class_count; ++i) {
+            while (heads[i] != nullptr) {
+                FreeBlock* block = std::exchange(heads[i], heads[i]->next);
+                ::operator delete(block, class_size(i));
+            }
+        }
+
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock{reg.mutex};
+        std::erase(reg.caches, this);
+        reg.retired.hits              += hits.load(std::memory_order_relaxed);
+        reg.retired.misses            += misses.load(std::memory_order_relaxed);
+        reg.retired.oversized         += oversized.load(std::memory_order_relaxed);
+        reg.retired.peak_pooled_bytes += peak_pooled_bytes.load(std::memory_order_relaxed);
+    }
+
+    static void bump(std::atomic<std::size_t>& counter) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    auto snapshot() const noexcept -> FrameAllocatorStats {
+        return FrameAllocatorStats{
+            .hits              = hits.load(std::memory_order_relaxed),
+            .misses            = misses.load(std::memory_order_relaxed),
+            .oversized         = oversized.load(std::memory_order_relaxed),
+            .peak_pooled_bytes = peak_pooled_bytes.load(std::memory_order_relaxed),
+        };
+    }
+};
+
+inline auto FrameAllocator::thread_cache() noexcept -> ThreadCache* {
+    if (t_cache != nullptr) [[likely]] return t_cache;
+    return init_thread_cache();
+}
+
+inline auto FrameAllocator::init_thread_cache() noexcept -> ThreadCache* {
+    // 线程退出时 cache 可能先于其他 thread_local 对象析构, 之后释放的帧直接还给全局堆
+    if (t_cache_destroyed) return nullptr;
+    // 注册 cache 需要分配内存; 失败时本次不使用 cache (同样直接走全局堆), 下次调用再重试初始化
+    try {
+        thread_local struct Holder {
+            ThreadCache cache;
+            Holder()  { t_cache = &cache; }
+            ~Holder() { t_cache = nullptr; t_cache_destroyed = true; }
+        } holder;
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+    return t_cache;
+}
+
+inline auto FrameAllocator::allocate(std::size_t size) -> void* {
+    if (size > max_class_size) {
+        if (auto* cache = thread_cache()) ThreadCache::bump(cache->oversized);
+        return ::operator new(size);
+    }
+
+    std::size_t index = class_index(size);
+    ThreadCache* cache = thread_cache();
+    if (cache == nullptr) return ::operator new(class_size(index));
+
+    if (FreeBlock* block = cache->heads[index]) {
+        cache->heads[index] = block->next;
+        --cache->counts[index];
+        cache->pooled_bytes -= class_size(index);
+        ThreadCache::bump(cache->hits);
+        return block;
+    }
+
+    ThreadCache::bump(cache->misses);
+    return ::operator new(class_size(index));
+}
+
+inline void FrameAllocator::deallocate(void* ptr, std::size_t size) noexcept {
+    if (ptr == nullptr) return;
+    if (size > max_class_size) {
+        ::operator delete(ptr, size);
+        return;
+    }
+
+    std::size_t index = class_index(size);
+    ThreadCache* cache = thread_cache();
+    if (cache == nullptr || cache->counts[index] >= max_cached_per_class) {
+        ::operator delete(ptr, class_size(index));
+        return;
+    }
+
+    auto* block = ::new (ptr) FreeBlock{cache->heads[index]};
+    cache->heads[index] = block;
+    ++cache->counts[index];
+    cache->pooled_bytes += class_size(index);
+    if (cache->pooled_bytes > cache->peak_pooled_bytes.load(std::memory_order_relaxed))
+        cache->peak_pooled_bytes.store(cache->pooled_bytes, std::memory_order_relaxed);
+}
+
+inline auto FrameAllocator::stats() -> FrameAllocatorStats {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock{reg.mutex};
+    FrameAllocatorStats total = reg.retired;
+    for (const ThreadCache* cache: reg.caches) {
+        auto s = cache->snapshot();
+        total.hits              += s.hits;
+        total.misses            += s.misses;
+        total.oversized         += s.oversized;
+        total.peak_pooled_bytes += s.peak_pooled_bytes;
+    }
+    return total;
+}
+
+inline auto FrameAllocator::thread_stats() -> FrameAllocatorStats {
+    ThreadCache* cache = thread_cache();
+    return cache != nullptr ? cache->snapshot() : FrameAllocatorStats{};
+}
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // FRAME_ALLOCATOR_HPP
@@ -0,0 +1,322 @@
+#ifndef INSTRUMENTED_QUEUE_HPP
+#define INSTRUMENTED_QUEUE_HPP
+
+#include <core/message_queue.hpp>
+#include <core/asm/hp_timer.hpp>
+#include <bit>
+
+namespace labelimg::core::queue {
+inline namespace v2 {
+
+// 队列运行状态快照, 供日志或诊断面板输出
+struct QueueStats {
+    // 延迟直方图按 2 的幂划分: 第 i 个桶统计 [2^(i-1), 2^i) 个 CPU 周期的样本
+    static constexpr std::size_t latency_buckets = 48;
+
+    std::size_t depth{0};
+    std::size_t high_water{0};
+    std::size_t pushes{0};
+    std::size_t pops{0};
+    std::size_t contended{0};       // 加锁时发生竞争的次数 (无锁策略恒为 0)
+    double push_rate{0.0};          // 次 / 秒, 自创建或上次 reset 起
+    double pop_rate{0.0};
+
+    std::array<std::uint64_t, latency_buckets> latency_histogram{};
+    double latency_p50_ns{0.0};     // 取所在桶的上界, 为保守估计
+    double latency_p99_ns{0.0};
+    double latency_p999_ns{0.0};
+    double latency_max_ns{0.0};
+
+    [[nodiscard]] auto
+    to_string()
+    const -> std::string {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1)
+            << "depth="       << depth
+            << " high_water=" << high_water
+            << " pushes="     << pushes
+            << " pops="       << pops
+            << " push/s="     << push_rate
+            << " pop/s="      << pop_rate
+            << " contended="  << contended
+            << " latency_ns{p50=" << latency_p50_ns
+            << " p99="        << latency_p99_ns
+            << " p999="       << latency_p999_ns
+            << " max="        << latency_max_ns << "}";
+        return oss.str();
+    }
+};
+
+inline auto operator<<(std::ostream& os, const QueueStats& stats) -> std::ostream& {
+    return os << stats.to_string();
+}
+
+// 可叠加在任意并发策略上的统计层:
+//     MessageQueue<Job, Instrumented<MutexPolicy>> queue;
+//     ...
+//     logger << queue.snapshot();
+//
+// 开关是类型的一部分: Instrumented<P, false> 就是 MessageQueue<T, P>, snapshot() 返回空快照,
+// 可以用 constexpr 配置统一选择, 例如 Instrumented<P, config::queue_stats>
+template <IsTagPolicy Policy, bool Enabled = true>
+struct Instrumented {};
+
+// 入队时打上时间戳的元素; 底层加锁策略见到它时统计锁竞争
+template <typename T>
+struct Stamped {
+    static constexpr bool counts_lock_contention = true;
+
+    T value;
+    asm_::HighPrecisionTimer::cycle_count_t enqueued_at{0};
+};
+
+template <typename T, typename Policy>
+class MessageQueue<T, Instrumented<Policy, true>>: public Queue<MessageQueue<T, Instrumented<Policy, true>>, T>
+                                                 , private NonCopyable {
+public:
+    using Inner = MessageQueue<Stamped<T>, Policy>;
+    using Queue<MessageQueue<T, Instrumented<Policy, true>>, T>::push;
+
+    template <typename... Args>
+    explicit MessageQueue(Args&&... args)
+        : m_inner(std::forward<Args>(args)...)
+        , m_origin{std::chrono::steady_clock::now(), Timer::cycles()}
+        , m_since{m_origin.time} {}
+    ~MessageQueue() = default;
+
+    // 转发策略特有的入队参数, 如 PriorityPolicy 的通道
+    template <typename Arg, typename... Args>
+        requires requires (Inner& q, Stamped<T> s, Arg&& a, Args&&... as) {
+            q.push(std::move(s), std::forward<Arg>(a), std::forward<Args>(as)...);
+        }
+    auto push(T value, Arg&& arg, Args&&... args) -> decltype(auto) {
+        on_push();
+        return m_inner.push(stamp(std::move(value)), std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+        requires requires (Inner& q, Stamped<T>&& s) { { q.try_push(std::move(s)) } -> std::same_as<bool>; }
+    auto try_push(U&& value) -> bool;
+
+    void wait_and_pop(T&) requires requires (Inner& q, Stamped<T>& s) { q.wait_and_pop(s); };
+    auto try_pop(T&) -> bool requires requires (Inner& q, Stamped<T>& s) { q.try_pop(s); };
+    auto wait_for_pop(T&, std::chrono::milliseconds timeout) -> bool
+        requires requires (Inner& q, Stamped<T>& s, std::chrono::milliseconds t) { q.wait_for_pop(s, t); };
+
+    [[nodiscard]] auto snapshot() const -> QueueStats;
+    // 清零计数与直方图 (深度与高水位保留当前深度)
+    void reset();
+
+    // 访问底层队列以使用策略特有的接口 (如 reprioritize); 绕过统计
+    [[nodiscard]] auto inner() noexcept -> Inner& { return m_inner; }
+
+    void push_impl(T);
+    void pop_impl();
+    auto front_impl() -> T&;
+    [[nodiscard]] auto empty_impl() const -> bool { return m_inner.empty(); }
+    [[nodiscard]] auto size_impl()  const -> size_t { return m_inner.size(); }
+private:
+    using Timer = asm_::HighPrecisionTimer;
+
+    static auto stamp(T&& value) -> Stamped<T> {
+        return Stamped<T>{std::move(value), Timer::cycles()};
+    }
+
+    void on_push() noexcept;
+    void on_pop(const Stamped<T>& item) noexcept;
+    // 有界策略丢弃 / 溢出的元素不会出队, 计算深度时需要扣除
+    [[nodiscard]] auto lost() const noexcept -> std::int64_t;
+    // 用创建以来经过的墙钟与周期数换算频率, 不需要单独休眠校准
+    [[nodiscard]] auto cycles_per_ns() const noexcept -> double;
+
+    Inner m_inner;
+
+    alignas(detail::cache_line_size) std::atomic<std::int64_t> m_depth{0};
+    std::atomic<std::size_t> m_high_water{0};
+    std::atomic<std::size_t> m_pushes{0};
+    alignas(detail::cache_line_size) std::atomic<std::size_t> m_pops{0};
+    std::array<std::atomic<std::uint64_t>, QueueStats::latency_buckets> m_latency{};
+    std::atomic<std::uint64_t> m_latency_max{0};
+
+    struct Origin {
+        std::chrono::steady_clock::time_point time;
+        Timer::cycle_count_t cycles;
+    };
+    const Origin m_origin;
+    std::atomic<std::chrono::steady_clock::time_point> m_since;
+};
+
+template <typename T, typename Policy>
+auto MessageQueue<T, Instrumented<Policy, true>>::lost() const noexcept -> std::int64_t {
+    std::size_t lost = 0;
+    if constexpr (requires (const Inner& q) { q.dropped_count(); q.spilled_count(); })
+        lost = m_inner.dropped_count() + m_inner.spilled_count();
+    return static_cast<std::int64_t>(lost);
+}
+
+template <typename T, typename Policy>
+auto MessageQueue<T, Instrumented<Policy, true>>::cycles_per_ns() const noexcept -> double {
+    const auto cycles = Timer::cycles() - m_origin.cycles;
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - m_origin.time);
+    return elapsed.count() > 0.0 ? static_cast<double>(cycles) / elapsed.count() : 0.0;
+}
+
+template <typename T, typename Policy>
+void MessageQueue<T, Instrumented<Policy, true>>::on_push() noexcept {
+    m_pushes.fetch_add(1, std::memory_order_relaxed);
+    // 先计入深度再入队, 保证出队方减深度时不会出现负数
+    std::int64_t pending = m_depth.fetch_add(1, std::memory_order_relaxed) + 1 - lost();
+    auto depth = static_cast<std::size_t>(std::max<std::int64_t>(pending, 0));
+    std::size_t high = m_high_water.load(std::memory_order_relaxed);
+    while (depth > high && !m_high_water.compare_exchange_weak(high, depth, std::memory_order_relaxed)) {}
+}
+
+template <typename T, typename Policy>
+void MessageQueue<T, Instrumented<Policy, true>>::on_pop(const Stamped<T>& item) noexcept {
+    m_pops.fetch_add(1, std::memory_order_relaxed);
+    m_depth.fetch_sub(1, std::memory_order_relaxed);
+
+    Timer::cycle_count_t now = Timer::cycles();
+    std::uint64_t elapsed = now > item.enqueued_at ? now - item.enqueued_at : 0;
+    auto bucket = std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(elapsed)),
+                                        QueueStats::latency_buckets - 1);
+    m_latency[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    std::uint64_t max = m_latency_max.load(std::memory_order_relaxed);
+    while (elapsed > max && !m_latency_max.compare_exchange_weak(max, elapsed, std::memory_order_relaxed)) {}
+}
+
+template <typename T, typename Policy>
+void MessageQueue<T, Instrumented<Policy, true>>::push_impl(T value) {
+    on_push();
+    m_inner.push(stamp(std::move(value)));
+}
+
+template <typename T, typename Policy>
+template <typename U>
+    requires requires (MessageQueue<Stamped<T>, Policy>& q, Stamped<T>&& s) { { q.try_push(std::move(s)) } -> std::same_as<bool>; }
+auto MessageQueue<T, Instrumented<Policy, true>>::try_push(U&& value) -> bool {
+    on_push();
+    Stamped<T> item{T(std::forward<U>(value)), Timer::cycles()};
+    if (m_inner.try_push(std::move(item))) return true;
+
+    // 入队失败: 撤销计数, 并把元素还给调用方 (底层 try_push 失败时不会移动)
+    m_pushes.fetch_sub(1, std::memory_order_relaxed);
+    m_depth.fetch_sub(1, std::memory_order_relaxed);
+    if constexpr (!std::is_const_v<std::remove_reference_t<U>> && std::is_assignable_v<U&, T&&>)
+        value = std::move(item.value);
+    return false;
+}
+
+template <typename T, typename Policy>
+void MessageQueue<T, Instrumented<Policy, true>>::wait_and_pop(T& value)
+    requires requires (MessageQueue<Stamped<T>, Policy>& q, Stamped<T>& s) { q.wait_and_pop(s); } {
+    Stamped<T> item;
+    m_inner.wait_and_pop(item);
+    on_pop(item);
+    value = std::move(item.value);
+}
+
+template <typename T, typename Policy>
+auto MessageQueue<T, Instrumented<Policy, true>>::try_pop(T& value) -> bool
+    requires requires (MessageQueue<Stamped<T>, Policy>& q, Stamped<T>& s) { q.try_pop(s); } {
+    Stamped<T> item;
+    if (!m_inner.try_pop(item)) return false;
+    on_pop(item);
+    value = std::move(item.value);
+    return true;
+}
+
+template <typename T, typename Policy>
+auto MessageQueue<T, Instrumented<Policy, true>>::wait_for_pop(T& value, std::chrono::milliseconds timeout) -> bool
+    requires requires (MessageQueue<Stamped<T>, Policy>& q, Stamped<T>& s, std::chrono::milliseconds t) { q.wait_for_pop(s, t); } {
+    Stamped<T> item;
+    if (!m_inner.wait_for_pop(item, timeout)) return false;
+    on_pop(item);
+    value = std::move(item.value);
+    return true;
+}
+
+template <typename T, typename Policy>
+void MessageQueue<T, Instrumented<Policy, true>>::pop_impl() {
+    if (m_inner.empty()) return;
+    on_pop(m_inner.front());
+    m_inner.pop();
+}
+
+template <typename T, typename Policy>
+auto MessageQueue<T, Instrumented<Policy, true>>::front_impl() -> T& {
+    return m_inner.front().value;
+}
+
+template <typename T, typename Policy>
+auto MessageQueue<T, Instrumented<Policy, true>>::snapshot() const -> QueueStats {
+    const double cycles_per_ns = this->cycles_per_ns();
+    auto to_ns = [cycles_per_ns](double cycles) {
+        return cycles_per_ns > 0.0 ? cycles / cycles_per_ns : cycles;
+    };
+
+    QueueStats stats;
+    stats.depth      = m_inner.size();
+    stats.high_water = std::max(m_high_water.load(std::memory_order_relaxed), stats.depth);
+    stats.pushes     = m_pushes.load(std::memory_order_relaxed);
+    stats.pops       = m_pops.load(std::memory_order_relaxed);
+    if constexpr (requires (const Inner& q) { q.contended_count(); })
+        stats.contended = m_inner.contended_count();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_since.load(std::memory_order_relaxed);
+    if (elapsed.count() > 0.0) {
+        stats.push_rate = static_cast<double>(stats.pushes) / elapsed.count();
+        stats.pop_rate  = static_cast<double>(stats.pops)   / elapsed.count();
+    }
+
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < QueueStats::latency_buckets; ++i) {
+        stats.latency_histogram[i] = m_latency[i].load(std::memory_order_relaxed);
+        total += stats.latency_histogram[i];
+    }
+
+    auto percentile = [&](double q) -> double {
+        if (total == 0) return 0.0;
+        auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total)));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < QueueStats::latency_buckets; ++i) {
+            seen += stats.latency_histogram[i];
+            if (seen >= rank) return to_ns(std::ldexp(1.0, static_cast<int>(i)));
+        }
+        return to_ns(std::ldexp(1.0, static_cast<int>(QueueStats::latency_buckets)));
+    };
+
+    stats.latency_p50_ns  = percentile(0.50);
+    stats.latency_p99_ns  = percentile(0.99);
+    stats.latency_p999_ns = percentile(0.999);
+    stats.latency_max_ns  = to_ns(static_cast<double>(m_latency_max.load(std::memory_order_relaxed)));
+    return stats;
+}
+
+template <typename T, typename Policy>
+void MessageQueue<T, Instrumented<Policy, true>>::reset() {
+    m_pushes.store(0, std::memory_order_relaxed);
+    m_pops.store(0, std::memory_order_relaxed);
+    m_high_water.store(m_inner.size(), std::memory_order_relaxed);
+    for (auto& bucket: m_latency) bucket.store(0, std::memory_order_relaxed);
+    m_latency_max.store(0, std::memory_order_relaxed);
+    m_since.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
+}
+
+// 统计关闭: 直接复用底层策略, 没有任何额外开销
+template <typename T, typename Policy>
+class MessageQueue<T, Instrumented<Policy, false>>: public MessageQueue<T, Policy> {
+public:
+    using MessageQueue<T, Policy>::MessageQueue;
+
+    [[nodiscard]] auto snapshot() const -> QueueStats { return {}; }
+    void reset() {}
+
+    [[nodiscard]] auto inner() noexcept -> MessageQueue<T, Policy>& { return *this; }
+};
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // INSTRUMENTED_QUEUE_HPP
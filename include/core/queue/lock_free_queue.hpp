@@ -0,0 +1,192 @@
+#ifndef LOCK_FREE_QUEUE_HPP
+#define LOCK_FREE_QUEUE_HPP
+
+#include <core/message_queue.hpp>
+#include <core/queue/detail/queue_utils.hpp>
+
+namespace labelimg::core::queue {
+inline namespace v2 {
+
+// 有界多生产者多消费者无锁队列 (Vyukov MPMC ring)
+// 容量必须为 2 的幂, 每个槽位通过序号区分 "可写" / "可读" 状态
+// 默认 SpinWait: 生产者没有任何唤醒开销, 适合消费者常驻忙碌的场景
+template <std::size_t Capacity = 1024, WaitStrategy Wait = SpinWait>
+    requires (detail::is_power_of_two(Capacity))
+struct LockFreePolicy {};
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+class MessageQueue<T, LockFreePolicy<Capacity, Wait>>: public Queue<MessageQueue<T, LockFreePolicy<Capacity, Wait>>, T>
+                                               , private NonCopyable {
+public:
+    MessageQueue();
+    ~MessageQueue();
+
+    void wait_and_pop(T&);
+    auto try_pop(T&) -> bool;
+    auto wait_for_pop(T&, std::chrono::milliseconds timeout) -> bool;
+
+    // 队列已满时返回 false, 此时 value 不会被移动
+    template <typename U>
+    auto try_push(U&& value) -> bool;
+
+    // 队列已满时按 Wait 策略阻塞直到有空位
+    void push_impl(T);
+    // front / pop 仅在单消费者场景下有意义
+    void pop_impl();
+    auto front_impl() -> T&;
+    [[nodiscard]] auto empty_impl() const -> bool;
+    [[nodiscard]] auto size_impl()  const -> size_t;
+
+    [[nodiscard]] static constexpr auto
+    capacity() noexcept -> size_t { return Capacity; }
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+
+        auto value() noexcept -> T* { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    static constexpr size_t mask = Capacity - 1;
+
+    // 获取可写槽位, 失败 (已满) 返回 nullptr
+    auto acquire_write_slot() noexcept -> Slot*;
+    // 获取可读槽位, 失败 (为空) 返回 nullptr
+    auto acquire_read_slot(size_t& pos) noexcept -> Slot*;
+
+    std::unique_ptr<Slot[]> m_slots;
+
+    alignas(detail::cache_line_size) std::atomic<size_t> m_head{0};
+    alignas(detail::cache_line_size) std::atomic<size_t> m_tail{0};
+
+    [[no_unique_address]] detail::Waiter<Wait> m_not_empty;
+    [[no_unique_address]] detail::Waiter<Wait> m_not_full;
+};
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+MessageQueue<T, LockFreePolicy<Capacity, Wait>>::MessageQueue()
+    : m_slots{std::make_unique<Slot[]>(Capacity)} {
+    for (size_t i = 0; i < Capacity; ++i)
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+MessageQueue<T, LockFreePolicy<Capacity, Wait>>::~MessageQueue() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        while (!empty_impl()) pop_impl();
+    }
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, LockFreePolicy<Capacity, Wait>>::acquire_write_slot() noexcept -> Slot* {
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = m_slots[pos & mask];
+        size_t seq = slot.sequence.load(std::memory_order_acquire);
+        auto diff  = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+        if (diff == 0) {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return &slot;
+        } else if (diff < 0) {
+            return nullptr;
+        } else {
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, LockFreePolicy<Capacity, Wait>>::acquire_read_slot(size_t& pos) noexcept -> Slot* {
+    pos = m_head.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = m_slots[pos & mask];
+        size_t seq = slot.sequence.load(std::memory_order_acquire);
+        auto diff  = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+        if (diff == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return &slot;
+        } else if (diff < 0) {
+            return nullptr;
+        } else {
+            pos = m_head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+template <typename U>
+auto MessageQueue<T, LockFreePolicy<Capacity, Wait>>::try_push(U&& value) -> bool {
+    Slot* slot = acquire_write_slot();
+    if (!slot) return false;
+
+    size_t pos = slot->sequence.load(std::memory_order_relaxed);
+    ::new (static_cast<void*>(slot->storage)) T(std::forward<U>(value));
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    m_not_empty.notify_one();
+    return true;
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+void MessageQueue<T, LockFreePolicy<Capacity, Wait>>::push_impl(T value) {
+    m_not_full.wait([&] { return try_push(std::move(value)); });
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, LockFreePolicy<Capacity, Wait>>::try_pop(T& value) -> bool {
+    size_t pos = 0;
+    Slot* slot = acquire_read_slot(pos);
+    if (!slot) return false;
+
+    value = std::move(*slot->value());
+    slot->value()->~T();
+    slot->sequence.store(pos + mask + 1, std::memory_order_release);
+    m_not_full.notify_one();
+    return true;
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+void MessageQueue<T, LockFreePolicy<Capacity, Wait>>::wait_and_pop(T& value) {
+    m_not_empty.wait([&] { return try_pop(value); });
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, LockFreePolicy<Capacity, Wait>>::wait_for_pop(T& value, std::chrono::milliseconds timeout) -> bool {
+    return m_not_empty.wait_for(timeout, [&] { return try_pop(value); });
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+void MessageQueue<T, LockFreePolicy<Capacity, Wait>>::pop_impl() {
+    size_t pos = 0;
+    Slot* slot = acquire_read_slot(pos);
+    if (!slot) return;
+
+    slot->value()->~T();
+    slot->sequence.store(pos + mask + 1, std::memory_order_release);
+    m_not_full.notify_one();
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, LockFreePolicy<Capacity, Wait>>::front_impl() -> T& {
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    return *m_slots[pos & mask].value();
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, LockFreePolicy<Capacity, Wait>>::empty_impl() const -> bool {
+    return size_impl() == 0;
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, LockFreePolicy<Capacity, Wait>>::size_impl() const -> size_t {
+    // 并发下只是近似值
+    size_t head = m_head.load(std::memory_order_acquire);
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // LOCK_FREE_QUEUE_HPP
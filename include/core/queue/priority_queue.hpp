@@ -0,0 +1,286 @@
+#ifndef PRIORITY_QUEUE_HPP
+#define PRIORITY_QUEUE_HPP
+
+#include <core/message_queue.hpp>
+#include <bit>
+
+namespace labelimg::core::queue {
+inline namespace v2 {
+
+// 固定通道数的优先级队列, 通道 0 优先级最高
+//  - 非空通道记录在位图中, 出队用 countr_zero 取最高优先级通道, O(1)
+//  - 每次出队, 其余非空通道的 "被跳过次数" 加一; 达到 starvation_limit 的通道优先服务一次,
+//    保证后台通道在前台饱和时仍按 1 / (limit + 1) 的比例前进
+//  - push 返回 Ticket, 元素仍在队列中时可通过 reprioritize 移到其他通道
+//
+// 用法:
+//     MessageQueue<Job, PriorityPolicy<>> queue;
+//     auto ticket = queue.push(prefetch_job, PriorityPolicy<>::lowest);
+//     ...
+//     queue.reprioritize(ticket, PriorityPolicy<>::highest);   // 用户点开了这张图
+template <std::size_t Lanes = 3, WaitStrategy Wait = CondVarWait>
+    requires (Lanes >= 1 && Lanes <= 32)
+struct PriorityPolicy {
+    static constexpr std::size_t lane_count = Lanes;
+    static constexpr std::size_t highest    = 0;
+    static constexpr std::size_t normal     = Lanes / 2;
+    static constexpr std::size_t lowest     = Lanes - 1;
+};
+
+// 指向已入队元素的句柄; 元素出队后句柄失效 (通过代数检测)
+struct PriorityTicket {
+    std::uint32_t index{std::numeric_limits<std::uint32_t>::max()};
+    std::uint32_t generation{0};
+};
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+class MessageQueue<T, PriorityPolicy<Lanes, Wait>>: public Queue<MessageQueue<T, PriorityPolicy<Lanes, Wait>>, T>
+                                            , private NonCopyable {
+public:
+    using Policy = PriorityPolicy<Lanes, Wait>;
+    using Ticket = PriorityTicket;
+    using Queue<MessageQueue<T, PriorityPolicy<Lanes, Wait>>, T>::push;
+
+    static constexpr std::size_t default_starvation_limit = 16;
+
+    explicit MessageQueue(std::size_t starvation_limit = default_starvation_limit)
+        : m_starvation_limit{std::max<std::size_t>(starvation_limit, 1)} {}
+    ~MessageQueue() = default;
+
+    // 放入指定通道末尾
+    auto push(T value, std::size_t lane) -> Ticket;
+
+    // 元素仍在队列中时移动到 lane 通道末尾; 元素已出队时返回 false
+    auto reprioritize(Ticket ticket, std::size_t lane) -> bool;
+
+    void wait_and_pop(T&);
+    auto try_pop(T&) -> bool;
+    auto wait_for_pop(T&, std::chrono::milliseconds timeout) -> bool;
+
+    [[nodiscard]] auto lane_size(std::size_t lane) const -> size_t;
+    // 加锁时发生竞争的次数, 仅在 Instrumented<> 内部统计
+    [[nodiscard]] auto contended_count() const noexcept -> size_t { return m_lock_counter.contended(); }
+
+    // CRTP 接口: push 放入 normal 通道, front / pop 与 try_pop 选择同一个元素
+    void push_impl(T);
+    void pop_impl();
+    auto front_impl() -> T&;
+    [[nodiscard]] auto empty_impl() const -> bool;
+    [[nodiscard]] auto size_impl()  const -> size_t;
+private:
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    struct Node {
+        std::optional<T> value;
+        std::uint32_t prev{npos};
+        std::uint32_t next{npos};
+        std::uint32_t generation{0};
+        std::uint32_t lane{0};
+    };
+
+    struct Lane {
+        std::uint32_t head{npos};
+        std::uint32_t tail{npos};
+        size_t size{0};
+        size_t bypassed{0};
+    };
+
+    [[nodiscard]] auto acquire_lock() const -> std::unique_lock<std::mutex> { return m_lock_counter.lock(m_mutex); }
+
+    auto enqueue_locked(T value, std::size_t lane) -> Ticket;
+    void link_back(std::uint32_t index, std::size_t lane) noexcept;
+    void unlink(std::uint32_t index) noexcept;
+    // 下一次出队的通道 (不修改计数)
+    [[nodiscard]] auto peek_lane() const noexcept -> std::size_t;
+    // 选出通道并更新各通道的被跳过次数
+    auto select_lane() noexcept -> std::size_t;
+    auto take_locked() -> T;
+
+    std::vector<Node> m_nodes;
+    std::uint32_t m_free{npos};
+    std::array<Lane, Lanes> m_lanes{};
+    std::uint32_t m_mask{0};
+    size_t m_size{0};
+    size_t m_starvation_limit;
+
+    mutable std::mutex m_mutex;
+    [[no_unique_address]] mutable detail::LockCounter<detail::counts_lock_contention<T>> m_lock_counter;
+    detail::Waiter<Wait> m_not_empty;
+};
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::enqueue_locked(T value, std::size_t lane) -> Ticket {
+    lane = std::min(lane, Policy::lowest);
+
+    std::uint32_t index = m_free;
+    if (index != npos) {
+        m_free = m_nodes[index].next;
+    } else {
+        index = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    m_nodes[index].value.emplace(std::move(value));
+    link_back(index, lane);
+    ++m_size;
+    return Ticket{index, m_nodes[index].generation};
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+void MessageQueue<T, PriorityPolicy<Lanes, Wait>>::link_back(std::uint32_t index, std::size_t lane) noexcept {
+    Node& node = m_nodes[index];
+    Lane& list = m_lanes[lane];
+
+    node.lane = static_cast<std::uint32_t>(lane);
+    node.prev = list.tail;
+    node.next = npos;
+    if (list.tail != npos) m_nodes[list.tail].next = index;
+    else list.head = index;
+    list.tail = index;
+
+    ++list.size;
+    m_mask |= std::uint32_t{1} << lane;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+void MessageQueue<T, PriorityPolicy<Lanes, Wait>>::unlink(std::uint32_t index) noexcept {
+    Node& node = m_nodes[index];
+    Lane& list = m_lanes[node.lane];
+
+    if (node.prev != npos) m_nodes[node.prev].next = node.next;
+    else list.head = node.next;
+    if (node.next != npos) m_nodes[node.next].prev = node.prev;
+    else list.tail = node.prev;
+
+    if (--list.size == 0) {
+        m_mask &= ~(std::uint32_t{1} << node.lane);
+        list.bypassed = 0;
+    }
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::peek_lane() const noexcept -> std::size_t {
+    auto chosen = static_cast<std::size_t>(std::countr_zero(m_mask));
+    // 通道数固定, 遍历非空通道是常数时间
+    for (std::uint32_t bits = m_mask & (m_mask - 1); bits != 0; bits &= bits - 1) {
+        auto lane = static_cast<std::size_t>(std::countr_zero(bits));
+        if (m_lanes[lane].bypassed >= m_starvation_limit) return lane;
+    }
+    return chosen;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::select_lane() noexcept -> std::size_t {
+    std::size_t chosen = peek_lane();
+    for (std::uint32_t bits = m_mask; bits != 0; bits &= bits - 1) {
+        auto lane = static_cast<std::size_t>(std::countr_zero(bits));
+        if (lane == chosen) m_lanes[lane].bypassed = 0;
+        else ++m_lanes[lane].bypassed;
+    }
+    return chosen;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::take_locked() -> T {
+    std::uint32_t index = m_lanes[select_lane()].head;
+    unlink(index);
+
+    Node& node = m_nodes[index];
+    T value = std::move(*node.value);
+    node.value.reset();
+    ++node.generation;
+    node.next = m_free;
+    m_free = index;
+    --m_size;
+    return value;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::push(T value, std::size_t lane) -> Ticket {
+    Ticket ticket;
+    {
+        auto lock = acquire_lock();
+        ticket = enqueue_locked(std::move(value), lane);
+    }
+    m_not_empty.notify_one();
+    return ticket;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+void MessageQueue<T, PriorityPolicy<Lanes, Wait>>::push_impl(T value) {
+    push(std::move(value), Policy::normal);
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::reprioritize(Ticket ticket, std::size_t lane) -> bool {
+    lane = std::min(lane, Policy::lowest);
+
+    auto lock = acquire_lock();
+    if (ticket.index >= m_nodes.size()) return false;
+
+    Node& node = m_nodes[ticket.index];
+    if (node.generation != ticket.generation || !node.value) return false;
+    if (node.lane == lane) return true;
+
+    unlink(ticket.index);
+    link_back(ticket.index, lane);
+    return true;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+void MessageQueue<T, PriorityPolicy<Lanes, Wait>>::wait_and_pop(T& value) {
+    auto lock = acquire_lock();
+    m_not_empty.wait(lock, [this] { return m_size != 0; });
+    value = take_locked();
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::try_pop(T& value) -> bool {
+    auto lock = acquire_lock();
+    if (m_size == 0) return false;
+    value = take_locked();
+    return true;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::wait_for_pop(T& value, std::chrono::milliseconds timeout) -> bool {
+    auto lock = acquire_lock();
+    if (!m_not_empty.wait_for(lock, timeout, [this] { return m_size != 0; })) return false;
+    value = take_locked();
+    return true;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::lane_size(std::size_t lane) const -> size_t {
+    auto lock = acquire_lock();
+    return lane < Lanes ? m_lanes[lane].size : 0;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+void MessageQueue<T, PriorityPolicy<Lanes, Wait>>::pop_impl() {
+    auto lock = acquire_lock();
+    if (m_size != 0) (void)take_locked();
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::front_impl() -> T& {
+    auto lock = acquire_lock();
+    return *m_nodes[m_lanes[peek_lane()].head].value;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::empty_impl() const -> bool {
+    auto lock = acquire_lock();
+    return m_size == 0;
+}
+
+template <typename T, std::size_t Lanes, WaitStrategy Wait>
+auto MessageQueue<T, PriorityPolicy<Lanes, Wait>>::size_impl() const -> size_t {
+    auto lock = acquire_lock();
+    return m_size;
+}
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // PRIORITY_QUEUE_HPP
@@ -0,0 +1,163 @@
+#ifndef SHARDED_QUEUE_HPP
+#define SHARDED_QUEUE_HPP
+
+#include <core/message_queue.hpp>
+#include <core/queue/detail/queue_utils.hpp>
+#include <core/queue/lock_free_queue.hpp>
+#include <core/queue/wait_strategy.hpp>
+
+namespace labelimg::core::queue {
+namespace detail {
+
+// 线程序号: 首次调用时按顺序分配, 用于把生产者均匀映射到分片 (比哈希线程 id 冲突更少)
+inline auto thread_slot() noexcept -> std::size_t {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+} // namespace detail
+
+inline namespace v2 {
+
+// 分片队列: 每个生产者线程固定写入一个分片 (独占缓存行的 MPMC 环), 消费者轮询各分片
+//  - 同一生产者的元素保持 FIFO, 不同生产者之间不保证全局顺序
+//  - 生产者之间只在映射到同一分片时竞争, 避免单一 tail 成为多核扩展瓶颈
+//  - 每个分片容量为 ShardCapacity, 某个分片满时该分片的生产者按 Wait 策略阻塞
+template <std::size_t Shards = 16, std::size_t ShardCapacity = 1024, WaitStrategy Wait = AtomicWait>
+    requires (Shards >= 1 && detail::is_power_of_two(ShardCapacity))
+struct ShardedPolicy {};
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+class MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>
+    : public Queue<MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>, T>
+    , private NonCopyable {
+public:
+    MessageQueue() = default;
+    ~MessageQueue() = default;
+
+    void wait_and_pop(T&);
+    auto try_pop(T&) -> bool;
+    auto wait_for_pop(T&, std::chrono::milliseconds timeout) -> bool;
+
+    // 写入当前线程的分片; 分片已满时返回 false, 此时 value 不会被移动
+    template <typename U>
+    auto try_push(U&& value) -> bool;
+
+    void push_impl(T);
+    // front / pop 仅在单消费者场景下有意义
+    void pop_impl();
+    auto front_impl() -> T&;
+    [[nodiscard]] auto empty_impl() const -> bool;
+    // 并发下只是近似值
+    [[nodiscard]] auto size_impl()  const -> size_t;
+
+    [[nodiscard]] static constexpr auto
+    shard_count() noexcept -> size_t { return Shards; }
+
+    [[nodiscard]] static constexpr auto
+    capacity() noexcept -> size_t { return Shards * ShardCapacity; }
+
+    // 当前线程作为生产者写入的分片
+    [[nodiscard]] static auto
+    producer_shard() noexcept -> size_t { return detail::thread_slot() % Shards; }
+private:
+    // 分片内部不等待, 阻塞统一由外层的等待器处理
+    struct alignas(detail::cache_line_size) Shard {
+        MessageQueue<T, LockFreePolicy<ShardCapacity, SpinWait>> queue;
+    };
+
+    // 从上次成功的分片开始轮询, 返回第一个非空分片
+    auto next_shard() noexcept -> Shard*;
+
+    std::array<Shard, Shards> m_shards;
+
+    [[no_unique_address]] detail::Waiter<Wait> m_not_empty;
+    [[no_unique_address]] detail::Waiter<Wait> m_not_full;
+
+    // 消费者的轮询起点, 每个线程独立, 初始值错开以分散消费者
+    static inline thread_local std::size_t t_cursor = detail::thread_slot();
+};
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+auto MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>::next_shard() noexcept -> Shard* {
+    for (std::size_t i = 0; i < Shards; ++i) {
+        std::size_t index = (t_cursor + i) % Shards;
+        if (!m_shards[index].queue.empty()) {
+            t_cursor = index;
+            return &m_shards[index];
+        }
+    }
+    return nullptr;
+}
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+template <typename U>
+auto MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>::try_push(U&& value) -> bool {
+    if (!m_shards[producer_shard()].queue.try_push(std::forward<U>(value))) return false;
+    m_not_empty.notify_one();
+    return true;
+}
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+void MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>::push_impl(T value) {
+    auto& shard = m_shards[producer_shard()].queue;
+    m_not_full.wait([&] { return shard.try_push(std::move(value)); });
+    m_not_empty.notify_one();
+}
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+auto MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>::try_pop(T& value) -> bool {
+    // 每个分片至少尝试一次; 从当前分片取到元素后下一次从下一个分片开始, 实现轮询
+    for (std::size_t i = 0; i < Shards; ++i) {
+        std::size_t index = (t_cursor + i) % Shards;
+        if (m_shards[index].queue.try_pop(value)) {
+            t_cursor = index + 1;
+            // 不知道被阻塞的生产者属于哪个分片, 有等待者时全部唤醒
+            m_not_full.notify_all();
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+void MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>::wait_and_pop(T& value) {
+    m_not_empty.wait([&] { return try_pop(value); });
+}
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+auto MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>::wait_for_pop(T& value, std::chrono::milliseconds timeout) -> bool {
+    return m_not_empty.wait_for(timeout, [&] { return try_pop(value); });
+}
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+void MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>::pop_impl() {
+    if (Shard* shard = next_shard()) {
+        shard->queue.pop();
+        m_not_full.notify_all();
+    }
+}
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+auto MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>::front_impl() -> T& {
+    Shard* shard = next_shard();
+    return shard ? shard->queue.front() : m_shards[t_cursor % Shards].queue.front();
+}
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+auto MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>::empty_impl() const -> bool {
+    return std::ranges::all_of(m_shards, [](const Shard& shard) { return shard.queue.empty(); });
+}
+
+template <typename T, std::size_t Shards, std::size_t ShardCapacity, WaitStrategy Wait>
+auto MessageQueue<T, ShardedPolicy<Shards, ShardCapacity, Wait>>::size_impl() const -> size_t {
+    size_t size = 0;
+    for (const Shard& shard: m_shards) size += shard.queue.size();
+    return size;
+}
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // SHARDED_QUEUE_HPP
@@ -0,0 +1,159 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <core/message_queue.hpp>
+#include <core/queue/detail/queue_utils.hpp>
+
+namespace labelimg::core::queue {
+inline namespace v2 {
+
+// 有界单生产者单消费者队列 (wait-free)
+// 生产者只写 tail, 消费者只写 head, 各自缓存对端索引以减少缓存行来回迁移
+template <std::size_t Capacity = 1024, WaitStrategy Wait = AtomicWait>
+    requires (detail::is_power_of_two(Capacity))
+struct SpscPolicy {};
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+class MessageQueue<T, SpscPolicy<Capacity, Wait>>: public Queue<MessageQueue<T, SpscPolicy<Capacity, Wait>>, T>
+                                           , private NonCopyable {
+public:
+    MessageQueue();
+    ~MessageQueue();
+
+    // ---- 生产者端 ----
+    // 队列已满时返回 false, 此时 value 不会被移动
+    template <typename U>
+    auto try_push(U&& value) -> bool;
+    // 队列已满时阻塞直到消费者腾出空位
+    void push_impl(T);
+
+    // ---- 消费者端 ----
+    void wait_and_pop(T&);
+    auto try_pop(T&) -> bool;
+    auto wait_for_pop(T&, std::chrono::milliseconds timeout) -> bool;
+
+    void pop_impl();
+    auto front_impl() -> T&;
+    [[nodiscard]] auto empty_impl() const -> bool;
+    [[nodiscard]] auto size_impl()  const -> size_t;
+
+    [[nodiscard]] static constexpr auto
+    capacity() noexcept -> size_t { return Capacity; }
+private:
+    struct Storage {
+        alignas(T) std::byte data[sizeof(T)];
+    };
+
+    static constexpr size_t mask = Capacity - 1;
+
+    auto slot(size_t index) noexcept -> T* {
+        return std::launder(reinterpret_cast<T*>(m_buffer[index & mask].data));
+    }
+
+    std::unique_ptr<Storage[]> m_buffer;
+
+    // 消费者独占的缓存行
+    alignas(detail::cache_line_size) std::atomic<size_t> m_head{0};
+    size_t m_cached_tail{0};
+
+    // 生产者独占的缓存行
+    alignas(detail::cache_line_size) std::atomic<size_t> m_tail{0};
+    size_t m_cached_head{0};
+
+    [[no_unique_address]] detail::Waiter<Wait> m_not_empty;
+    [[no_unique_address]] detail::Waiter<Wait> m_not_full;
+};
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+MessageQueue<T, SpscPolicy<Capacity, Wait>>::MessageQueue()
+    : m_buffer{std::make_unique<Storage[]>(Capacity)} {}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+MessageQueue<T, SpscPolicy<Capacity, Wait>>::~MessageQueue() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        for (size_t head = m_head.load(std::memory_order_relaxed); head != tail; ++head)
+            slot(head)->~T();
+    }
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+template <typename U>
+auto MessageQueue<T, SpscPolicy<Capacity, Wait>>::try_push(U&& value) -> bool {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cached_head == Capacity) {
+        m_cached_head = m_head.load(std::memory_order_acquire);
+        if (tail - m_cached_head == Capacity) return false;
+    }
+
+    ::new (static_cast<void*>(m_buffer[tail & mask].data)) T(std::forward<U>(value));
+    m_tail.store(tail + 1, std::memory_order_release);
+    m_not_empty.notify_one();
+    return true;
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+void MessageQueue<T, SpscPolicy<Capacity, Wait>>::push_impl(T value) {
+    m_not_full.wait([&] { return try_push(std::move(value)); });
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, SpscPolicy<Capacity, Wait>>::try_pop(T& value) -> bool {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_cached_tail) {
+        m_cached_tail = m_tail.load(std::memory_order_acquire);
+        if (head == m_cached_tail) return false;
+    }
+
+    T* item = slot(head);
+    value = std::move(*item);
+    item->~T();
+    m_head.store(head + 1, std::memory_order_release);
+    m_not_full.notify_one();
+    return true;
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+void MessageQueue<T, SpscPolicy<Capacity, Wait>>::wait_and_pop(T& value) {
+    m_not_empty.wait([&] { return try_pop(value); });
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, SpscPolicy<Capacity, Wait>>::wait_for_pop(T& value, std::chrono::milliseconds timeout) -> bool {
+    return m_not_empty.wait_for(timeout, [&] { return try_pop(value); });
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+void MessageQueue<T, SpscPolicy<Capacity, Wait>>::pop_impl() {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_cached_tail) {
+        m_cached_tail = m_tail.load(std::memory_order_acquire);
+        if (head == m_cached_tail) return;
+    }
+
+    slot(head)->~T();
+    m_head.store(head + 1, std::memory_order_release);
+    m_not_full.notify_one();
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, SpscPolicy<Capacity, Wait>>::front_impl() -> T& {
+    return *slot(m_head.load(std::memory_order_relaxed));
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, SpscPolicy<Capacity, Wait>>::empty_impl() const -> bool {
+    return size_impl() == 0;
+}
+
+template <typename T, std::size_t Capacity, WaitStrategy Wait>
+auto MessageQueue<T, SpscPolicy<Capacity, Wait>>::size_impl() const -> size_t {
+    size_t head = m_head.load(std::memory_order_acquire);
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // SPSC_QUEUE_HPP
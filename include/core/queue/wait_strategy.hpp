@@ -0,0 +1,425 @@
+#ifndef WAIT_STRATEGY_HPP
+#define WAIT_STRATEGY_HPP
+
+#include <core/queue/detail/queue_utils.hpp>
+
+#if defined (__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if __has_include(<linux/membarrier.h>)
+#include <linux/membarrier.h>
+#define QUEUE_HAS_MEMBARRIER 1
+#endif
+#endif
+
+namespace labelimg::core::queue {
+inline namespace v2 {
+
+// 队列阻塞等待策略, 作为各并发策略的模板参数:
+//  - CondVarWait: 互斥量 + 条件变量 (原有行为), 无等待者时跳过 notify
+//  - AtomicWait:  epoch 计数 + futex (std::atomic::wait); 先自适应自旋再休眠, 无等待者时生产者不进入内核
+//  - SpinWait:    只做指数退避轮询, 生产者不需要任何唤醒操作
+struct CondVarWait {};
+struct AtomicWait {};
+struct SpinWait {};
+
+template <typename W>
+concept WaitStrategy = std::same_as<W, CondVarWait>
+                    || std::same_as<W, AtomicWait>
+                    || std::same_as<W, SpinWait>;
+
+} // namespace v2
+
+namespace detail {
+
+// ---- futex 封装 ----
+// Linux 上直接使用 futex, 以便支持超时等待 (std::atomic::wait 没有超时版本);
+// 其他平台使用 std::atomic::wait / notify, 超时等待退化为退避轮询
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t)
+              && std::atomic<std::uint32_t>::is_always_lock_free);
+
+inline void atomic_wait(std::atomic<std::uint32_t>& word, std::uint32_t old) noexcept {
+#if defined (__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, old, nullptr, nullptr, 0);
+#else
+    word.wait(old, std::memory_order_acquire);
+#endif
+}
+
+// 返回 false 表示超时 (值仍未改变)
+inline auto atomic_wait_for(std::atomic<std::uint32_t>& word, std::uint32_t old, std::chrono::nanoseconds timeout) noexcept -> bool {
+    if (timeout <= std::chrono::nanoseconds::zero()) return word.load(std::memory_order_acquire) != old;
+#if defined (__linux__)
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    timespec ts{};
+    ts.tv_sec  = static_cast<time_t>(seconds.count());
+    ts.tv_nsec = static_cast<long>((timeout - seconds).count());
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, old, &ts, nullptr, 0);
+    return word.load(std::memory_order_acquire) != old;
+#else
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    Backoff backoff;
+    while (word.load(std::memory_order_acquire) == old) {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        backoff.pause();
+    }
+    return true;
+#endif
+}
+
+inline void atomic_notify_one(std::atomic<std::uint32_t>& word) noexcept {
+#if defined (__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    word.notify_one();
+#endif
+}
+
+inline void atomic_notify_all(std::atomic<std::uint32_t>& word) noexcept {
+#if defined (__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    word.notify_all();
+#endif
+}
+
+// ---- 非对称屏障 ----
+// 无锁队列的唤醒是 Dekker 式配对: 通知方 "写数据, 读等待者数", 等待方 "写等待者数, 读数据", 两侧之间都需要 StoreLoad 屏障
+// 通知方在每次 push / pop 上执行, 等待方只在即将休眠时执行; 因此把代价全部移到等待方:
+//  - Linux 4.14+ 用 membarrier(PRIVATE_EXPEDITED) 让所有正在运行本进程线程的 CPU 执行一次完整屏障,
+//    通知方只需编译器屏障, 快路径上不再有 mfence / dmb
+//  - 不支持时两侧都退回 seq_cst fence
+inline auto asymmetric_barrier_supported() noexcept -> bool {
+#if defined (QUEUE_HAS_MEMBARRIER)
+    // 局部静态变量: 初始化完成前其他线程会等待, 两侧不会一个看到 true 一个看到 false
+    static const bool supported = [] {
+        const long commands = syscall(SYS_membarrier, MEMBARRIER_CMD_QUERY, 0, 0);
+        return commands > 0
+            && (commands & MEMBARRIER_CMD_PRIVATE_EXPEDITED) != 0
+            && syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// 通知方: 写入数据之后、读取等待者数之前调用
+inline void light_barrier() noexcept {
+    if (asymmetric_barrier_supported()) [[likely]] std::atomic_signal_fence(std::memory_order_seq_cst);
+    else                                           std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+// 等待方: 登记等待者之后、再次检查数据之前调用
+inline void heavy_barrier() noexcept {
+#if defined (QUEUE_HAS_MEMBARRIER)
+    if (asymmetric_barrier_supported()) {
+        syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+        return;
+    }
+#endif
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+// 等待器: 每个 "条件" (非空 / 未满) 一个实例
+// 两组接口:
+//  - wait(lock, pred) / wait_for(lock, timeout, pred): 用于加锁队列, 持锁调用, pred 在持锁时求值
+//  - wait(op) / wait_for(timeout, op):                  用于无锁队列, op 是一次尝试 (如 try_pop), 成功返回 true
+// notify_*() 在条件可能成立后调用; 没有等待者时不做任何唤醒
+template <WaitStrategy W>
+class Waiter;
+
+template <>
+class Waiter<CondVarWait> {
+public:
+    template <typename Pred>
+    void wait(std::unique_lock<std::mutex>& lock, Pred pred) {
+        if (pred()) return;
+        enter_locked();
+        m_cond.wait(lock, pred);
+        m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    template <typename Pred>
+    auto wait_for(std::unique_lock<std::mutex>& lock, std::chrono::nanoseconds timeout, Pred pred) -> bool {
+        if (pred()) return true;
+        enter_locked();
+        bool ready = m_cond.wait_for(lock, timeout, pred);
+        m_waiters.fetch_sub(1, std::memory_order_relaxed);
+        return ready;
+    }
+
+    template <typename Op>
+    void wait(Op op) {
+        (void)wait_impl(op, nullptr);
+    }
+
+    template <typename Op>
+    auto wait_for(std::chrono::nanoseconds timeout, Op op) -> bool {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        return wait_impl(op, &deadline);
+    }
+
+    void notify_one() noexcept {
+        if (!has_waiters()) return;
+        bump();
+        m_cond.notify_one();
+    }
+
+    void notify_all() noexcept {
+        if (!has_waiters()) return;
+        bump();
+        m_cond.notify_all();
+    }
+private:
+    // 登记等待者后的条件检查与通知方的 has_waiters 构成 Dekker 式配对:
+    // 要么通知方看到等待者, 要么等待方看到新条件
+    void enter() noexcept {
+        m_waiters.fetch_add(1, std::memory_order_relaxed);
+        heavy_barrier();
+    }
+
+    // 加锁队列的等待者持有队列锁登记, 通知方修改数据时也持有该锁, 锁的获取 / 释放已保证上述配对
+    void enter_locked() noexcept {
+        m_waiters.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto has_waiters() const noexcept -> bool {
+        light_barrier();
+        return m_waiters.load(std::memory_order_relaxed) != 0;
+    }
+
+    // 无锁队列的等待者在 m_mutex 内比较 epoch, 通知方在 m_mutex 内推进 epoch, 不会错过唤醒
+    void bump() noexcept {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_epoch;
+    }
+
+    // op 可能触发另一个等待器的 notify, 因此不能在持有 m_mutex 时调用
+    template <typename Op>
+    auto wait_impl(Op& op, const std::chrono::steady_clock::time_point* deadline) -> bool {
+        for (;;) {
+            if (op()) return true;
+
+            std::uint32_t epoch = 0;
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                epoch = m_epoch;
+            }
+            enter();
+            bool ready = op();
+            bool woken = true;
+            if (!ready) {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                auto changed = [&] { return m_epoch != epoch; };
+                if (deadline == nullptr) m_cond.wait(lock, changed);
+                else woken = m_cond.wait_until(lock, *deadline, changed);
+            }
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+            if (ready) return true;
+            if (!woken) return op();
+        }
+    }
+
+    std::atomic<std::uint32_t> m_waiters{0};
+    std::uint32_t m_epoch{0};
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+};
+
+template <>
+class Waiter<AtomicWait> {
+public:
+    template <typename Pred>
+    void wait(std::unique_lock<std::mutex>& lock, Pred pred) {
+        (void)wait_impl(lock, pred, nullptr);
+    }
+
+    template <typename Pred>
+    auto wait_for(std::unique_lock<std::mutex>& lock, std::chrono::nanoseconds timeout, Pred pred) -> bool {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        return wait_impl(lock, pred, &deadline);
+    }
+
+    template <typename Op>
+    void wait(Op op) {
+        (void)wait_impl(op, nullptr);
+    }
+
+    template <typename Op>
+    auto wait_for(std::chrono::nanoseconds timeout, Op op) -> bool {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        return wait_impl(op, &deadline);
+    }
+
+    void notify_one() noexcept {
+        if (!has_waiters()) return;
+        m_epoch.fetch_add(1, std::memory_order_release);
+        atomic_notify_one(m_epoch);
+    }
+
+    void notify_all() noexcept {
+        if (!has_waiters()) return;
+        m_epoch.fetch_add(1, std::memory_order_release);
+        atomic_notify_all(m_epoch);
+    }
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::uint32_t min_spin = 16;
+    static constexpr std::uint32_t max_spin = 4096;
+
+    // 与 Waiter<CondVarWait> 相同的配对方式
+    void enter() noexcept {
+        m_waiters.fetch_add(1, std::memory_order_relaxed);
+        heavy_barrier();
+    }
+
+    void enter_locked() noexcept {
+        m_waiters.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto has_waiters() const noexcept -> bool {
+        light_barrier();
+        return m_waiters.load(std::memory_order_relaxed) != 0;
+    }
+
+    // 自旋成功则加倍自旋预算, 失败则减半, 使自旋时长贴近实际的交接间隔
+    void adapt(bool spin_succeeded) noexcept {
+        std::uint32_t spin = m_spin.load(std::memory_order_relaxed);
+        spin = spin_succeeded ? std::min(spin * 2, max_spin) : std::max(spin / 2, min_spin);
+        m_spin.store(spin, std::memory_order_relaxed);
+    }
+
+    // 休眠直到 epoch 改变; 超时返回 false
+    auto sleep(std::uint32_t epoch, const Clock::time_point* deadline) noexcept -> bool {
+        while (m_epoch.load(std::memory_order_acquire) == epoch) {
+            if (deadline == nullptr) {
+                atomic_wait(m_epoch, epoch);
+            } else if (!atomic_wait_for(m_epoch, epoch, *deadline - Clock::now())) {
+                return Clock::now() < *deadline;
+            }
+        }
+        return true;
+    }
+
+    template <typename Pred>
+    auto wait_impl(std::unique_lock<std::mutex>& lock, Pred& pred, const Clock::time_point* deadline) -> bool {
+        if (pred()) return true;
+
+        // 自旋阶段: 短暂放锁让生产者入队, 不登记为等待者, 生产者也就不需要唤醒
+        const std::uint32_t budget = m_spin.load(std::memory_order_relaxed);
+        for (std::uint32_t spun = 0; spun < budget; spun += 16) {
+            lock.unlock();
+            for (int i = 0; i < 16; ++i) cpu_relax();
+            lock.lock();
+            if (pred()) {
+                adapt(true);
+                return true;
+            }
+        }
+        adapt(false);
+
+        for (;;) {
+            std::uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+            enter_locked();
+            lock.unlock();
+            bool woken = sleep(epoch, deadline);
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+            lock.lock();
+
+            if (pred()) return true;
+            if (!woken) return false;
+        }
+    }
+
+    template <typename Op>
+    auto wait_impl(Op& op, const Clock::time_point* deadline) -> bool {
+        if (op()) return true;
+
+        const std::uint32_t budget = m_spin.load(std::memory_order_relaxed);
+        for (std::uint32_t spun = 0; spun < budget; ++spun) {
+            cpu_relax();
+            if (op()) {
+                adapt(true);
+                return true;
+            }
+        }
+        adapt(false);
+
+        for (;;) {
+            std::uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+            enter();
+            // 登记后再试一次, 避免错过在登记之前发生的入队
+            if (op()) {
+                m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            bool woken = sleep(epoch, deadline);
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+            if (op()) return true;
+            if (!woken) return false;
+        }
+    }
+
+    alignas(cache_line_size) std::atomic<std::uint32_t> m_epoch{0};
+    std::atomic<std::uint32_t> m_waiters{0};
+    std::atomic<std::uint32_t> m_spin{min_spin * 4};
+};
+
+template <>
+class Waiter<SpinWait> {
+public:
+    template <typename Pred>
+    void wait(std::unique_lock<std::mutex>& lock, Pred pred) {
+        Backoff backoff;
+        while (!pred()) {
+            lock.unlock();
+            backoff.pause();
+            lock.lock();
+        }
+    }
+
+    template <typename Pred>
+    auto wait_for(std::unique_lock<std::mutex>& lock, std::chrono::nanoseconds timeout, Pred pred) -> bool {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        Backoff backoff;
+        while (!pred()) {
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+            lock.unlock();
+            backoff.pause();
+            lock.lock();
+        }
+        return true;
+    }
+
+    template <typename Op>
+    void wait(Op op) {
+        Backoff backoff;
+        while (!op()) backoff.pause();
+    }
+
+    template <typename Op>
+    auto wait_for(std::chrono::nanoseconds timeout, Op op) -> bool {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        Backoff backoff;
+        while (!op()) {
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+            backoff.pause();
+        }
+        return true;
+    }
+
+    constexpr void notify_one() const noexcept {}
+    constexpr void notify_all() const noexcept {}
+};
+
+} // namespace detail
+} // namespace labelimg::core::queue
+
+#endif // WAIT_STRATEGY_HPP
@@ -0,0 +1,98 @@
+#ifndef SITE_LOGGER_HPP
+#define SITE_LOGGER_HPP
+
+#include <core/async_logger.h>
+#include <core/formatter/function.h>
+#include <core/log_site.hpp>
+#include <cstdint>
+#include <source_location>
+#include <string_view>
+
+namespace labelimg::core::logger {
+inline namespace v2 {
+
+// 文本输出时的格式化方式: 只追加换行
+struct PlainLineFormat {
+    template <typename... Args>
+    static constexpr DeferredFormatter formatter = &DeferredFormat<Args...>::format_line;
+};
+
+[[nodiscard]] consteval auto
+make_log_site_info( std::uint8_t level
+                  , std::string_view level_name
+                  , std::string_view format
+                  , const std::source_location& location
+                  ) -> LogSiteInfo {
+    const auto function = formatter::function::FunctionInfoExtractor<>::get_info_cpp20(location);
+    return LogSiteInfo{
+        .level      = level,
+        .level_name = level_name,
+        .file       = function.file_name,
+        .line       = location.line(),
+        .function   = function.function_name,
+        .format     = format
+    };
+}
+
+// SiteInfoFn 是调用处的无捕获 lambda, 每个调用点的类型不同, 因此下面的静态变量每个调用点各一份:
+// 首次执行时注册调用点, 之后每次只写调用点指针、时间戳和参数
+template <typename Format, typename SiteInfoFn, DeferredLogArg... Args>
+void log_at_site(SiteInfoFn, const Args&... args) {
+    static constexpr LogSiteInfo info = SiteInfoFn{}();
+    // 按解码后的类型做编译期格式串检查
+    [[maybe_unused]] static constexpr deferred_format_string<Args...> checked{info.format};
+
+    static const LogSite& site = LogSiteRegistry::instance().add<Args...>(info, Format::template formatter<Args...>);
+    ThreadRingAsyncLogger::instance().write_site(site, args...);
+}
+
+// 函数耗时记录的文本格式: 函数名取自调用点, 不随每条记录编码
+template <typename SiteInfoFn>
+void format_trace_line(std::string_view format, const std::byte* args, fmt::memory_buffer& out) {
+    static constexpr LogSiteInfo info = SiteInfoFn{}();
+    fmt::format_to(std::back_inserter(out), "[TRACE] {} ", info.function);
+    DeferredFormat<std::uint64_t>::format_line(format, args, out);
+}
+
+// 每个 TRACE_FUNCTION_LOG 调用点注册一次; 记录只带耗时, 二进制解码时函数名从调用点表取得
+template <typename SiteInfoFn>
+auto trace_site(SiteInfoFn) -> const LogSite& {
+    static constexpr LogSiteInfo info = SiteInfoFn{}();
+    static const LogSite& site = LogSiteRegistry::instance().add<std::uint64_t>(info, &format_trace_line<SiteInfoFn>);
+    return site;
+}
+
+// 记录函数耗时 (周期数), 函数名只在注册时解析一次
+class SiteTracer: private NonCopyable {
+public:
+    explicit SiteTracer(const LogSite& site): m_site{site}, m_start{asm_::HighPrecisionTimer::cycles()} {}
+
+    ~SiteTracer() {
+        const std::uint64_t cycles = asm_::HighPrecisionTimer::cycles() - m_start;
+        ThreadRingAsyncLogger::instance().write_site(m_site, cycles);
+    }
+private:
+    const LogSite& m_site;
+    std::uint64_t  m_start;
+};
+
+} // namespace v2
+} // namespace labelimg::core::logger
+
+// 通用的调用点日志宏; Format 决定没有二进制输出时的文本格式
+#define LOG_AT_SITE(Format, level, level_name, format, ...)                                           \
+    do {                                                                                              \
+        static constexpr auto _log_site_info = ::labelimg::core::logger::make_log_site_info(         \
+            static_cast<std::uint8_t>(level), level_name, format, ::std::source_location::current()); \
+        ::labelimg::core::logger::log_at_site<Format>(                                               \
+            []() -> const ::labelimg::core::logger::LogSiteInfo& { return _log_site_info; }          \
+            __VA_OPT__(,) __VA_ARGS__);                                                               \
+    } while (false)
+
+#define TRACE_FUNCTION_LOG()                                                                          \
+    static constexpr auto _trace_site_info = ::labelimg::core::logger::make_log_site_info(           \
+        0, "TRACE", "executed in {} cycles", ::std::source_location::current());                     \
+    ::labelimg::core::logger::SiteTracer _site_tracer{::labelimg::core::logger::trace_site(          \
+        []() -> const ::labelimg::core::logger::LogSiteInfo& { return _trace_site_info; })}
+
+#endif // SITE_LOGGER_HPP
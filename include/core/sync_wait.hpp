@@ -0,0 +1,81 @@
+#ifndef SYNC_WAIT_HPP
+#define SYNC_WAIT_HPP
+
+#include <core/message_queue.hpp>
+#include <condition_variable>
+#include <mutex>
+
+// sync_wait(task): 在非协程上下文中阻塞等待 Task 完成
+// 单独成头文件, 只需要阻塞等待的地方 (例如日志后端) 不必引入全部组合子
+
+namespace labelimg::core::queue {
+namespace detail {
+
+// 只等待完成, 不取走结果
+template <typename T>
+struct CompletionAwaiter {
+    typename Task<T>::Awaiter inner;
+
+    [[nodiscard]] auto
+    await_ready() const noexcept -> bool { return inner.await_ready(); }
+
+    auto await_suspend(std::coroutine_handle<> waiter) noexcept -> bool { return inner.await_suspend(waiter); }
+
+    constexpr void await_resume() const noexcept {}
+};
+
+// 自行销毁的后台协程, 仅供组合子内部使用
+struct DetachedTask {
+    struct promise_type {
+        auto get_return_object() noexcept -> DetachedTask { return {}; }
+        auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+        auto final_suspend()   noexcept -> std::suspend_never { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        static auto operator new(std::size_t size) -> void* { return FrameAllocator::allocate(size); }
+        static void operator delete(void* ptr, std::size_t size) noexcept { FrameAllocator::deallocate(ptr, size); }
+    };
+};
+
+struct SyncWaitState {
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool done{false};
+};
+
+template <typename T>
+auto sync_wait_watch(Task<T>& task, SyncWaitState& state) -> DetachedTask {
+    co_await CompletionAwaiter<T>{task.operator co_await()};
+    // 在锁内通知, 保证 sync_wait 返回前本协程已不再访问 state
+    std::lock_guard<std::mutex> lock{state.mutex};
+    state.done = true;
+    state.cond.notify_one();
+}
+
+} // namespace detail
+
+inline namespace v2 {
+
+// 阻塞当前线程直到 task 完成, 不能在 task 依赖的执行器线程上调用
+template <typename T>
+auto sync_wait(Task<T>& task) -> T {
+    if (!task.is_ready()) {
+        detail::SyncWaitState state;
+        detail::sync_wait_watch(task, state);
+
+        std::unique_lock<std::mutex> lock{state.mutex};
+        state.cond.wait(lock, [&state] { return state.done; });
+    }
+    return std::move(task).get();
+}
+
+template <typename T>
+auto sync_wait(Task<T>&& task) -> T {
+    return sync_wait(task);
+}
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // SYNC_WAIT_HPP
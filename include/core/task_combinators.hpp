@@ -0,0 +1,175 @@
+#ifndef TASK_COMBINATORS_HPP
+#define TASK_COMBINATORS_HPP
+
+#include <core/sync_wait.hpp>
+
+// Task 组合子
+//  - when_all(tasks...)  等待全部完成, 结果按参数顺序组成 tuple (void -> std::monostate)
+//  - when_all(vector)    等待全部完成, 结果组成 vector
+//  - when_any(tasks...)  第一个完成者的下标与结果, 其余任务继续在后台运行到结束
+//  - then(task, f)       任务完成后以其结果调用 f, f 返回 Task 时会被继续等待
+//  - sync_wait(task)     在非协程上下文中阻塞等待任务完成 (见 core/sync_wait.hpp)
+//
+// Task 是立即启动的, 创建即已开始并发执行; 组合子只负责汇合, 等待本身不额外分配内存
+// (when_any 需要一个共享控制块, 以便落选任务在调用方离开后仍能安全结束)
+
+namespace labelimg::core::queue {
+namespace detail {
+
+template <typename T>
+using non_void_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+// 把 Task<void> 的等待结果映射为 std::monostate, 便于放进 tuple
+template <typename T>
+struct MonostateAwaiter {
+    typename Task<T>::Awaiter inner;
+
+    [[nodiscard]] auto
+    await_ready() const noexcept -> bool { return inner.await_ready(); }
+
+    auto await_suspend(std::coroutine_handle<> waiter) noexcept -> bool { return inner.await_suspend(waiter); }
+
+    auto await_resume() -> non_void_t<T> {
+        if constexpr (std::is_void_v<T>) {
+            inner.await_resume();
+            return {};
+        } else {
+            return inner.await_resume();
+        }
+    }
+};
+
+template <typename T>
+auto await_as_value(Task<T>& task) -> MonostateAwaiter<T> {
+    return MonostateAwaiter<T>{task.operator co_await()};
+}
+
+template <typename T>
+struct WhenAnyState {
+    std::atomic<bool> claimed{false};
+    ContinuationSlot continuation;
+    std::size_t index{0};
+    std::variant<std::monostate, non_void_t<T>, std::exception_ptr> result;
+};
+
+template <typename T>
+auto when_any_watch(Task<T> task, std::size_t index, std::shared_ptr<WhenAnyState<T>> state) -> DetachedTask {
+    std::variant<std::monostate, non_void_t<T>, std::exception_ptr> result;
+    try {
+        result.template emplace<1>(co_await await_as_value(task));
+    } catch (...) {
+        result.template emplace<2>(std::current_exception());
+    }
+
+    if (!state->claimed.exchange(true, std::memory_order_acq_rel)) {
+        state->index  = index;
+        state->result = std::move(result);
+        state->continuation.complete().resume();
+    }
+}
+
+template <typename T>
+struct WhenAnyAwaiter {
+    WhenAnyState<T>& state;
+
+    [[nodiscard]] auto
+    await_ready() const noexcept -> bool { return state.continuation.is_completed(); }
+
+    auto await_suspend(std::coroutine_handle<> waiter) noexcept -> bool { return state.continuation.set(waiter); }
+
+    constexpr void await_resume() const noexcept {}
+};
+
+} // namespace detail
+
+inline namespace v2 {
+
+template <typename T>
+struct is_task: std::false_type {};
+
+template <typename T>
+struct is_task<Task<T>>: std::true_type {};
+
+// Task<T> -> T, 其他类型保持不变
+template <typename T>
+struct unwrap_task { using type = T; };
+
+template <typename T>
+struct unwrap_task<Task<T>> { using type = T; };
+
+template <typename T>
+inline constexpr bool is_task_v = is_task<std::remove_cvref_t<T>>::value;
+
+template <typename T>
+struct WhenAnyResult {
+    std::size_t index;
+    T value;
+};
+
+template <>
+struct WhenAnyResult<void> {
+    std::size_t index;
+};
+
+// 按参数顺序依次等待; 任务早已并发运行, 因此总耗时取决于最慢的那个
+template <typename... Ts>
+auto when_all(Task<Ts>... tasks) -> Task<std::tuple<detail::non_void_t<Ts>...>> {
+    co_return std::tuple<detail::non_void_t<Ts>...>{co_await detail::await_as_value(tasks)...};
+}
+
+template <typename T>
+auto when_all(std::vector<Task<T>> tasks) -> Task<std::conditional_t<std::is_void_v<T>, void, std::vector<detail::non_void_t<T>>>> {
+    if constexpr (std::is_void_v<T>) {
+        for (auto& task: tasks) co_await task;
+    } else {
+        std::vector<T> results;
+        results.reserve(tasks.size());
+        for (auto& task: tasks) results.push_back(co_await task);
+        co_return results;
+    }
+}
+
+template <typename T, typename... Rest>
+    requires (std::same_as<T, Rest> && ...)
+auto when_any(Task<T> first, Task<Rest>... rest) -> Task<WhenAnyResult<T>> {
+    auto state = std::make_shared<detail::WhenAnyState<T>>();
+
+    std::size_t index = 0;
+    detail::when_any_watch(std::move(first), index++, state);
+    (detail::when_any_watch(std::move(rest), index++, state), ...);
+
+    co_await detail::WhenAnyAwaiter<T>{*state};
+
+    if (state->result.index() == 2) std::rethrow_exception(std::get<2>(state->result));
+    if constexpr (std::is_void_v<T>) {
+        co_return WhenAnyResult<void>{state->index};
+    } else {
+        co_return WhenAnyResult<T>{state->index, std::move(std::get<1>(state->result))};
+    }
+}
+
+template <typename T, typename F>
+auto then(Task<T> task, F func) {
+    using Result = std::conditional_t<std::is_void_v<T>,
+                                      std::invoke_result<F>,
+                                      std::invoke_result<F, T>>::type;
+    using Value  = unwrap_task<Result>::type;
+
+    return [](Task<T> source, F continuation) -> Task<Value> {
+        if constexpr (std::is_void_v<T>) {
+            co_await source;
+            if constexpr (is_task_v<Result>) co_return co_await continuation();
+            else if constexpr (std::is_void_v<Result>) continuation();
+            else co_return continuation();
+        } else {
+            if constexpr (is_task_v<Result>) co_return co_await continuation(co_await source);
+            else if constexpr (std::is_void_v<Result>) continuation(co_await source);
+            else co_return continuation(co_await source);
+        }
+    }(std::move(task), std::move(func));
+}
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // TASK_COMBINATORS_HPP
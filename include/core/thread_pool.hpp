@@ -0,0 +1,178 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <core/message_queue.hpp>
+#include <core/queue/detail/chase_lev_deque.hpp>
+
+namespace labelimg::core::queue {
+inline namespace v2 {
+
+// 工作窃取线程池, 用于调度 Task 协程
+//  - 每个工作线程有自己的 Chase-Lev 双端队列 (本地 LIFO, 窃取 FIFO)
+//  - 非工作线程投递的协程进入全局注入队列
+//  - 空闲线程依次尝试: 本地队列 -> 全局队列 -> 随机窃取 -> 休眠
+//
+// 用法:
+//     auto job = [&]() -> Task<void> {
+//         co_await pool.schedule();   // 切换到工作线程
+//         ...
+//     };
+class WorkStealingPool: private NonCopyable {
+public:
+    explicit WorkStealingPool(std::size_t thread_count = std::max(1U, std::thread::hardware_concurrency()))
+        : m_workers(thread_count) {
+        m_threads.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i)
+            m_threads.emplace_back(&WorkStealingPool::worker_loop, this, i);
+    }
+
+    ~WorkStealingPool() { shutdown(); }
+
+    // 等待已投递的协程全部执行完后停止工作线程
+    void shutdown() {
+        if (m_stop.exchange(true)) return;
+        wake(true);
+        for (auto& thread: m_threads)
+            if (thread.joinable()) thread.join();
+    }
+
+    void post(std::coroutine_handle<> handle) {
+        if (auto* worker = current_worker(); worker != nullptr) {
+            worker->deque.push(handle.address());
+        } else {
+            m_injection.push(handle);
+        }
+
+        m_pending.fetch_add(1, std::memory_order_seq_cst);
+        if (m_sleepers.load(std::memory_order_seq_cst) > 0) wake(false);
+    }
+
+    struct ScheduleAwaiter {
+        WorkStealingPool* pool;
+
+        [[nodiscard]] constexpr auto
+        await_ready() const noexcept -> bool { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle) { pool->post(handle); }
+
+        constexpr void await_resume() const noexcept {}
+    };
+
+    // co_await pool.schedule() 后, 协程在某个工作线程上继续执行
+    [[nodiscard]] auto schedule() noexcept -> ScheduleAwaiter { return ScheduleAwaiter{this}; }
+
+    [[nodiscard]] auto
+    worker_count()
+    const noexcept -> std::size_t { return m_workers.size(); }
+
+    [[nodiscard]] auto
+    is_worker_thread()
+    const noexcept -> bool { return current_worker() != nullptr; }
+
+    // 统计: 成功窃取的次数
+    [[nodiscard]] auto
+    steal_count()
+    const noexcept -> std::size_t { return m_steals.load(std::memory_order_relaxed); }
+private:
+    struct alignas(detail::cache_line_size) Worker {
+        detail::ChaseLevDeque<void*> deque;
+    };
+
+    struct ThreadContext {
+        const WorkStealingPool* pool = nullptr;
+        Worker* worker = nullptr;
+    };
+
+    static auto context() noexcept -> ThreadContext& {
+        thread_local ThreadContext ctx;
+        return ctx;
+    }
+
+    [[nodiscard]] auto current_worker() const noexcept -> Worker* {
+        auto& ctx = context();
+        return ctx.pool == this ? ctx.worker : nullptr;
+    }
+
+    void wake(bool all) {
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (all) m_epoch.notify_all();
+        else m_epoch.notify_one();
+    }
+
+    auto find_work(std::size_t index, std::uint64_t& rng) -> std::coroutine_handle<> {
+        if (auto local = m_workers[index].deque.pop())
+            return std::coroutine_handle<>::from_address(*local);
+
+        std::coroutine_handle<> handle;
+        if (m_injection.try_pop(handle)) return handle;
+
+        // xorshift 选择随机起点, 避免所有空闲线程同时窃取同一个受害者
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        const std::size_t count = m_workers.size();
+        const std::size_t start = static_cast<std::size_t>(rng % count);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t victim = (start + i) % count;
+            if (victim == index) continue;
+            if (auto stolen = m_workers[victim].deque.steal()) {
+                m_steals.fetch_add(1, std::memory_order_relaxed);
+                return std::coroutine_handle<>::from_address(*stolen);
+            }
+        }
+        return {};
+    }
+
+    void worker_loop(std::size_t index) {
+        context() = ThreadContext{this, &m_workers[index]};
+        std::uint64_t rng = 0x9E3779B97F4A7C15ULL * (index + 1);
+        detail::Backoff backoff;
+
+        for (;;) {
+            if (auto handle = find_work(index, rng)) {
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                handle.resume();
+                backoff.reset();
+                continue;
+            }
+
+            if (m_stop.load(std::memory_order_acquire) &&
+                m_pending.load(std::memory_order_acquire) == 0) break;
+
+            // 有任务正在被投递 / 仍在其他队列中, 先短暂自旋
+            if (!backoff.is_sleeping()) {
+                backoff.pause();
+                continue;
+            }
+
+            // 先记录 epoch 再登记为休眠者, 投递方看到休眠者后会推进 epoch
+            std::uint32_t epoch = m_epoch.load(std::memory_order_seq_cst);
+            m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (m_pending.load(std::memory_order_seq_cst) == 0 &&
+                !m_stop.load(std::memory_order_seq_cst)) {
+                m_epoch.wait(epoch, std::memory_order_seq_cst);
+            }
+            m_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+            backoff.reset();
+        }
+
+        context() = ThreadContext{};
+    }
+
+    std::vector<Worker> m_workers;
+    std::vector<std::thread> m_threads;
+    MessageQueue<std::coroutine_handle<>, MutexPolicy> m_injection;
+
+    alignas(detail::cache_line_size) std::atomic<std::int64_t> m_pending{0};
+    alignas(detail::cache_line_size) std::atomic<std::uint32_t> m_epoch{0};
+    std::atomic<std::uint32_t> m_sleepers{0};
+    std::atomic<bool> m_stop{false};
+    std::atomic<std::size_t> m_steals{0};
+};
+
+static_assert(CoroutineExecutor<WorkStealingPool>);
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,374 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <core/message_queue.hpp>
+#include <bit>
+#include <functional>
+#include <span>
+
+namespace labelimg::core::queue {
+inline namespace v2 {
+
+// 指向已登记定时任务的句柄; 任务执行或取消后失效 (通过代数检测)
+struct TimerId {
+    std::uint32_t index{std::numeric_limits<std::uint32_t>::max()};
+    std::uint32_t generation{0};
+};
+
+// 分层时间轮: 单个计时线程驱动任意数量的定时任务
+//  - 4 层, 每层槽位数 256 / 64 / 64 / 64, 共 2^26 个 tick; tick 为 1ms 时覆盖约 18.6 小时, 更远的任务在顶层循环等待
+//  - 定时任务放在与当前时刻 "高位相同" 的最低层, 高层槽位到期时逐层下放 (级联)
+//  - 登记 / 取消都是 O(1): 节点存放在数组中, 槽位是按下标链接的双向链表
+//  - 计时线程只在下一个有任务的槽位 (或级联点) 到期时醒来, 没有任务时一直休眠, 不做轮询
+//
+// 任务在计时线程上执行, 应当很短 (例如把消息放入队列, 或把协程交给执行器)
+//
+// 用法:
+//     auto id = timer.schedule_after(500ms, [&] { autosave_queue.push(AutosaveJob{}); });
+//     timer.cancel(id);                       // 用户又修改了标注, 重新计时
+//     co_await sleep_for(50ms, executor);     // 协程休眠, 到期后在 executor 上恢复
+class TimerWheel: private NonCopyable {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Job   = std::move_only_function<void()>;
+
+    explicit TimerWheel(Clock::duration tick = std::chrono::milliseconds(1))
+        : m_tick{std::max(tick, Clock::duration{1})}
+        , m_epoch{Clock::now()}
+        , m_thread{&TimerWheel::run, this} {}
+
+    ~TimerWheel() { shutdown(); }
+
+    // 停止计时线程; 尚未到期的任务被丢弃
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (m_stop) return;
+            m_stop = true;
+        }
+        m_cond.notify_one();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    // 在 deadline 之后 (按 tick 向上取整) 执行 job
+    auto schedule_at(Clock::time_point deadline, Job job) -> TimerId {
+        auto delay  = std::max(deadline - m_epoch, Clock::duration::zero());
+        auto expiry = static_cast<std::uint64_t>((delay + m_tick - Clock::duration{1}) / m_tick);
+
+        TimerId id;
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            // 空闲时计时线程不推进 m_now, 先追上当前时刻, 避免新任务从很低的起点逐层级联
+            if (m_pending == 0) m_now = std::max(m_now, current_tick());
+
+            std::uint32_t index = m_free;
+            if (index != npos) {
+                m_free = m_nodes[index].next;
+            } else {
+                index = static_cast<std::uint32_t>(m_nodes.size());
+                m_nodes.emplace_back();
+            }
+
+            Node& node = m_nodes[index];
+            node.job    = std::move(job);
+            node.expiry = std::max(expiry, m_now + 1);
+            place(index);
+            ++m_pending;
+
+            id   = TimerId{index, node.generation};
+            wake = m_wake_tick != 0 && next_event() < m_wake_tick;
+        }
+        if (wake) m_cond.notify_one();
+        return id;
+    }
+
+    template <typename Rep, typename Period>
+    auto schedule_after(std::chrono::duration<Rep, Period> delay, Job job) -> TimerId {
+        return schedule_at(Clock::now() + std::chrono::ceil<Clock::duration>(delay), std::move(job));
+    }
+
+    // 任务尚未开始执行时取消并返回 true
+    auto cancel(TimerId id) -> bool {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (id.index >= m_nodes.size()) return false;
+
+            Node& node = m_nodes[id.index];
+            if (node.generation != id.generation || node.slot == npos) return false;
+
+            unlink(id.index);
+            job = release(id.index);
+        }
+        // 任务对象 (及其捕获的资源) 在锁外析构
+        return true;
+    }
+
+    [[nodiscard]] auto
+    pending()
+    const -> std::size_t {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_pending;
+    }
+
+    [[nodiscard]] auto
+    tick()
+    const noexcept -> Clock::duration { return m_tick; }
+
+    // co_await 后协程在计时线程 (Executor = InlineExecutor) 或指定执行器上恢复
+    template <CoroutineExecutor Executor = InlineExecutor>
+    struct SleepAwaiter {
+        TimerWheel* wheel;
+        Clock::time_point deadline;
+        Executor* executor;
+
+        [[nodiscard]] auto
+        await_ready() const -> bool { return deadline <= Clock::now(); }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            // 登记后协程可能立即在计时线程上恢复, 之后不能再访问 this
+            if constexpr (std::is_same_v<Executor, InlineExecutor>) {
+                wheel->schedule_at(deadline, [handle] { handle.resume(); });
+            } else {
+                wheel->schedule_at(deadline, [handle, executor = executor] { executor->post(handle); });
+            }
+        }
+
+        constexpr void await_resume() const noexcept {}
+    };
+
+    template <typename Rep, typename Period>
+    [[nodiscard]] auto sleep_for(std::chrono::duration<Rep, Period> delay) -> SleepAwaiter<> {
+        return SleepAwaiter<>{this, Clock::now() + std::chrono::ceil<Clock::duration>(delay), nullptr};
+    }
+
+    template <typename Rep, typename Period, CoroutineExecutor Executor>
+    [[nodiscard]] auto sleep_for(std::chrono::duration<Rep, Period> delay, Executor& executor) -> SleepAwaiter<Executor> {
+        return SleepAwaiter<Executor>{this, Clock::now() + std::chrono::ceil<Clock::duration>(delay), &executor};
+    }
+private:
+    static constexpr std::uint32_t npos       = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint64_t never      = std::numeric_limits<std::uint64_t>::max();
+    static constexpr std::size_t   levels     = 4;
+    // 第 L 层槽位号取 tick 的 [shifts[L], shifts[L + 1]) 位
+    static constexpr std::array<std::uint32_t, levels + 1> shifts  = {0, 8, 14, 20, 26};
+    static constexpr std::array<std::size_t, levels>       offsets = {0, 256, 320, 384};
+    static constexpr std::size_t   slot_count = 448;
+
+    struct Node {
+        Job job;
+        std::uint64_t expiry{0};
+        std::uint32_t prev{npos};
+        std::uint32_t next{npos};
+        std::uint32_t generation{0};
+        std::uint32_t slot{npos};
+    };
+
+    struct Slot {
+        std::uint32_t head{npos};
+        std::uint32_t tail{npos};
+    };
+
+    [[nodiscard]] static constexpr auto
+    level_mask(std::size_t level) noexcept -> std::uint64_t { return (std::uint64_t{1} << (shifts[level + 1] - shifts[level])) - 1; }
+
+    [[nodiscard]] auto current_tick() const -> std::uint64_t {
+        return static_cast<std::uint64_t>((Clock::now() - m_epoch) / m_tick);
+    }
+
+    [[nodiscard]] auto time_of(std::uint64_t tick) const -> Clock::time_point {
+        return m_epoch + m_tick * static_cast<Clock::rep>(tick);
+    }
+
+    void link(std::uint32_t index, std::size_t slot) noexcept {
+        Node& node = m_nodes[index];
+        Slot& list = m_slots[slot];
+
+        node.slot = static_cast<std::uint32_t>(slot);
+        node.prev = list.tail;
+        node.next = npos;
+        if (list.tail != npos) m_nodes[list.tail].next = index;
+        else list.head = index;
+        list.tail = index;
+
+        m_occupied[slot / 64] |= std::uint64_t{1} << (slot % 64);
+    }
+    void unlink(std::uint32_t index) noexcept {
+        Node& node = m_nodes[index];
+        Slot& list = m_slots[node.slot];
+
+        if (node.prev != npos) m_nodes[node.prev].next = node.next;
+        else list.head = node.next;
+        if (node.next != npos) m_nodes[node.next].prev = node.prev;
+        else list.tail = node.prev;
+
+        if (list.head == npos) m_occupied[node.slot / 64] &= ~(std::uint64_t{1} << (node.slot % 64));
+        node.slot = npos;
+    }
+    // 按 m_now 把节点放入对应层的槽位
+    void place(std::uint32_t index) noexcept {
+        const std::uint64_t expiry = m_nodes[index].expiry;
+
+        for (std::size_t level = 0; level < levels; ++level) {
+            if ((expiry >> shifts[level + 1]) == (m_now >> shifts[level + 1])) {
+                link(index, offsets[level] + ((expiry >> shifts[level]) & level_mask(level)));
+                return;
+            }
+        }
+
+        // 超出顶层范围: 放在最晚级联的顶层槽位, 级联时重新计算
+        constexpr std::size_t top = levels - 1;
+        link(index, offsets[top] + (((m_now >> shifts[top]) - 1) & level_mask(top)));
+    }
+    // 释放节点并取出任务
+    auto release(std::uint32_t index) noexcept -> Job {
+        Node& node = m_nodes[index];
+        Job job = std::move(node.job);
+        node.job = nullptr;
+        ++node.generation;
+        node.next = m_free;
+        m_free = index;
+        --m_pending;
+        return job;
+    }
+
+    // 从 current 之后循环查找第一个非空槽位, 返回距离 (1..位数), 0 表示全空
+    static auto distance_to_next(std::span<const std::uint64_t> words, std::size_t current) noexcept -> std::size_t {
+        const std::size_t bits = words.size() * 64;
+        std::size_t pos = (current + 1) % bits;
+
+        for (std::size_t scanned = 0; scanned <= bits; ) {
+            std::uint64_t word = words[pos / 64] >> (pos % 64);
+            if (word != 0) {
+                std::size_t found = pos + static_cast<std::size_t>(std::countr_zero(word));
+                return (found + bits - current - 1) % bits + 1;
+            }
+            std::size_t step = 64 - pos % 64;
+            scanned += step;
+            pos = (pos + step) % bits;
+        }
+        return 0;
+    }
+    // 下一个需要处理的 tick (到期或级联), 没有任务时返回 never
+    [[nodiscard]] auto next_event() const noexcept -> std::uint64_t {
+        std::uint64_t next = never;
+        for (std::size_t level = 0; level < levels; ++level) {
+            auto words = std::span<const std::uint64_t>{m_occupied}.subspan(offsets[level] / 64, (level_mask(level) + 1 + 63) / 64);
+            auto current = static_cast<std::size_t>((m_now >> shifts[level]) & level_mask(level));
+
+            if (std::size_t distance = distance_to_next(words, current); distance != 0) {
+                // 第 0 层是到期时刻, 其余层是该槽位的级联时刻
+                std::uint64_t tick = ((m_now >> shifts[level]) + distance) << shifts[level];
+                next = std::min(next, tick);
+            }
+        }
+        return next;
+    }
+    // 推进到 target, 到期任务移入 due
+    void advance(std::uint64_t target, std::vector<Job>& due) {
+        // 只在有事件的 tick 上停留, 中间的空 tick 直接跳过
+        for (;;) {
+            std::uint64_t next = next_event();
+            if (next > target) {
+                m_now = std::max(m_now, target);
+                return;
+            }
+            process(next, due);
+        }
+    }
+    void process(std::uint64_t tick, std::vector<Job>& due) {
+        m_now = tick;
+
+        // 先级联高层, 下放的任务可能正好落入本 tick 的第 0 层槽位
+        for (std::size_t level = levels - 1; level >= 1; --level) {
+            if ((tick & ((std::uint64_t{1} << shifts[level]) - 1)) != 0) continue;
+
+            Slot& list = m_slots[offsets[level] + ((tick >> shifts[level]) & level_mask(level))];
+            std::uint32_t index = list.head;
+            while (index != npos) {
+                std::uint32_t next = m_nodes[index].next;
+                unlink(index);
+                place(index);
+                index = next;
+            }
+        }
+
+        Slot& list = m_slots[tick & level_mask(0)];
+        std::uint32_t index = list.head;
+        while (index != npos) {
+            std::uint32_t next = m_nodes[index].next;
+            unlink(index);
+            due.push_back(release(index));
+            index = next;
+        }
+    }
+
+    void run() {
+        std::vector<Job> due;
+        std::unique_lock<std::mutex> lock{m_mutex};
+
+        while (!m_stop) {
+            advance(current_tick(), due);
+
+            if (!due.empty()) {
+                lock.unlock();
+                for (auto& job: due) job();
+                due.clear();
+                lock.lock();
+                continue;
+            }
+
+            std::uint64_t next = next_event();
+            m_wake_tick = next;
+            if (next == never) m_cond.wait(lock);
+            else m_cond.wait_until(lock, time_of(next));
+            m_wake_tick = 0;
+        }
+    }
+
+    Clock::duration m_tick;
+    Clock::time_point m_epoch;
+
+    std::vector<Node> m_nodes;
+    std::uint32_t m_free{npos};
+    std::array<Slot, slot_count> m_slots{};
+    std::array<std::uint64_t, slot_count / 64> m_occupied{};
+    std::uint64_t m_now{0};
+    std::size_t m_pending{0};
+    // 计时线程计划醒来的 tick; 线程运行中为 0, 此时登记任务无需唤醒
+    std::uint64_t m_wake_tick{0};
+    bool m_stop{false};
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::thread m_thread;
+};
+
+// 进程内共享的计时器, 首次使用时启动计时线程
+inline auto default_timer() -> TimerWheel& {
+    static TimerWheel timer;
+    return timer;
+}
+
+template <typename Rep, typename Period>
+auto schedule_after(std::chrono::duration<Rep, Period> delay, TimerWheel::Job job) -> TimerId {
+    return default_timer().schedule_after(delay, std::move(job));
+}
+
+// co_await sleep_for(d): 在共享计时线程上恢复
+template <typename Rep, typename Period>
+[[nodiscard]] auto sleep_for(std::chrono::duration<Rep, Period> delay) -> TimerWheel::SleepAwaiter<> {
+    return default_timer().sleep_for(delay);
+}
+
+// co_await sleep_for(d, executor): 到期后交给 executor 恢复, 不占用计时线程
+template <typename Rep, typename Period, CoroutineExecutor Executor>
+[[nodiscard]] auto sleep_for(std::chrono::duration<Rep, Period> delay, Executor& executor) -> TimerWheel::SleepAwaiter<Executor> {
+    return default_timer().sleep_for(delay, executor);
+}
+
+} // namespace v2
+} // namespace labelimg::core::queue
+
+#endif // TIMER_WHEEL_HPP
@@ -8,6 +8,9 @@
 
 #include <QDebug>
 #include <core/async_logger.h>
+#include <core/formatter/log_level.h>
+#include <core/log_throttle.hpp>
+#include <core/site_logger.hpp>
 #include <tuple>
 
 #if defined (USE_STD_FMT)
@@ -24,6 +27,38 @@ namespace app_format_ns = fmt;
 template <typename... Args>
 using app_format_string = app_format_ns::format_string<Args...>;
 
+namespace labelimg::core::logger {
+inline namespace v2 {
+
+// QString 在调用线程按 UTF-16 原样拷贝 (只有一次 memcpy), 在日志线程转换为 UTF-8
+template <>
+struct LogArgCodec<QString> {
+    using decoded_type = std::string;
+
+    static auto size(const QString& text) noexcept -> size_t {
+        return sizeof(std::uint32_t) + static_cast<size_t>(text.size()) * sizeof(char16_t);
+    }
+
+    static auto encode(std::byte* out, const QString& text) noexcept -> std::byte* {
+        const auto length = static_cast<std::uint32_t>(text.size());
+        out = detail::store(out, length);
+        std::memcpy(out, text.utf16(), length * sizeof(char16_t));
+        return out + length * sizeof(char16_t);
+    }
+
+    static auto decode(const std::byte*& in) -> std::string {
+        auto length = detail::load<std::uint32_t>(in);
+        // 记录中的数据不保证按 char16_t 对齐, 先拷贝出来
+        std::u16string utf16(length, u'\0');
+        std::memcpy(utf16.data(), in, length * sizeof(char16_t));
+        in += length * sizeof(char16_t);
+        return QString::fromUtf16(utf16.data(), static_cast<qsizetype>(length)).toStdString();
+    }
+};
+
+} // namespace v2
+} // namespace labelimg::core::logger
+
 namespace labelimg::qtils::logger {
 
 namespace detail {
@@ -282,18 +317,15 @@ using LoggerRetType = std::conditional_t<is_test_build, bool, void>;
 
 #if defined(USE_STD_FMT) || defined(USE_EXTERNAL_FMT)
 
-enum class LogLevel: std::int8_t {
-    INFO,
-    SUCCESS,
-    WARNING,
-    ERROR,
-    FATAL_ERROR
-};
+using core::formatter::LogLevel;
+using core::formatter::LogCategory;
+using core::formatter::LogFilter;
 
 constexpr auto 
 level2style(LogLevel level) 
 noexcept -> console_style::PresetStyle {
     switch (level) {
+        case LogLevel::DEBUG:       return console_style::PresetStyle::B_BLUE;
         case LogLevel::INFO:        return console_style::PresetStyle::B_GREEN;
         case LogLevel::SUCCESS:     return console_style::PresetStyle::B_CYAN;
         case LogLevel::WARNING:     return console_style::PresetStyle::B_YELLOW;
@@ -368,49 +400,183 @@ template <typename T>
     }
 }
 
-template<LogLevel level, typename... Args>
-auto logg( app_format_string<fmt_arg_type_t<Args>...> fmt_str
-         , Args&&... args
-         ) -> decltype(auto) {
+namespace detail {
+
+// 按终端宽度分行, 每行加上级别标签 (续行用等宽缩进) 与颜色, 行间以换行分隔, 末尾不带换行
+template <LogLevel level>
+void append_styled_lines(std::string_view message, fmt::memory_buffer& out) {
     constexpr auto style = log_level_traits<level>::value.style_;
     constexpr auto tag   = log_level_traits<level>::value.tag_;
-    
-    std::string formatted_message = app_format_ns::format(
-        fmt_str, 
-        transform_arg_for_fmt(std::forward<Args>(args))...
-    );
-    
+
 #if defined(TERM_OUTPUT_MESSAGE_MAX_LENGTH)
     constexpr size_t MAX_LINE_WIDTH = TERM_OUTPUT_MESSAGE_MAX_LENGTH;
 #else
     constexpr size_t MAX_LINE_WIDTH = 80;
 #endif
 
-    auto lines = detail::split_string_by_width(formatted_message, MAX_LINE_WIDTH);
+    auto append = [&](std::string_view text) { out.append(text.data(), text.data() + text.size()); };
+    auto lines = split_string_by_width(message, MAX_LINE_WIDTH);
+    std::string indent = create_indent_from(tag);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (i != 0) out.push_back('\n');
+        append(console_style::get_preset_style_code<style>().c_str());
+        append(i == 0 ? tag : std::string_view{indent});
+        append(console_style::get_preset_style_code<console_style::PresetStyle::C_RESET>().c_str());
+        append(lines[i]);
+    }
+}
 
-    using namespace labelimg::core::logger;
+// 日志线程上的延迟格式化入口: 先格式化消息, 再分行着色
+template <LogLevel level, typename... Args>
+void format_deferred_logg(std::string_view format, const std::byte* args, fmt::memory_buffer& out) {
+    fmt::memory_buffer message;
+    core::logger::DeferredFormat<Args...>::format(format, args, message);
+    append_styled_lines<level>({message.data(), message.size()}, out);
+    out.push_back('\n');
+}
 
-    if (!lines.empty())
-        async_log << console_style::get_preset_style_code<style>().c_str() << tag
-                  << console_style::get_preset_style_code<console_style::PresetStyle::C_RESET>().c_str()
-                  << lines[0];
-    
-    if (lines.size() > 1) {
-        std::string indent = detail::create_indent_from(tag);
-        for (size_t i = 1; i < lines.size(); ++i)     
-                async_log << console_style::get_preset_style_code<style>().c_str() << indent
-                  << console_style::get_preset_style_code<console_style::PresetStyle::C_RESET>().c_str()
-                  << lines[i];
+} // namespace detail
+
+namespace detail {
+
+template<LogLevel level, typename... Args>
+void write_logg(app_format_string<fmt_arg_type_t<Args>...> fmt_str, Args&&... args) {
+    std::string formatted_message = app_format_ns::format(
+        fmt_str, 
+        transform_arg_for_fmt(std::forward<Args>(args))...
+    );
+
+    fmt::memory_buffer styled;
+    detail::append_styled_lines<level>(formatted_message, styled);
+
+    // 多行消息写入同一条记录, 只提交一次
+    core::logger::LogStream{level} << std::string_view{styled.data(), styled.size()};
+}
+
+// 汇总行与 (decision.emit 时的) 消息合并为一条记录提交
+template<LogLevel level>
+void write_throttle_decision(const core::logger::ThrottleDecision& decision, std::string_view message) {
+    fmt::memory_buffer styled;
+    auto append_line = [&styled](std::string_view line) {
+        if (styled.size() != 0) styled.push_back('\n');
+        detail::append_styled_lines<level>(line, styled);
+    };
+    if (decision.repeated != 0)
+        append_line(app_format_ns::format("last message repeated {} times", decision.repeated));
+    if (decision.suppressed != 0)
+        append_line(app_format_ns::format("{} messages suppressed by rate limit", decision.suppressed));
+    if (decision.emit) append_line(message);
+
+    core::logger::LogStream{level} << std::string_view{styled.data(), styled.size()};
+}
+
+// 先按格式化后的内容过一遍调用点的限流与去重
+template<LogLevel level, typename... Args>
+void write_logg_throttled( core::logger::LogThrottle& throttle
+                         , app_format_string<fmt_arg_type_t<Args>...> fmt_str
+                         , Args&&... args) {
+    std::string formatted_message = app_format_ns::format(
+        fmt_str,
+        transform_arg_for_fmt(std::forward<Args>(args))...
+    );
+
+    const auto decision = throttle.admit(formatted_message);
+    if (!decision.emit && !decision.has_report()) return;
+
+    write_throttle_decision<level>(decision, formatted_message);
+}
+
+// LogThrottle 的 reporter: 调用点停止写日志后, 由共享计时器或日志停止时写出未报告的计数
+template<LogLevel level>
+void report_throttled(const core::logger::ThrottleDecision& decision) {
+    write_throttle_decision<level>(decision, {});
+}
+
+} // namespace detail
+
+// 级别低于 LOG_MIN_LEVEL 时函数体为空; 否则先检查分类阈值, 关闭时不做任何格式化.
+// 参数表达式仍在调用处求值, 需要连同参数一起跳过时使用 LOGG / LOGG_CAT
+template<LogLevel level, LogCategory category = LogCategory::GENERAL, typename... Args>
+auto logg( app_format_string<fmt_arg_type_t<Args>...> fmt_str
+         , Args&&... args
+         ) -> decltype(auto) {
+    if constexpr (core::formatter::log_level_compiled<level>) {
+        if (LogFilter::enabled(category, level))
+            detail::write_logg<level>(fmt_str, std::forward<Args>(args)...);
     }
 
+    if constexpr (is_test_build) 
+        return static_cast<LoggerRetType>(LoggerRetType(true));
+}
+
+// 限流版本: throttle 通常由 LOGG_THROTTLED / LOG_THROTTLE_AT_SITE 在调用处定义, 每个调用点一份.
+// 与上一条相同的消息只计数, 内容变化或到了报告间隔时写出 "last message repeated N times"
+template<LogLevel level, LogCategory category = LogCategory::GENERAL, typename... Args>
+auto logg_throttled( core::logger::LogThrottle& throttle
+                   , app_format_string<fmt_arg_type_t<Args>...> fmt_str
+                   , Args&&... args
+                   ) -> decltype(auto) {
+    if constexpr (core::formatter::log_level_compiled<level>) {
+        if (LogFilter::enabled(category, level))
+            detail::write_logg_throttled<level>(throttle, fmt_str, std::forward<Args>(args)...);
+    }
 
     if constexpr (is_test_build) 
         return static_cast<LoggerRetType>(LoggerRetType(true));
 }
 
+// 延迟格式化版本: 调用线程只拷贝格式串指针和参数的二进制编码 (QString 按 UTF-16 原样拷贝),
+// 格式化, 分行和着色都在日志线程完成, 适合 UI 线程上的高频日志
+template<LogLevel level, LogCategory category = LogCategory::GENERAL, typename... Args>
+auto logg_deferred( core::logger::deferred_format_string<Args...> fmt_str
+                  , const Args&... args
+                  ) -> decltype(auto) {
+    if constexpr (core::formatter::log_level_compiled<level>) {
+        if (LogFilter::enabled(category, level)) {
+            core::logger::ThreadRingAsyncLogger::instance().write_deferred<Args...>(
+                level, &detail::format_deferred_logg<level, Args...>, fmt_str, args...);
+        }
+    }
 
+    if constexpr (is_test_build) 
+        return static_cast<LoggerRetType>(LoggerRetType(true));
+}
+
+// 调用点日志的文本格式: 与 logg_deferred 相同的分行与着色
+template <LogLevel level>
+struct StyledLineFormat {
+    template <typename... Args>
+    static constexpr core::logger::DeferredFormatter formatter = &detail::format_deferred_logg<level, Args...>;
+};
 
 #endif
 } // namespace labelimg::qtils::logger
 
+// 调用点版本的 logg_deferred: 级别, 文件, 行号, 函数名和格式串在首次执行时注册一次,
+// 打开二进制日志 (ThreadRingAsyncLogger::open_binary_log) 后每条记录只写调用点 id、时间戳和参数.
+// 级别关闭时参数不求值, 调用点也不注册
+//     LOGG(LogLevel::INFO, "Dir path: {}", path);
+//     LOGG_CAT(LogCategory::WIDGET, LogLevel::DEBUG, "file name: {}", file);
+#define LOGG_CAT(category, level, format, ...)                                         \
+    LOG_IF_ENABLED(category, level,                                                    \
+        LOG_AT_SITE(::labelimg::qtils::logger::StyledLineFormat<level>, level,         \
+                    ::magic_enum::enum_name<level>(), format __VA_OPT__(,) __VA_ARGS__))
+
+#define LOGG(level, format, ...) \
+    LOGG_CAT(::labelimg::core::formatter::LogCategory::GENERAL, level, format __VA_OPT__(,) __VA_ARGS__)
+
+// 按调用点限流与去重的 logg (默认 ThrottlePolicy), 用于鼠标事件、逐文件处理等可能刷屏的路径.
+// 需要内容去重, 因此在调用线程格式化; 级别关闭时参数不求值.
+// 刷屏停止后, 未报告的重复 / 丢弃计数在 report_interval 后 (或日志停止时) 单独写出
+//     LOGG_THROTTLED_CAT(LogCategory::WIDGET, LogLevel::DEBUG, "file name: {}", file);
+#define LOGG_THROTTLED_CAT(category, level, format, ...)                                      \
+    LOG_IF_ENABLED(category, level,                                                          \
+        LOG_THROTTLE_AT_SITE(_log_throttle, {},                                              \
+            &::labelimg::qtils::logger::detail::report_throttled<level>);                    \
+        ::labelimg::qtils::logger::logg_throttled<level, category>(                          \
+            _log_throttle, format __VA_OPT__(,) __VA_ARGS__))
+
+#define LOGG_THROTTLED(level, format, ...) \
+    LOGG_THROTTLED_CAT(::labelimg::core::formatter::LogCategory::GENERAL, level, format __VA_OPT__(,) __VA_ARGS__)
+
 #endif // LOGGER_HPP
@@ -51,11 +51,17 @@ void AsyncLogger::log(std::string message) {
 }
 }  // namespace v1
 
-LogStream::LogStream() = default;
+LogStream::LogStream(LogLevel level): m_buffer{detail::log_buffer()}, m_begin{m_buffer.size()}, m_level{level} {}
 
 LogStream::~LogStream() {
-     m_oss << '\n';
-     AsyncLogger<queue::CoroutinePolicy>::instance().log_impl(m_oss.str());
+    m_buffer.push_back('\n');
+    const std::string_view text{m_buffer.data() + m_begin, m_buffer.size() - m_begin};
+    // 入队前先写入飞行记录, 崩溃时仍在队列中的日志不会丢失
+    flight_record(text);
+
+    // 与 LOGG / logg_deferred 走同一个后端: 标准输出只有一个写入者, 同一线程的记录保持先后顺序
+    ThreadRingAsyncLogger::instance().write(text, m_level);
+    m_buffer.resize(m_begin);
 }
 
 } // namespace labelimg::core::logger
\ No newline at end of file
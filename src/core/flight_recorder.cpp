@@ -0,0 +1,213 @@
+#include <core/flight_recorder.hpp>
+#include <bit>
+#include <mutex>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace labelimg::core::logger {
+
+namespace {
+
+// 整个文件的可写共享映射; 进程退出后由内核写回
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    ~MappedFile() { close(); }
+
+    // 打开并映射 size 字节; 文件原有大小不同时调整为 size, existing 表示原大小是否一致
+    auto open(const std::filesystem::path& path, size_t size, bool& existing) -> bool;
+    void close();
+
+    [[nodiscard]] auto data() const noexcept -> char* { return m_data; }
+private:
+    char*  m_data = nullptr;
+    size_t m_size = 0;
+#if defined(_WIN32)
+    HANDLE m_file    = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+};
+
+#if defined(_WIN32)
+
+auto MappedFile::open(const std::filesystem::path& path, size_t size, bool& existing) -> bool {
+    m_file = ::CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                           nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER current{};
+    existing = ::GetFileSizeEx(m_file, &current) && static_cast<std::uint64_t>(current.QuadPart) == size;
+
+    const auto high = static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32);
+    const auto low  = static_cast<DWORD>(size & 0xFFFFFFFFu);
+    m_mapping = ::CreateFileMappingW(m_file, nullptr, PAGE_READWRITE, high, low, nullptr);
+    if (m_mapping == nullptr) return false;
+
+    m_data = static_cast<char*>(::MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, size));
+    m_size = size;
+    return m_data != nullptr;
+}
+
+void MappedFile::close() {
+    if (m_data != nullptr) ::UnmapViewOfFile(m_data);
+    if (m_mapping != nullptr) ::CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE) ::CloseHandle(m_file);
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+auto MappedFile::open(const std::filesystem::path& path, size_t size, bool& existing) -> bool {
+    int fd;
+    do { fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644); } while (fd < 0 && errno == EINTR);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    existing = ::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) == size;
+    if (!existing && ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // 映射建立后不再需要文件描述符
+    ::close(fd);
+    if (data == MAP_FAILED) return false;
+
+    m_data = static_cast<char*>(data);
+    m_size = size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data != nullptr) ::munmap(m_data, m_size);
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+} // namespace
+
+inline namespace v2 {
+
+class FlightRecorder::Impl {
+public:
+    explicit Impl(FlightRecorderOptions options): m_options{std::move(options)} {
+        m_slot_size = std::bit_floor(std::max(m_options.slot_size, sizeof(detail::FlightSlotHeader) * 2));
+        m_payload   = m_slot_size - sizeof(detail::FlightSlotHeader);
+        m_slot_count = m_options.capacity / m_slot_size;
+        if (m_slot_count == 0) return;
+
+        bool existing = false;
+        if (!m_file.open(m_options.path, sizeof(detail::FlightRecorderHeader) + m_slot_count * m_slot_size, existing)) {
+            m_file.close();
+            return;
+        }
+
+        auto* header = reinterpret_cast<detail::FlightRecorderHeader*>(m_file.data());
+        const bool compatible = existing
+            && std::string_view{header->magic, sizeof(header->magic)} == detail::flight_recorder_magic
+            && header->version == detail::flight_recorder_version
+            && header->slot_size == m_slot_size
+            && header->slot_count == m_slot_count;
+
+        // 布局不同 (或是新文件) 时清空全部槽, 否则接着上次的序号写入
+        if (!compatible) {
+            std::memset(m_file.data(), 0, sizeof(detail::FlightRecorderHeader) + m_slot_count * m_slot_size);
+            std::memcpy(header->magic, detail::flight_recorder_magic.data(), sizeof(header->magic));
+            header->version    = detail::flight_recorder_version;
+            header->slot_size  = static_cast<std::uint32_t>(m_slot_size);
+            header->slot_count = m_slot_count;
+        }
+        m_next  = &header->next_sequence;
+        m_slots = m_file.data() + sizeof(detail::FlightRecorderHeader);
+    }
+
+    [[nodiscard]] auto is_open() const noexcept -> bool { return m_slots != nullptr; }
+    [[nodiscard]] auto path() const noexcept -> const std::filesystem::path& { return m_options.path; }
+    [[nodiscard]] auto slot_count() const noexcept -> size_t { return is_open() ? m_slot_count : 0; }
+
+    void record(std::string_view text) noexcept {
+        if (m_slots == nullptr || text.empty()) return;
+
+        size_t slots = (text.size() + m_payload - 1) / m_payload;
+        if (slots > m_slot_count) {
+            slots = m_slot_count;
+            text.remove_prefix(text.size() - slots * m_payload);
+        }
+
+        // 一次原子加预留连续的序号, 多个线程互不等待
+        const std::uint64_t first = std::atomic_ref{*m_next}.fetch_add(slots, std::memory_order_relaxed);
+        for (size_t i = 0; i < slots; ++i) {
+            const std::uint64_t sequence = first + i;
+            auto* slot = reinterpret_cast<detail::FlightSlotHeader*>(m_slots + (sequence % m_slot_count) * m_slot_size);
+            const auto chunk = text.substr(i * m_payload, m_payload);
+
+            std::atomic_ref{slot->sequence}.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::memcpy(reinterpret_cast<char*>(slot) + sizeof(detail::FlightSlotHeader), chunk.data(), chunk.size());
+            slot->size  = static_cast<std::uint32_t>(chunk.size());
+            slot->flags = static_cast<std::uint16_t>((i == 0 ? detail::flight_slot_first : 0)
+                                                   | (i + 1 == slots ? detail::flight_slot_last : 0));
+
+            std::atomic_ref{slot->sequence}.store(sequence + 1, std::memory_order_release);
+        }
+    }
+private:
+    FlightRecorderOptions m_options;
+    size_t m_slot_size  = 0;
+    size_t m_payload    = 0;
+    size_t m_slot_count = 0;
+
+    MappedFile m_file;
+    std::uint64_t* m_next  = nullptr;
+    char*          m_slots = nullptr;
+};
+
+FlightRecorder::FlightRecorder(FlightRecorderOptions options)
+    : pImpl{std::make_unique<Impl>(std::move(options))} {}
+
+FlightRecorder::~FlightRecorder() = default;
+
+auto FlightRecorder::is_open() const noexcept -> bool { return pImpl->is_open(); }
+
+auto FlightRecorder::path() const noexcept -> const std::filesystem::path& { return pImpl->path(); }
+
+auto FlightRecorder::slot_count() const noexcept -> size_t { return pImpl->slot_count(); }
+
+void FlightRecorder::record(std::string_view text) noexcept { pImpl->record(text); }
+
+void FlightRecorder::write(std::span<const LogRecord> records) {
+    for (const auto& record: records) pImpl->record(record.text);
+}
+
+void FlightRecorder::install(std::shared_ptr<FlightRecorder> recorder) {
+    // 有意不析构: 退出阶段仍在记录的线程不会访问已释放的记录器
+    static std::mutex mutex;
+    static auto* retained = new std::vector<std::shared_ptr<FlightRecorder>>;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    s_active.store(recorder.get(), std::memory_order_release);
+    if (recorder) retained->push_back(std::move(recorder));
+}
+
+} // namespace v2
+} // namespace labelimg::core::logger
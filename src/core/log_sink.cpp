@@ -0,0 +1,442 @@
+#include <core/log_sink.hpp>
+#include <core/message_queue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <fmt/format.h>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <climits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace labelimg::core::logger {
+
+namespace {
+
+#if defined(_WIN32)
+
+struct IoSlice {
+    const char* data;
+    size_t size;
+};
+
+auto make_slice(std::string_view text) -> IoSlice { return {text.data(), text.size()}; }
+
+auto open_append(const std::filesystem::path& path, bool truncate) -> int {
+    int flags = _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY | _O_NOINHERIT;
+    if (truncate) flags |= _O_TRUNC;
+    return ::_wopen(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+}
+
+auto file_size(int fd) -> std::uint64_t {
+    struct _stat64 info{};
+    return ::_fstat64(fd, &info) == 0 ? static_cast<std::uint64_t>(info.st_size) : 0;
+}
+
+void close_file(int fd) { ::_close(fd); }
+
+// 没有 writev, 逐段写出
+auto write_slices(int fd, std::span<IoSlice> slices) -> bool {
+    for (const auto& slice: slices) {
+        size_t offset = 0;
+        while (offset < slice.size) {
+            const auto chunk = static_cast<unsigned>(std::min<size_t>(slice.size - offset, 1u << 30));
+            const int written = ::_write(fd, slice.data + offset, chunk);
+            if (written < 0) return false;
+            offset += static_cast<size_t>(written);
+        }
+    }
+    return true;
+}
+
+#else
+
+using IoSlice = ::iovec;
+
+auto make_slice(std::string_view text) -> IoSlice {
+    return {const_cast<char*>(text.data()), text.size()};
+}
+
+auto open_append(const std::filesystem::path& path, bool truncate) -> int {
+    int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC;
+    if (truncate) flags |= O_TRUNC;
+    int fd;
+    do { fd = ::open(path.c_str(), flags, 0644); } while (fd < 0 && errno == EINTR);
+    return fd;
+}
+
+auto file_size(int fd) -> std::uint64_t {
+    struct ::stat info{};
+    return ::fstat(fd, &info) == 0 ? static_cast<std::uint64_t>(info.st_size) : 0;
+}
+
+void close_file(int fd) { ::close(fd); }
+
+// 每次最多 IOV_MAX 段; 部分写入时跳过已写完的段, 调整当前段后继续
+auto write_slices(int fd, std::span<IoSlice> slices) -> bool {
+    while (!slices.empty()) {
+        const auto count = static_cast<int>(std::min<size_t>(slices.size(), IOV_MAX));
+        const ::ssize_t written = ::writev(fd, slices.data(), count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        auto remaining = static_cast<size_t>(written);
+        while (!slices.empty() && remaining >= slices.front().iov_len) {
+            remaining -= slices.front().iov_len;
+            slices = slices.subspan(1);
+        }
+        if (remaining > 0) {
+            slices.front().iov_base = static_cast<char*>(slices.front().iov_base) + remaining;
+            slices.front().iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+#endif
+
+} // namespace
+
+inline namespace v2 {
+
+void ConsoleSink::write(std::span<const LogRecord> records) {
+    for (const auto& record: records)
+        std::cout.write(record.text.data(), static_cast<std::streamsize>(record.text.size()));
+}
+
+void ConsoleSink::flush() {
+    std::cout.flush();
+}
+
+class FileSink::Impl {
+public:
+    explicit Impl(FileSinkOptions options): m_options{std::move(options)} {
+        open(false);
+    }
+
+    ~Impl() {
+        flush();
+        if (m_fd >= 0) close_file(m_fd);
+    }
+
+    void write(std::span<const LogRecord> records) {
+        size_t batch_bytes = 0;
+        LogLevel level = LogLevel::DEBUG;
+        for (const auto& record: records) {
+            batch_bytes += record.text.size();
+            level = std::max(level, record.level);
+        }
+        if (batch_bytes == 0) return;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (m_pending.size() == 0) m_pending_since = now;
+
+        const bool due = m_pending.size() + batch_bytes >= m_options.flush_bytes
+                      || level >= m_options.flush_level
+                      || now - m_pending_since >= m_options.flush_interval;
+        if (!due) {
+            for (const auto& record: records) m_pending.append(record.text.data(), record.text.data() + record.text.size());
+            return;
+        }
+
+        write_out(records, batch_bytes, now);
+    }
+
+    void flush() {
+        if (m_pending.size() == 0) return;
+        write_out({}, 0, std::chrono::steady_clock::now());
+    }
+
+    void rotate() {
+        flush();
+        rotate_files();
+    }
+
+    [[nodiscard]] auto is_open() const noexcept -> bool { return m_fd >= 0; }
+    [[nodiscard]] auto path() const noexcept -> const std::filesystem::path& { return m_options.path; }
+    [[nodiscard]] auto file_bytes() const noexcept -> std::uint64_t { return m_file_bytes; }
+    [[nodiscard]] auto pending_bytes() const noexcept -> size_t { return m_pending.size(); }
+    [[nodiscard]] auto write_calls() const noexcept -> std::uint64_t { return m_write_calls; }
+private:
+    void open(bool truncate) {
+        m_fd = open_append(m_options.path, truncate);
+        m_file_bytes = m_fd >= 0 ? file_size(m_fd) : 0;
+        m_opened_at = std::chrono::steady_clock::now();
+    }
+
+    // 缓冲区在前, 当前批次各条记录在后, 一次写出; 一批内容不会跨两个文件
+    void write_out(std::span<const LogRecord> records, size_t batch_bytes, std::chrono::steady_clock::time_point now) {
+        const size_t total = m_pending.size() + batch_bytes;
+        if (should_rotate(total, now)) rotate_files();
+
+        m_slices.clear();
+        if (m_pending.size() != 0) m_slices.push_back(make_slice({m_pending.data(), m_pending.size()}));
+        for (const auto& record: records) {
+            if (!record.text.empty()) m_slices.push_back(make_slice(record.text));
+        }
+
+        if (m_fd >= 0 && write_slices(m_fd, m_slices)) m_file_bytes += total;
+        ++m_write_calls;
+        m_pending.clear();
+    }
+
+    [[nodiscard]] auto should_rotate(size_t incoming, std::chrono::steady_clock::time_point now) const -> bool {
+        // 空文件不轮转, 单批超过上限时也只写入一个文件
+        if (m_file_bytes == 0) return false;
+        if (m_options.rotate_bytes != 0 && m_file_bytes + incoming > m_options.rotate_bytes) return true;
+        return m_options.rotate_interval.count() != 0 && now - m_opened_at >= m_options.rotate_interval;
+    }
+
+    // path.(N-1) -> path.N, ..., path -> path.1, 然后重新打开 path; 最旧的文件被覆盖
+    void rotate_files() {
+        if (m_fd >= 0) close_file(m_fd);
+        m_fd = -1;
+
+        if (m_options.max_files == 0) {
+            open(true);
+            return;
+        }
+
+        std::error_code ignored;
+        for (size_t index = m_options.max_files - 1; index >= 1; --index)
+            std::filesystem::rename(numbered(index), numbered(index + 1), ignored);
+        std::filesystem::rename(m_options.path, numbered(1), ignored);
+        open(false);
+    }
+
+    [[nodiscard]] auto numbered(size_t index) const -> std::filesystem::path {
+        std::filesystem::path result = m_options.path;
+        result += fmt::format(".{}", index);
+        return result;
+    }
+
+    FileSinkOptions m_options;
+    int m_fd = -1;
+    std::uint64_t m_file_bytes = 0;
+    std::uint64_t m_write_calls = 0;
+    std::chrono::steady_clock::time_point m_opened_at;
+
+    // 未达到写出条件的小批次先拷贝到这里
+    fmt::memory_buffer m_pending;
+    std::chrono::steady_clock::time_point m_pending_since;
+    std::vector<IoSlice> m_slices;
+};
+
+FileSink::FileSink(FileSinkOptions options): pImpl{std::make_unique<Impl>(std::move(options))} {}
+
+FileSink::~FileSink() = default;
+
+auto FileSink::is_open() const noexcept -> bool { return pImpl->is_open(); }
+
+auto FileSink::path() const noexcept -> const std::filesystem::path& { return pImpl->path(); }
+
+auto FileSink::file_bytes() const noexcept -> std::uint64_t { return pImpl->file_bytes(); }
+
+auto FileSink::pending_bytes() const noexcept -> size_t { return pImpl->pending_bytes(); }
+
+auto FileSink::write_calls() const noexcept -> std::uint64_t { return pImpl->write_calls(); }
+
+void FileSink::write(std::span<const LogRecord> records) { pImpl->write(records); }
+
+void FileSink::flush() { pImpl->flush(); }
+
+void FileSink::rotate() { pImpl->rotate(); }
+
+RingSink::RingSink(size_t capacity): m_data(std::max<size_t>(capacity, 1)) {}
+
+void RingSink::write(std::span<const LogRecord> records) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    for (const auto& record: records) append(record.text);
+}
+
+// 超过容量的文本只保留末尾部分; 分两段拷贝处理回绕
+void RingSink::append(std::string_view text) {
+    const size_t capacity = m_data.size();
+    if (text.size() >= capacity) {
+        text.remove_prefix(text.size() - capacity);
+        m_wrapped = true;
+    }
+
+    const size_t first = std::min(text.size(), capacity - m_head);
+    std::copy_n(text.data(), first, m_data.data() + m_head);
+    std::copy_n(text.data() + first, text.size() - first, m_data.data());
+
+    if (m_head + text.size() >= capacity) m_wrapped = true;
+    m_head = (m_head + text.size()) % capacity;
+}
+
+auto RingSink::snapshot() const -> std::string {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (!m_wrapped) return {m_data.data(), m_head};
+
+    std::string result;
+    result.reserve(m_data.size());
+    result.append(m_data.data() + m_head, m_data.size() - m_head);
+    result.append(m_data.data(), m_head);
+
+    const size_t line_end = result.find('\n');
+    result.erase(0, line_end == std::string::npos ? result.size() : line_end + 1);
+    return result;
+}
+
+class FanoutSink::Impl {
+public:
+    Impl() = default;
+
+    // 队列满时推入停止标记会按 DropOldest 淘汰一个真实批次, 因此先等各队列排空, 再推入标记
+    ~Impl() {
+        wait_idle();
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for (auto& branch: m_branches) branch->queue.push(nullptr);
+        for (auto& branch: m_branches) {
+            if (branch->worker.joinable()) branch->worker.join();
+        }
+    }
+
+    auto add(std::shared_ptr<LogSink> sink, LogLevel min_level) -> size_t {
+        auto branch = std::make_unique<Branch>();
+        branch->sink = std::move(sink);
+        branch->min_level = min_level;
+        branch->worker = std::thread{&Impl::run, std::ref(*branch)};
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_branches.push_back(std::move(branch));
+        return m_branches.size() - 1;
+    }
+
+    // 拷贝到一个共享的批次后按级别分发, 队列满时淘汰最旧的批次, 不会阻塞
+    void write(std::span<const LogRecord> records) {
+        size_t total = 0;
+        LogLevel highest = LogLevel::DEBUG;
+        for (const auto& record: records) {
+            total += record.text.size();
+            highest = std::max(highest, record.level);
+        }
+        if (total == 0) return;
+
+        auto batch = std::make_shared<SharedBatch>();
+        batch->text.reserve(total);
+        batch->entries.reserve(records.size());
+        for (const auto& record: records) {
+            batch->entries.push_back({batch->text.size(), record.text.size(), record.level});
+            batch->text.append(record.text);
+        }
+        BatchPtr shared = std::move(batch);
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for (auto& branch: m_branches) {
+            if (highest < branch->min_level) continue;
+            branch->queue.push(shared);
+            branch->enqueued.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    void wait_idle() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for (auto& branch: m_branches) {
+            const std::uint64_t target = branch->enqueued.load(std::memory_order_acquire);
+            for (;;) {
+                const std::uint64_t completed = branch->completed.load(std::memory_order_acquire);
+                if (completed + branch->queue.dropped_count() >= target) break;
+                branch->completed.wait(completed, std::memory_order_acquire);
+            }
+        }
+    }
+
+    [[nodiscard]] auto dropped(size_t index) const -> size_t {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return index < m_branches.size() ? m_branches[index]->queue.dropped_count() : 0;
+    }
+private:
+    // 多个 sink 共享的一批记录, 写入后不再修改
+    struct SharedBatch {
+        struct Entry {
+            size_t begin;
+            size_t size;
+            LogLevel level;
+        };
+
+        std::string text;
+        std::vector<Entry> entries;
+    };
+    using BatchPtr = std::shared_ptr<const SharedBatch>;
+
+    static constexpr size_t queue_capacity = 1024;
+    using BranchQueue = queue::MessageQueue<BatchPtr,
+        queue::BoundedMutexPolicy<queue_capacity, queue::OverflowPolicy::DropOldest, queue::AtomicWait>>;
+
+    struct Branch {
+        std::shared_ptr<LogSink> sink;
+        LogLevel min_level;
+        BranchQueue queue;
+        std::atomic<std::uint64_t> enqueued{0};
+        std::atomic<std::uint64_t> completed{0};
+        std::thread worker;
+    };
+
+    // 每个 sink 的写线程: 取走全部积压的批次一起写出, 队列排空时 flush; 空指针表示停止
+    static void run(Branch& branch) {
+        std::vector<BatchPtr> batches;
+        std::vector<LogRecord> records;
+
+        for (bool stopping = false; !stopping;) {
+            branch.queue.wait_and_drain_into(batches);
+
+            std::uint64_t count = 0;
+            records.clear();
+            for (const auto& batch: batches) {
+                if (batch == nullptr) {
+                    stopping = true;
+                    continue;
+                }
+                ++count;
+                for (const auto& entry: batch->entries) {
+                    if (entry.level < branch.min_level) continue;
+                    records.push_back({std::string_view{batch->text}.substr(entry.begin, entry.size), entry.level});
+                }
+            }
+
+            if (!records.empty()) branch.sink->write(records);
+            if (stopping || branch.queue.empty()) branch.sink->flush();
+            batches.clear();
+
+            branch.completed.fetch_add(count, std::memory_order_release);
+            branch.completed.notify_all();
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<Branch>> m_branches;
+};
+
+FanoutSink::FanoutSink(): pImpl{std::make_unique<Impl>()} {}
+
+FanoutSink::~FanoutSink() = default;
+
+auto FanoutSink::add(std::shared_ptr<LogSink> sink, LogLevel min_level) -> size_t {
+    return pImpl->add(std::move(sink), min_level);
+}
+
+void FanoutSink::write(std::span<const LogRecord> records) { pImpl->write(records); }
+
+void FanoutSink::wait_idle() { pImpl->wait_idle(); }
+
+auto FanoutSink::dropped(size_t index) const -> size_t { return pImpl->dropped(index); }
+
+} // namespace v2
+} // namespace labelimg::core::logger
@@ -0,0 +1,83 @@
+#include <core/log_throttle.hpp>
+#include <core/timer_wheel.hpp>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace labelimg::core::logger {
+
+namespace {
+
+// 登记带 reporter 的调用点. 计时任务只持有调用点的地址, 执行时先在这里确认它仍然存在
+class ThrottleRegistry {
+public:
+    // 有意不析构: 静态析构阶段 (日志后台停止、调用点的静态变量析构) 仍可能访问
+    static auto instance() -> ThrottleRegistry& {
+        static auto* registry = new ThrottleRegistry;
+        return *registry;
+    }
+
+    void add(LogThrottle& throttle) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_throttles.push_back(&throttle);
+    }
+
+    // 调用点析构前写出它未报告的计数; 日志已停止时只注销
+    void remove(LogThrottle& throttle) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (!m_closed) throttle.report_pending();
+        std::erase(m_throttles, &throttle);
+    }
+
+    // 持有登记表的锁执行, 调用点不会在汇总期间析构
+    void report_due(LogThrottle* throttle) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (m_closed || std::ranges::find(m_throttles, throttle) == m_throttles.end()) return;
+        throttle->report_due();
+    }
+
+    void flush(bool close) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (m_closed) return;
+        for (LogThrottle* throttle: m_throttles) throttle->report_pending();
+        m_closed = close;
+    }
+private:
+    std::mutex m_mutex;
+    std::vector<LogThrottle*> m_throttles;
+    bool m_closed = false;
+};
+
+} // namespace
+
+inline namespace v2 {
+
+void flush_throttles() {
+    ThrottleRegistry::instance().flush(false);
+}
+
+} // namespace v2
+
+namespace detail {
+
+void register_throttle(LogThrottle& throttle) {
+    ThrottleRegistry::instance().add(throttle);
+}
+
+void unregister_throttle(LogThrottle& throttle) {
+    ThrottleRegistry::instance().remove(throttle);
+}
+
+void schedule_throttle_report(LogThrottle& throttle, std::chrono::steady_clock::time_point deadline) {
+    queue::default_timer().schedule_at(deadline, [throttle = &throttle] {
+        ThrottleRegistry::instance().report_due(throttle);
+    });
+}
+
+void close_throttles() {
+    ThrottleRegistry::instance().flush(true);
+}
+
+} // namespace detail
+
+} // namespace labelimg::core::logger
@@ -0,0 +1,66 @@
+#include <core/flight_recorder.hpp>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+void print_usage(std::string_view program) {
+    std::cerr << "Usage: " << program << " [-o output] <flight recorder file>\n"
+              << "  -o output   write decoded text to a file instead of stdout\n";
+}
+
+void write_records(std::ostream& out, const std::vector<std::string>& records) {
+    for (const auto& record: records) {
+        out << record;
+        if (!record.ends_with('\n')) out << '\n';
+    }
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    using labelimg::core::logger::FlightRecordReader;
+
+    std::string_view output;
+    std::string_view input;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (input.empty() && !arg.starts_with('-')) {
+            input = arg;
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (input.empty()) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FlightRecordReader reader;
+    if (!reader.open(input)) {
+        std::cerr << input << ": " << reader.error() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if (output.empty()) {
+        std::ios::sync_with_stdio(false);
+        write_records(std::cout, reader.records());
+        std::cout.flush();
+    } else {
+        std::ofstream file{std::string{output}, std::ios::binary | std::ios::trunc};
+        if (!file) {
+            std::cerr << output << ": cannot open for writing\n";
+            return EXIT_FAILURE;
+        }
+        write_records(file, reader.records());
+    }
+
+    if (reader.torn() != 0)
+        std::cerr << input << ": skipped " << reader.torn() << " partially written or overwritten record fragments\n";
+    return EXIT_SUCCESS;
+}
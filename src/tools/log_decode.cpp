@@ -0,0 +1,69 @@
+#include <core/binary_log.hpp>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+void print_usage(std::string_view program) {
+    std::cerr << "Usage: " << program << " [-j threads] [-o output] <binary log>\n"
+              << "  -j threads  number of decoding threads (default: hardware concurrency)\n"
+              << "  -o output   write decoded text to a file instead of stdout\n";
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    using labelimg::core::logger::BinaryLogDecoder;
+
+    unsigned threads = std::thread::hardware_concurrency();
+    std::string_view output;
+    std::string_view input;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "-j" && i + 1 < argc) {
+            std::string_view value = argv[++i];
+            if (std::from_chars(value.data(), value.data() + value.size(), threads).ec != std::errc{}) {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (input.empty() && !arg.starts_with('-')) {
+            input = arg;
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (input.empty()) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    BinaryLogDecoder decoder;
+    if (!decoder.open(input)) {
+        std::cerr << input << ": " << decoder.error() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if (output.empty()) {
+        std::ios::sync_with_stdio(false);
+        decoder.decode(std::cout, threads);
+        std::cout.flush();
+    } else {
+        std::ofstream file{std::string{output}, std::ios::binary | std::ios::trunc};
+        if (!file) {
+            std::cerr << output << ": cannot open for writing\n";
+            return EXIT_FAILURE;
+        }
+        decoder.decode(file, threads);
+    }
+
+    if (decoder.truncated())
+        std::cerr << input << ": last block is incomplete and was skipped\n";
+    return EXIT_SUCCESS;
+}
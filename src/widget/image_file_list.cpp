@@ -39,10 +39,8 @@ void ImageFileList::setup_ui() {
 void ImageFileList::load_directory(const QString& dir_path) {
     clear();
  
-    const std::string path = dir_path.toStdString().c_str();
-
     using namespace labelimg::qtils::logger;
-    logg<LogLevel::INFO>("Dir path: {}", path);
+    LOGG_CAT(LogCategory::WIDGET, LogLevel::INFO, "Dir path: {}", dir_path);
 
     QDir directory{dir_path};
     if (!directory.exists()) return;
@@ -53,13 +51,12 @@ void ImageFileList::load_directory(const QString& dir_path) {
     QStringList files = directory.entryList(filters, QDir::Files, QDir::Name);
 
     if (files.size() == 0) 
-        logg<LogLevel::ERROR>("No files in this dir");
+        LOGG_CAT(LogCategory::WIDGET, LogLevel::ERROR, "No files in this dir");
 
+    // 每个文件一行, 默认阈值 (INFO) 下既不格式化也不拷贝文件名; 打开 DEBUG 时按调用点限流, 大目录不会刷屏
     for (const QString& file: files) {
-        const std::string file_name = file.toStdString();
-        QString file_path = directory.filePath(file);
-        logg<LogLevel::INFO>("file name: {}", file_name);
-        add_file(file_path);
+        LOGG_THROTTLED_CAT(LogCategory::WIDGET, LogLevel::DEBUG, "file name: {}", file);
+        add_file(directory.filePath(file));
     }
 
 }
@@ -131,7 +131,8 @@ void RegionCropper::mouseReleaseEvent(QMouseEvent* event) {
                 else remove_selection_box(m_current_box_id);
             }
             using namespace labelimg::qtils::logger;
-            logg<LogLevel::INFO>("Mouse Released");
+            // 连续框选时同一行只计数, 由限流器汇总为 "repeated N times"
+            LOGG_THROTTLED_CAT(LogCategory::WIDGET, LogLevel::INFO, "Mouse Released");
             
             event->accept();
         } else {
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace test::common::utils {
+
+[[nodiscard]] inline auto current_pid() -> long {
+#ifdef _WIN32
+    return static_cast<long>(::_getpid());
+#else
+    return static_cast<long>(::getpid());
+#endif
+}
+
+// 当前测试用例独占的临时路径: <temp>/<prefix>_<套件>_<用例>_<进程号><extension>
+// 不同用例、并行运行的多个测试进程 (ctest -j) 互不覆盖; 同一用例重复运行时路径不变
+[[nodiscard]] inline auto unique_temp_path(std::string_view prefix, std::string_view extension = {}) -> std::filesystem::path {
+    std::string name{prefix};
+    if (const auto* info = ::testing::UnitTest::GetInstance()->current_test_info()) {
+        name += '_';
+        name += info->test_suite_name();
+        name += '_';
+        name += info->name();
+    }
+    name += '_';
+    name += std::to_string(current_pid());
+    name += extension;
+
+    // 参数化测试的名字带 '/'
+    std::ranges::replace(name, '/', '_');
+    return std::filesystem::temp_directory_path() / name;
+}
+
+} // namespace test::common::utils
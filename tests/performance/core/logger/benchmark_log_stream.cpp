@@ -0,0 +1,392 @@
+// ---------------Logger.LogStream.Performance--------------- //
+//
+//                      Benchmark
+//
+//     Description:
+//          Cost of building one log record: std::ostringstream (old
+//          LogStream) vs thread-local fmt buffer + pooled message string,
+//          and of submitting it to the shared-queue vs per-thread-ring
+//          back ends
+//
+//     Cases:
+//        1. Format:    build the record string only
+//        2. AsyncLog:  build and submit through the async logger
+//                      (1 and 4 producer threads)
+//        3. Deferred:  caller-side cost of eager fmt::format vs binary
+//                      argument capture (formatting on the logger thread)
+//        4. Output:    logger-thread cost and bytes written per record for
+//                      a timestamped text line vs a binary call-site event
+//        5. FileSink:  one write syscall per record vs drained batches
+//                      gathered into a single writev
+//        6. Batch:     joining a batch with std::accumulate vs one
+//                      reserved buffer, adaptive batch size under a burst
+//        7. Flight:    producer-side copy into the memory-mapped flight
+//                      recorder ring (1 and 4 producer threads)
+//        8. Timestamp: ostringstream + localtime + put_time per record vs
+//                      the per-thread cached second prefix
+//
+//     Counters:
+//        allocs_per_record (operator new calls on the logging thread per
+//                           record; the logger's own thread is excluded)
+//        bytes_per_record  (bytes handed to the file per record)
+//        writes_per_record (write syscalls issued by the sink per record)
+//
+//     Target:
+//        Performance Test
+//
+// ----------------------------------------------------------- //
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <core/async_logger.h>
+#include <core/binary_log.hpp>
+#include <core/flight_recorder.hpp>
+#include <core/formatter/timestamp.h>
+#include <core/log_sink.hpp>
+
+using namespace labelimg::core::logger;
+
+namespace {
+
+// 只统计调用线程上的分配, 后台日志线程的分配不计入
+thread_local std::size_t t_allocations = 0;
+
+// 丢弃日志线程写入 std::cout 的内容
+struct NullBuffer: std::streambuf {
+    auto overflow(int_type ch) -> int_type override { return traits_type::not_eof(ch); }
+};
+
+constexpr int    frame   = 42;
+constexpr double score   = 0.875;
+const std::string label  = "annotation_box_with_a_reasonably_long_label";
+const std::filesystem::path image = "/data/labelimg/images/session_0042/frame_000042.png";
+
+// 各线程上报自己的分配次数, 汇总后按总迭代数取平均
+void report_allocations(benchmark::State& state, std::size_t before) {
+    auto allocations = t_allocations - before;
+    state.counters["allocs_per_record"] = benchmark::Counter(
+        static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+// 旧实现: 每条记录一个 ostringstream, 析构时 str() 再拷贝一次
+auto format_with_ostringstream() -> std::string {
+    std::ostringstream oss;
+    oss << "[frame " << frame << "] " << label << " score=" << score << '\n';
+    return oss.str();
+}
+
+// 新实现: 写入线程局部缓冲区, 再拷贝到回收池中的字符串
+auto format_with_log_buffer() -> std::string {
+    auto& buffer = detail::log_buffer();
+    std::size_t begin = buffer.size();
+    fmt::format_to(std::back_inserter(buffer), "[frame {}] {} score={}\n", frame, label, score);
+
+    std::string message = detail::MessagePool::instance().acquire();
+    message.assign(buffer.data() + begin, buffer.size() - begin);
+    buffer.resize(begin);
+    return message;
+}
+
+} // namespace
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(std::size_t size) {
+    ++t_allocations;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+#pragma GCC diagnostic pop
+
+static void BM_Format_Ostringstream(benchmark::State& state) {
+    auto before = t_allocations;
+    for (auto _: state) {
+        auto message = format_with_ostringstream();
+        benchmark::DoNotOptimize(message);
+    }
+    report_allocations(state, before);
+}
+
+static void BM_Format_LogBuffer(benchmark::State& state) {
+    // 预热: 让缓冲区和回收池进入稳态
+    detail::MessagePool::instance().recycle(format_with_log_buffer());
+
+    auto before = t_allocations;
+    for (auto _: state) {
+        auto message = format_with_log_buffer();
+        benchmark::DoNotOptimize(message);
+        // 模拟后台线程写出后归还
+        detail::MessagePool::instance().recycle(std::move(message));
+    }
+    report_allocations(state, before);
+}
+
+static void BM_AsyncLog_Ostringstream(benchmark::State& state) {
+    auto& logger = CoroutineAsncLogger::instance();
+    auto before = t_allocations;
+    for (auto _: state) {
+        logger.log_impl(format_with_ostringstream());
+    }
+    report_allocations(state, before);
+}
+
+// LogStream 格式化到线程局部缓冲区, 写入本线程的环 (与 LOGG 同一个后端)
+static void BM_AsyncLog_LogStream(benchmark::State& state) {
+    auto before = t_allocations;
+    for (auto _: state) {
+        async_log << "[frame " << frame << "] " << label << " score=" << score;
+    }
+    report_allocations(state, before);
+}
+
+// 格式化到线程局部缓冲区后直接写入本线程的环, 不经过共享队列
+static void BM_AsyncLog_ThreadRing(benchmark::State& state) {
+    auto& logger = ThreadRingAsyncLogger::instance();
+    auto before = t_allocations;
+    for (auto _: state) {
+        auto& buffer = detail::log_buffer();
+        std::size_t begin = buffer.size();
+        fmt::format_to(std::back_inserter(buffer), "[frame {}] {} score={}\n", frame, label, score);
+        logger.write({buffer.data() + begin, buffer.size() - begin});
+        buffer.resize(begin);
+    }
+    report_allocations(state, before);
+}
+
+// 调用线程上格式化后写入 (旧 logg 的做法)
+static void BM_Deferred_EagerFormat(benchmark::State& state) {
+    auto& logger = ThreadRingAsyncLogger::instance();
+    auto before = t_allocations;
+    for (auto _: state) {
+        auto message = fmt::format("[frame {}] {} score={:.3f} image={}\n", frame, label, score, image.string());
+        logger.write(message);
+    }
+    report_allocations(state, before);
+}
+
+// 调用线程只拷贝格式串指针和参数编码
+static void BM_Deferred_BinaryCapture(benchmark::State& state) {
+    auto& logger = ThreadRingAsyncLogger::instance();
+    auto before = t_allocations;
+    for (auto _: state) {
+        logger.log_deferred("[frame {}] {} score={:.3f} image={}", frame, label, score, image);
+    }
+    report_allocations(state, before);
+}
+
+// 只测参数编码本身, 排除环满时等待后台线程的时间
+static void BM_Deferred_EncodeOnly(benchmark::State& state) {
+    using Format = DeferredFormat<int, std::string, double, std::filesystem::path>;
+    std::array<std::byte, 512> record;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(Format::encode(record.data(), frame, label, score, image));
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Format_Ostringstream);
+BENCHMARK(BM_Format_LogBuffer);
+BENCHMARK(BM_AsyncLog_Ostringstream)->Threads(1)->Threads(4);
+BENCHMARK(BM_AsyncLog_LogStream)->Threads(1)->Threads(4);
+BENCHMARK(BM_AsyncLog_ThreadRing)->Threads(1)->Threads(4);
+BENCHMARK(BM_Deferred_EagerFormat);
+BENCHMARK(BM_Deferred_BinaryCapture);
+BENCHMARK(BM_Deferred_EncodeOnly);
+
+constexpr LogSiteInfo frame_site_info{
+    .level = 0, .level_name = "INFO", .file = "labeling_canvas.cpp", .line = 128,
+    .function = "LabelingCanvas::commit_box", .format = "[frame {}] {} score={:.3f} image={}"
+};
+
+// 文本日志: 带时间戳与调用点信息的一整行
+static void BM_Output_TextLine(benchmark::State& state) {
+    fmt::memory_buffer out;
+    size_t bytes = 0;
+    for (auto _: state) {
+        fmt::format_to(std::back_inserter(out), "2025-01-01 12:12:12.123456 [{}] {}:{} {}: [frame {}] {} score={:.3f} image={}\n",
+                       frame_site_info.level_name, frame_site_info.file, frame_site_info.line, frame_site_info.function,
+                       frame, label, score, image.string());
+        bytes += out.size();
+        out.clear();
+    }
+    state.counters["bytes_per_record"] = benchmark::Counter(static_cast<double>(bytes) / static_cast<double>(state.iterations()));
+}
+
+// 二进制日志: 调用点 id + 时间差 + 参数, 从环中的参数编码转写
+static void BM_Output_BinaryEvent(benchmark::State& state) {
+    using Format = DeferredFormat<int, std::string, double, std::filesystem::path>;
+    static const LogSite& site = LogSiteRegistry::instance().add<int, std::string, double, std::filesystem::path>(frame_site_info, nullptr);
+
+    std::array<std::byte, 512> record;
+    Format::encode(record.data(), frame, label, score, image);
+
+    BinaryLogWriter writer{"/dev/null"};
+    const auto header_bytes = writer.bytes_written();
+    std::uint64_t ticks = 0;
+    for (auto _: state) {
+        writer.append_event(site, ticks += 300, record.data());
+        if (writer.pending_bytes() >= 64 * 1024) writer.flush();
+    }
+    writer.flush();
+    state.counters["bytes_per_record"] = benchmark::Counter(
+        static_cast<double>(writer.bytes_written() - header_bytes) / static_cast<double>(state.iterations()));
+}
+
+BENCHMARK(BM_Output_TextLine);
+BENCHMARK(BM_Output_BinaryEvent);
+
+// 写入 /dev/null, 只比较系统调用次数的影响; 关闭轮转以免改动 /dev/null
+static void run_file_sink(benchmark::State& state, FileSinkOptions options, size_t batch_size) {
+    options.path         = "/dev/null";
+    options.rotate_bytes = 0;
+    FileSink sink{options};
+
+    const std::string line = format_with_log_buffer();
+    std::vector<LogRecord> batch(batch_size, LogRecord{.text = line});
+    for (auto _: state) sink.write(batch);
+    sink.flush();
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * batch_size));
+    state.counters["writes_per_record"] = benchmark::Counter(
+        static_cast<double>(sink.write_calls()) / static_cast<double>(state.iterations() * batch_size));
+}
+
+// 旧做法: 每条消息写一次
+static void BM_FileSink_PerRecord(benchmark::State& state) {
+    FileSinkOptions options;
+    options.flush_bytes = 0;
+    run_file_sink(state, options, 1);
+}
+
+// 日志线程一次取走 state.range(0) 条, 攒够 64 KiB 后一次 writev
+static void BM_FileSink_Batched(benchmark::State& state) {
+    run_file_sink(state, FileSinkOptions{}, static_cast<size_t>(state.range(0)));
+}
+
+BENCHMARK(BM_FileSink_PerRecord);
+BENCHMARK(BM_FileSink_Batched)->Arg(1)->Arg(64);
+
+// 丢弃合并后的批次, 只测攒批与拼接
+struct NullBatchLogger {
+    static auto instance() -> NullBatchLogger& {
+        static NullBatchLogger logger;
+        return logger;
+    }
+
+    void log_impl(std::string message) { benchmark::DoNotOptimize(message.data()); }
+    void stop_impl() {}
+};
+
+// 旧实现: std::accumulate 逐条 operator+ 拼接
+static void BM_Batch_Accumulate(benchmark::State& state) {
+    const std::string line = format_with_log_buffer();
+    std::vector<std::string> batch;
+    for (auto _: state) {
+        batch.push_back(line);
+        if (batch.size() >= static_cast<size_t>(state.range(0))) {
+            NullBatchLogger::instance().log_impl(std::accumulate(batch.begin(), batch.end(), std::string{}));
+            batch.clear();
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+// 新实现: 按总长度预留一次, 批次大小随突发增大
+static void BM_Batch_Strategy(benchmark::State& state) {
+    const std::string line = format_with_log_buffer();
+    BatchStrategy<100, 50> strategy;
+    for (auto _: state) strategy.process(NullBatchLogger::instance(), line);
+    strategy.flush(NullBatchLogger::instance());
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    state.counters["batch_size"] = static_cast<double>(strategy.get_batch_size());
+}
+
+BENCHMARK(BM_Batch_Accumulate)->Arg(100)->Arg(800);
+BENCHMARK(BM_Batch_Strategy);
+
+// 只有原子加与 memcpy, 不应出现系统调用或分配
+static void BM_Flight_Record(benchmark::State& state) {
+    static FlightRecorder recorder{FlightRecorderOptions{
+        .path = std::filesystem::temp_directory_path() / "logger_benchmark_flight.bin"}};
+
+    const std::string line = format_with_log_buffer();
+    const auto before = t_allocations;
+    for (auto _: state) recorder.record(line);
+
+    report_allocations(state, before);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+BENCHMARK(BM_Flight_Record)->Threads(1)->Threads(4);
+
+using labelimg::core::formatter::TimestampFormat;
+using labelimg::core::formatter::detail::TimestampFormatter;
+
+// 旧实现: 每条记录 localtime + put_time 写入新的 ostringstream
+static void BM_Timestamp_PutTime(benchmark::State& state) {
+    const auto before = t_allocations;
+    for (auto _: state) {
+        const auto now  = std::chrono::system_clock::now();
+        const auto time = std::chrono::system_clock::to_time_t(now);
+        const auto ms   = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+
+        std::ostringstream oss;
+        oss << std::put_time(std::localtime(&time), "%H:%M:%S");
+        oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
+        benchmark::DoNotOptimize(oss.str());
+    }
+    report_allocations(state, before);
+}
+
+// 新实现: 秒不变时只拷贝缓存的前缀并填入毫秒
+static void BM_Timestamp_Cached(benchmark::State& state) {
+    const auto format = static_cast<TimestampFormat>(state.range(0));
+    const auto before = t_allocations;
+    for (auto _: state) benchmark::DoNotOptimize(TimestampFormatter::view(format));
+    report_allocations(state, before);
+}
+
+BENCHMARK(BM_Timestamp_PutTime);
+BENCHMARK(BM_Timestamp_Cached)
+    ->Arg(static_cast<int>(TimestampFormat::IOS8601))
+    ->Arg(static_cast<int>(TimestampFormat::SIMPLE))
+    ->Arg(static_cast<int>(TimestampFormat::TIME_ONLY));
+
+// 基准报告写到原来的标准输出, std::cout 换成空缓冲区, 日志 I/O 不计入结果
+int main(int argc, char** argv) {
+    std::ostream report{std::cout.rdbuf()};
+    // 日志线程在 main 返回后仍可能写出积压消息, 空缓冲区有意不释放
+    std::cout.rdbuf(new NullBuffer);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    benchmark::ConsoleReporter reporter;
+    reporter.SetOutputStream(&report);
+    reporter.SetErrorStream(&std::cerr);
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+
+    CoroutineAsncLogger::instance().stop_impl();
+    ThreadRingAsyncLogger::instance().stop_impl();
+    benchmark::Shutdown();
+    return 0;
+}
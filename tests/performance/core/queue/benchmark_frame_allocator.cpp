@@ -0,0 +1,145 @@
+// ---------------Queue.FrameAllocator.Performance--------------- //
+//
+//                      Benchmark
+//
+//     Description:
+//          Compare coroutine frame allocation through the pooled
+//          FrameAllocator against the global operator new
+//
+//     Cases:
+//        1. Task<int>   (pooled frames)
+//        2. HeapTask    (minimal promise, global operator new)
+//        3. raw allocate / deallocate pairs
+//        4. 1 / 4 / 8 threads creating short-lived jobs
+//
+//     Target:
+//        Performance Test
+//
+// ------------------------------------------------------------- //
+
+#include <benchmark/benchmark.h>
+
+#include <coroutine>
+#include <exception>
+
+#include <core/message_queue.hpp>
+
+using namespace labelimg::core::queue;
+
+namespace {
+
+// 最简 promise, 帧由全局 operator new 分配, 作为对照组
+// (没有 Task 的续体原子操作, 单任务对比会略偏向它; 分配差异看 Raw / Batch 两组)
+struct HeapTask {
+    struct promise_type {
+        int value{0};
+
+        auto get_return_object() -> HeapTask {
+            return HeapTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+        auto final_suspend()   noexcept -> std::suspend_always { return {}; }
+        void return_value(int v) { value = v; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit HeapTask(std::coroutine_handle<promise_type> h): handle{h} {}
+    HeapTask(HeapTask&& other) noexcept: handle{std::exchange(other.handle, {})} {}
+    ~HeapTask() { if (handle) handle.destroy(); }
+
+    auto get() const -> int { return handle.promise().value; }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+auto pooled_job(int i) -> Task<int> {
+    char scratch[128];
+    benchmark::DoNotOptimize(scratch);
+    co_return i + 1;
+}
+
+auto heap_job(int i) -> HeapTask {
+    char scratch[128];
+    benchmark::DoNotOptimize(scratch);
+    co_return i + 1;
+}
+
+} // namespace
+
+static void BM_TaskFramePooled(benchmark::State& state) {
+    auto before = FrameAllocator::thread_stats();
+    int i = 0;
+    for (auto _: state) {
+        auto task = pooled_job(i++);
+        benchmark::DoNotOptimize(task.get());
+    }
+    auto after = FrameAllocator::thread_stats();
+    state.SetItemsProcessed(state.iterations());
+
+    auto hits   = static_cast<double>(after.hits - before.hits);
+    auto misses = static_cast<double>(after.misses - before.misses);
+    state.counters["hit_rate"] = benchmark::Counter(hits / std::max(1.0, hits + misses),
+                                                    benchmark::Counter::kAvgThreads);
+    state.counters["peak_pooled_bytes"] = benchmark::Counter(static_cast<double>(after.peak_pooled_bytes),
+                                                             benchmark::Counter::kAvgThreads);
+}
+
+static void BM_TaskFrameHeap(benchmark::State& state) {
+    int i = 0;
+    for (auto _: state) {
+        auto task = heap_job(i++);
+        benchmark::DoNotOptimize(task.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 只测分配器本身: 单个帧尺寸的申请 / 释放
+static void BM_RawPooled(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    for (auto _: state) {
+        void* frame = FrameAllocator::allocate(size);
+        benchmark::DoNotOptimize(frame);
+        FrameAllocator::deallocate(frame, size);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_RawHeap(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    for (auto _: state) {
+        void* frame = ::operator new(size);
+        benchmark::DoNotOptimize(frame);
+        ::operator delete(frame, size);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 一次性创建一批任务再统一销毁, 模拟目录扫描时的大量并存任务
+static void BM_TaskFrameBatchPooled(benchmark::State& state) {
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    std::vector<Task<int>> tasks;
+    tasks.reserve(batch);
+    for (auto _: state) {
+        for (std::size_t i = 0; i < batch; ++i) tasks.push_back(pooled_job(static_cast<int>(i)));
+        tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch));
+}
+
+static void BM_TaskFrameBatchHeap(benchmark::State& state) {
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    std::vector<HeapTask> tasks;
+    tasks.reserve(batch);
+    for (auto _: state) {
+        for (std::size_t i = 0; i < batch; ++i) tasks.push_back(heap_job(static_cast<int>(i)));
+        tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch));
+}
+
+BENCHMARK(BM_TaskFramePooled) -> Name("FrameAllocator/Pooled") -> Threads(1) -> Threads(4) -> Threads(8);
+BENCHMARK(BM_TaskFrameHeap)   -> Name("FrameAllocator/Heap")   -> Threads(1) -> Threads(4) -> Threads(8);
+BENCHMARK(BM_RawPooled) -> Name("FrameAllocator/RawPooled") -> Arg(200) -> Arg(1000) -> Threads(1) -> Threads(8);
+BENCHMARK(BM_RawHeap)   -> Name("FrameAllocator/RawHeap")   -> Arg(200) -> Arg(1000) -> Threads(1) -> Threads(8);
+BENCHMARK(BM_TaskFrameBatchPooled) -> Name("FrameAllocator/BatchPooled") -> Arg(64) -> Arg(256) -> Threads(1) -> Threads(4);
+BENCHMARK(BM_TaskFrameBatchHeap)   -> Name("FrameAllocator/BatchHeap")   -> Arg(64) -> Arg(256) -> Threads(1) -> Threads(4);
@@ -0,0 +1,86 @@
+// ---------------Queue.PriorityPolicy.Performance--------------- //
+//
+//                      Benchmark
+//
+//     Description:
+//          Latency of an interactive item pushed behind a backlog of
+//          background items, FIFO (MutexPolicy) vs PriorityPolicy
+//
+//     Cases:
+//        1. backlog of 64 / 1024 / 16384 background items
+//
+//     Target:
+//        Performance Test
+//
+// ------------------------------------------------------------- //
+
+#include <benchmark/benchmark.h>
+
+#include <core/message_queue.hpp>
+#include <core/queue/priority_queue.hpp>
+
+using namespace labelimg::core::queue;
+
+namespace {
+
+constexpr int interactive_marker = -1;
+
+// 出队直到拿到交互元素, 返回其前面被处理的元素数量
+template <typename Q>
+auto pops_until_interactive(Q& queue) -> int {
+    int value = 0;
+    int pops  = 0;
+    while (queue.try_pop(value)) {
+        ++pops;
+        if (value == interactive_marker) break;
+    }
+    return pops;
+}
+
+} // namespace
+
+static void BM_InteractiveBehindBacklogFifo(benchmark::State& state) {
+    const auto backlog = static_cast<int>(state.range(0));
+    MessageQueue<int, MutexPolicy> queue;
+    int pops = 0;
+
+    for (auto _: state) {
+        state.PauseTiming();
+        for (int i = 0; i < backlog; ++i) queue.push(i);
+        state.ResumeTiming();
+
+        queue.push(interactive_marker);
+        pops = pops_until_interactive(queue);
+
+        state.PauseTiming();
+        int value = 0;
+        while (queue.try_pop(value)) {}
+        state.ResumeTiming();
+    }
+    state.counters["pops_before_interactive"] = pops;
+}
+
+static void BM_InteractiveBehindBacklogPriority(benchmark::State& state) {
+    using Policy = PriorityPolicy<3>;
+    const auto backlog = static_cast<int>(state.range(0));
+    MessageQueue<int, Policy> queue;
+    int pops = 0;
+
+    for (auto _: state) {
+        state.PauseTiming();
+        for (int i = 0; i < backlog; ++i) queue.push(i, Policy::lowest);
+        state.ResumeTiming();
+
+        queue.push(interactive_marker, Policy::highest);
+        pops = pops_until_interactive(queue);
+
+        state.PauseTiming();
+        int value = 0;
+        while (queue.try_pop(value)) {}
+        state.ResumeTiming();
+    }
+    state.counters["pops_before_interactive"] = pops;
+}
+
+BENCHMARK(BM_InteractiveBehindBacklogFifo)     -> Name("PriorityPolicy/InteractiveLatency/Fifo")     -> Arg(64) -> Arg(1024) -> Arg(16384);
+BENCHMARK(BM_InteractiveBehindBacklogPriority) -> Name("PriorityPolicy/InteractiveLatency/Priority") -> Arg(64) -> Arg(1024) -> Arg(16384);
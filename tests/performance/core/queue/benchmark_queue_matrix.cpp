@@ -0,0 +1,301 @@
+// ---------------Queue.MessageQueue.Performance--------------- //
+//
+//                      Benchmark
+//
+//     Description:
+//          Throughput and handoff latency (push -> pop) of every
+//          MessageQueue policy over a matrix of producer / consumer
+//          counts, payload sizes and burst patterns
+//
+//     Policies:
+//        1. MutexPolicy           (CondVarWait / AtomicWait)
+//        2. LockFreePolicy<4096>  (SpinWait / AtomicWait)
+//        3. PriorityPolicy<3>     (single lane)
+//        4. CoroutinePolicy       (consumers resumed on WorkStealingPool)
+//        5. ShardedPolicy<16, 1024>
+//        6. SpscPolicy<4096>      (1 producer / 1 consumer only)
+//
+//     Cases:
+//        1. Threads: producers x consumers in {1, 4, 16, 32}^2, 8 byte payload
+//        2. Payload: 64 / 256 / 1024 bytes at 1x1 and 4x4
+//        3. Burst:   steady vs bursts of 16 / 256 items separated by idle gaps
+//
+//     Counters:
+//        items_per_second, p50_ns / p99_ns / p999_ns handoff latency
+//
+//     Usage:
+//        queue_benchmarks --benchmark_filter='Queue/LockFree.*/Threads'
+//
+//     Target:
+//        Performance Test
+//
+// ------------------------------------------------------------- //
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <core/asm/hp_timer.hpp>
+#include <core/message_queue.hpp>
+#include <core/task_combinators.hpp>
+#include <core/thread_pool.hpp>
+#include <core/queue/lock_free_queue.hpp>
+#include <core/queue/priority_queue.hpp>
+#include <core/queue/sharded_queue.hpp>
+#include <core/queue/spsc_queue.hpp>
+#include <core/queue/wait_strategy.hpp>
+
+using namespace labelimg::core::queue;
+
+namespace {
+
+using Timer = labelimg::core::asm_::HighPrecisionTimer;
+
+// 每轮在所有生产者之间平分的元素数量
+constexpr std::int64_t items_per_round = 1 << 15;
+
+// stamp 为入队时刻 (cycles), 0 表示结束标记
+template <std::size_t Bytes>
+struct Payload {
+    static_assert(Bytes >= sizeof(std::uint64_t));
+
+    std::uint64_t stamp{0};
+    std::array<std::byte, Bytes - sizeof(std::uint64_t)> padding{};
+};
+
+// 每个消费者一份延迟样本 (cycles), 只由该消费者写入
+using Samples = std::vector<std::vector<std::uint64_t>>;
+
+inline void record(std::vector<std::uint64_t>& samples, std::uint64_t stamp) {
+    Timer::cycle_count_t now = Timer::cycles();
+    samples.push_back(now > stamp ? now - stamp : 0);
+}
+
+// 生产者: burst == 0 时连续推送; 否则每推送 burst 个元素休眠 burst 微秒,
+// 让消费者进入等待, 测量唤醒路径
+template <typename Q, typename Item>
+void produce(Q& queue, std::int64_t count, std::int64_t burst) {
+    for (std::int64_t i = 0; i < count; ++i) {
+        Item item;
+        item.stamp = Timer::cycles();
+        queue.push(std::move(item));
+
+        if (burst != 0 && (i + 1) % burst == 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(burst));
+    }
+}
+
+// 常规策略: 每个消费者一个线程, wait_and_pop 阻塞等待
+template <typename Q, typename Item>
+class ThreadConsumers {
+public:
+    ThreadConsumers(Q& queue, std::size_t consumers): m_queue{queue}, m_consumers{consumers} {}
+
+    void start(Samples& samples) {
+        for (std::size_t c = 0; c < m_consumers; ++c) {
+            m_threads.emplace_back([this, &samples, c] {
+                Item item;
+                for (;;) {
+                    m_queue.wait_and_pop(item);
+                    if (item.stamp == 0) break;
+                    record(samples[c], item.stamp);
+                }
+            });
+        }
+    }
+
+    void join() {
+        for (auto& thread: m_threads) thread.join();
+        m_threads.clear();
+    }
+private:
+    Q& m_queue;
+    std::size_t m_consumers;
+    std::vector<std::thread> m_threads;
+};
+
+// CoroutinePolicy: 每个消费者是一个协程, 由生产者交给线程池恢复
+template <typename Item>
+class CoroutineConsumers {
+public:
+    using Q = MessageQueue<Item, BasicCoroutinePolicy<WorkStealingPool>>;
+
+    CoroutineConsumers(Q& queue, std::size_t consumers): m_queue{queue}, m_consumers{consumers} {}
+
+    void start(Samples& samples) {
+        std::vector<Task<void>> tasks;
+        tasks.reserve(m_consumers);
+        for (std::size_t c = 0; c < m_consumers; ++c) tasks.push_back(consume(m_queue, samples[c]));
+        m_all.emplace(when_all(std::move(tasks)));
+    }
+
+    void join() {
+        sync_wait(*m_all);
+        m_all.reset();
+    }
+private:
+    static auto consume(Q& queue, std::vector<std::uint64_t>& samples) -> Task<void> {
+        for (;;) {
+            Item item = co_await queue.async_pop();
+            if (item.stamp == 0) co_return;
+            record(samples, item.stamp);
+        }
+    }
+
+    Q& m_queue;
+    std::size_t m_consumers;
+    std::optional<Task<void>> m_all;
+};
+
+// 队列及其依赖 (CoroutinePolicy 需要线程池作为执行器)
+template <typename Q, typename Item>
+struct Harness {
+    using Consumers = ThreadConsumers<Q, Item>;
+
+    explicit Harness(std::size_t /*consumers*/) {}
+
+    Q queue;
+};
+
+template <typename Item>
+struct Harness<MessageQueue<Item, BasicCoroutinePolicy<WorkStealingPool>>, Item> {
+    using Consumers = CoroutineConsumers<Item>;
+
+    // 线程池线程数等于消费者数量, 与线程消费者的并发度一致
+    explicit Harness(std::size_t consumers): pool{consumers}, queue{pool} {}
+
+    WorkStealingPool pool;
+    MessageQueue<Item, BasicCoroutinePolicy<WorkStealingPool>> queue;
+};
+
+void report_latency(benchmark::State& state, Samples& samples) {
+    std::vector<std::uint64_t> merged;
+    for (auto& per_consumer: samples) merged.insert(merged.end(), per_consumer.begin(), per_consumer.end());
+    if (merged.empty()) return;
+
+    // 计时结束后才换算, 首次调用的频率校准不计入测量
+    const double cycles_per_ns = Timer::get_cpu_frequency();
+    auto percentile = [&](double p) {
+        auto index = static_cast<std::size_t>(p * static_cast<double>(merged.size() - 1));
+        std::nth_element(merged.begin(), merged.begin() + static_cast<std::ptrdiff_t>(index), merged.end());
+        auto cycles = static_cast<double>(merged[index]);
+        return cycles_per_ns > 0.0 ? cycles / cycles_per_ns : cycles;
+    };
+
+    state.counters["p50_ns"]  = percentile(0.50);
+    state.counters["p99_ns"]  = percentile(0.99);
+    state.counters["p999_ns"] = percentile(0.999);
+}
+
+// 参数: producers, consumers, burst
+// 线程创建不计入时间: 所有线程就绪后才开始计时, 最后一个消费者退出时停止
+template <typename Q, typename Item>
+void BM_Handoff(benchmark::State& state) {
+    const auto producers = static_cast<std::size_t>(state.range(0));
+    const auto consumers = static_cast<std::size_t>(state.range(1));
+    const auto burst     = state.range(2);
+    const auto per_producer = items_per_round / static_cast<std::int64_t>(producers);
+
+    Harness<Q, Item> harness{consumers};
+    Q& queue = harness.queue;
+    Samples samples(consumers);
+    for (auto& per_consumer: samples) per_consumer.reserve(static_cast<std::size_t>(items_per_round));
+
+    std::int64_t items = 0;
+    for (auto _: state) {
+        for (auto& per_consumer: samples) per_consumer.clear();
+
+        typename Harness<Q, Item>::Consumers sinks{queue, consumers};
+        sinks.start(samples);
+
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&] {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                produce<Q, Item>(queue, per_producer, burst);
+            });
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& thread: threads) thread.join();
+        for (std::size_t c = 0; c < consumers; ++c) queue.push(Item{});
+        sinks.join();
+        auto end = std::chrono::steady_clock::now();
+
+        state.SetIterationTime(std::chrono::duration<double>(end - begin).count());
+        items += per_producer * static_cast<std::int64_t>(producers);
+    }
+
+    state.SetItemsProcessed(items);
+    // 只统计最后一轮的样本, 避免样本随迭代次数无限增长
+    report_latency(state, samples);
+}
+
+template <typename Q, typename Item>
+auto register_case(const std::string& name) -> benchmark::internal::Benchmark* {
+    return benchmark::RegisterBenchmark(name.c_str(), BM_Handoff<Q, Item>)
+        ->ArgNames({"producers", "consumers", "burst"})
+        ->UseManualTime()
+        ->Unit(benchmark::kMillisecond);
+}
+
+template <template <typename> typename QueueOf>
+void register_mpmc(const std::string& policy) {
+    register_case<QueueOf<Payload<8>>, Payload<8>>("Queue/" + policy + "/Threads/Payload:8")
+        ->ArgsProduct({{1, 4, 16, 32}, {1, 4, 16, 32}, {0}});
+
+    register_case<QueueOf<Payload<64>>, Payload<64>>("Queue/" + policy + "/Payload:64")
+        ->Args({1, 1, 0})->Args({4, 4, 0});
+    register_case<QueueOf<Payload<256>>, Payload<256>>("Queue/" + policy + "/Payload:256")
+        ->Args({1, 1, 0})->Args({4, 4, 0});
+    register_case<QueueOf<Payload<1024>>, Payload<1024>>("Queue/" + policy + "/Payload:1024")
+        ->Args({1, 1, 0})->Args({4, 4, 0});
+
+    register_case<QueueOf<Payload<8>>, Payload<8>>("Queue/" + policy + "/Burst/Payload:8")
+        ->ArgsProduct({{1, 4}, {1, 4}, {16, 256}});
+}
+
+template <template <typename> typename QueueOf>
+void register_spsc(const std::string& policy) {
+    register_case<QueueOf<Payload<8>>, Payload<8>>("Queue/" + policy + "/Payload:8")
+        ->Args({1, 1, 0})->Args({1, 1, 16})->Args({1, 1, 256});
+    register_case<QueueOf<Payload<64>>, Payload<64>>("Queue/" + policy + "/Payload:64")->Args({1, 1, 0});
+    register_case<QueueOf<Payload<256>>, Payload<256>>("Queue/" + policy + "/Payload:256")->Args({1, 1, 0});
+    register_case<QueueOf<Payload<1024>>, Payload<1024>>("Queue/" + policy + "/Payload:1024")->Args({1, 1, 0});
+}
+
+template <typename T> using MutexQueue          = MessageQueue<T, MutexPolicy>;
+template <typename T> using MutexAtomicQueue    = MessageQueue<T, BoundedMutexPolicy<0, OverflowPolicy::Block, AtomicWait>>;
+template <typename T> using LockFreeQueue       = MessageQueue<T, LockFreePolicy<4096>>;
+template <typename T> using LockFreeAtomicQueue = MessageQueue<T, LockFreePolicy<4096, AtomicWait>>;
+template <typename T> using PriorityQueue       = MessageQueue<T, PriorityPolicy<3>>;
+template <typename T> using ShardedQueue        = MessageQueue<T, ShardedPolicy<16, 1024>>;
+template <typename T> using CoroutineQueue      = MessageQueue<T, BasicCoroutinePolicy<WorkStealingPool>>;
+template <typename T> using SpscQueue           = MessageQueue<T, SpscPolicy<4096>>;
+template <typename T> using SpscSpinQueue       = MessageQueue<T, SpscPolicy<4096, SpinWait>>;
+
+// 新增策略时在此登记一行, 即可与现有策略在同一矩阵下对比
+[[maybe_unused]] const bool registered = [] {
+    register_mpmc<MutexQueue>("Mutex");
+    register_mpmc<MutexAtomicQueue>("Mutex+AtomicWait");
+    register_mpmc<LockFreeQueue>("LockFree");
+    register_mpmc<LockFreeAtomicQueue>("LockFree+AtomicWait");
+    register_mpmc<PriorityQueue>("Priority");
+    register_mpmc<ShardedQueue>("Sharded");
+    register_mpmc<CoroutineQueue>("Coroutine");
+    register_spsc<SpscQueue>("Spsc");
+    register_spsc<SpscSpinQueue>("Spsc+SpinWait");
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,180 @@
+// ---------------Logger.BatchLogger--------------- //
+//
+//     Description:
+//          Test BatchStrategy and the BatchAsyncLogger flusher
+//
+//     Components:
+//        1. BatchStrategy concatenation and adaptive batch size
+//        2. Deadline-driven flush without further messages
+//        3. Stopping a batch logger leaves the shared back end running
+//
+//    Target:
+//        Every message is written, in order, within the flush interval
+//
+// ----------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <core/async_logger.h>
+
+using namespace labelimg::core::logger;
+using namespace std::chrono_literals;
+
+namespace {
+
+// 记录 log_impl 收到的每一批
+struct RecordingLogger {
+    static auto instance() -> RecordingLogger& {
+        static RecordingLogger logger;
+        return logger;
+    }
+
+    void log_impl(std::string message) { batches.push_back(std::move(message)); }
+    void stop_impl() {}
+
+    std::vector<std::string> batches;
+};
+
+// 后台线程写入, 测试线程读取
+class MemorySink final: public LogSink {
+public:
+    void write(std::span<const LogRecord> records) override {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for (const auto& record: records) m_text.append(record.text);
+    }
+
+    void flush() override {}
+
+    [[nodiscard]] auto text() const -> std::string {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_text;
+    }
+private:
+    mutable std::mutex m_mutex;
+    std::string m_text;
+};
+
+} // namespace
+
+TEST(BatchStrategyTest, FlushConcatenatesInOrder) {
+    RecordingLogger logger;
+    BatchStrategy<4, 50> strategy;
+
+    for (int i = 0; i < 3; ++i) strategy.process(logger, std::to_string(i));
+    EXPECT_TRUE(logger.batches.empty());
+    EXPECT_EQ(strategy.batch.size(), 3u);
+
+    strategy.flush(logger);
+    ASSERT_EQ(logger.batches.size(), 1u);
+    EXPECT_EQ(logger.batches[0], "012");
+    EXPECT_TRUE(strategy.batch.empty());
+    EXPECT_EQ(strategy.generation(), 1u);
+}
+
+TEST(BatchStrategyTest, BatchGrowsUnderBurstAndShrinksWhenIdle) {
+    RecordingLogger logger;
+    BatchStrategy<16, 20> strategy;
+
+    // 突发: 每批都在远小于刷新间隔的时间内攒满
+    for (int i = 0; i < 5000; ++i) strategy.process(logger, "x");
+    const size_t burst = strategy.get_batch_size();
+    EXPECT_GT(burst, 16u);
+    EXPECT_LE(burst, decltype(strategy)::max_batch_size);
+
+    // 空闲: 每批只有一条, 到截止时间才写出
+    for (int i = 0; i < 20; ++i) {
+        strategy.process(logger, "y");
+        std::this_thread::sleep_for(2ms);
+        strategy.flush(logger);
+    }
+    EXPECT_LT(strategy.get_batch_size(), burst);
+    EXPECT_GE(strategy.get_batch_size(), decltype(strategy)::min_batch_size);
+}
+
+TEST(BatchAsyncLoggerTest, FlushesAtDeadlineWithoutMoreMessages) {
+    auto sink = std::make_shared<MemorySink>();
+    MutexAsyncLogger::instance().set_sink(sink);
+
+    auto& logger = BatchAsyncLogger<ManualMutexBatch<100, 20>>::instance();
+    const auto start = std::chrono::steady_clock::now();
+    logger.log_impl("first\n");
+    logger.log_impl("second\n");
+
+    while (sink->text().empty() && std::chrono::steady_clock::now() - start < 2s)
+        std::this_thread::sleep_for(1ms);
+
+    EXPECT_EQ(sink->text(), "first\nsecond\n");
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+    EXPECT_EQ(logger.get_pending_count(), 0u);
+
+    // 刷新线程常驻: 之后的批次同样按时写出
+    logger.log_impl("third\n");
+    while (sink->text().size() == 13 && std::chrono::steady_clock::now() - start < 3s)
+        std::this_thread::sleep_for(1ms);
+    EXPECT_EQ(sink->text(), "first\nsecond\nthird\n");
+
+    MutexAsyncLogger::instance().set_sink(std::make_shared<ConsoleSink>());
+}
+
+TEST(BatchAsyncLoggerTest, StopKeepsSharedBackendRunning) {
+    auto sink = std::make_shared<MemorySink>();
+    MutexAsyncLogger::instance().set_sink(sink);
+
+    // 只停止这一个批量 logger; 后端是其他 logger 共用的单例
+    auto& logger = BatchAsyncLogger<ManualMutexBatch<100, 1000>>::instance();
+    logger.log_impl("pending\n");
+    logger.stop_impl();
+    EXPECT_EQ(logger.get_pending_count(), 0u);
+
+    // 停止后的消息直接交给后端, 后端也仍接受其他来源的记录
+    logger.log_impl("after stop\n");
+    MutexAsyncLogger::instance().log_impl("backend\n");
+
+    const auto start = std::chrono::steady_clock::now();
+    while (sink->text().size() < 26 && std::chrono::steady_clock::now() - start < 2s)
+        std::this_thread::sleep_for(1ms);
+    EXPECT_EQ(sink->text(), "pending\nafter stop\nbackend\n");
+
+    MutexAsyncLogger::instance().set_sink(std::make_shared<ConsoleSink>());
+}
+
+TEST(BatchAsyncLoggerTest, ConcurrentProducersKeepPerThreadOrder) {
+    auto sink = std::make_shared<MemorySink>();
+    MutexAsyncLogger::instance().set_sink(sink);
+
+    auto& logger = BatchAsyncLogger<ManualMutexBatch<8, 5>>::instance();
+    constexpr int threads = 4;
+    constexpr int per_thread = 500;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([&logger, t] {
+            for (int i = 0; i < per_thread; ++i) logger.log_impl(fmt::format("{} {}\n", t, i));
+        });
+    }
+    for (auto& producer: producers) producer.join();
+    logger.flush();
+
+    const auto start = std::chrono::steady_clock::now();
+    auto lines = [&sink] { return std::ranges::count(sink->text(), '\n'); };
+    while (lines() < threads * per_thread && std::chrono::steady_clock::now() - start < 5s)
+        std::this_thread::sleep_for(1ms);
+
+    // 批次在锁外交给后端, 但交付顺序与取走顺序一致: 每个线程的消息保持先后顺序
+    const std::string text = sink->text();
+    std::vector<int> next(threads, 0);
+    size_t begin = 0;
+    for (size_t end = text.find('\n'); end != std::string::npos; begin = end + 1, end = text.find('\n', begin)) {
+        const int t = text[begin] - '0';
+        EXPECT_EQ(text.substr(begin, end - begin), fmt::format("{} {}", t, next[t]));
+        ++next[t];
+    }
+    for (const int count: next) EXPECT_EQ(count, per_thread);
+
+    MutexAsyncLogger::instance().set_sink(std::make_shared<ConsoleSink>());
+}
@@ -0,0 +1,241 @@
+// ---------------Logger.BinaryLog--------------- //
+//
+//     Description:
+//          Test the binary log file format and call-site registry
+//
+//     Components:
+//        1. BinaryLogWriter SITE / EVENT / TEXT records
+//        2. BinaryLogDecoder block index and parallel decoding
+//        3. LOG_AT_SITE registers each call site once
+//        4. TRACE_FUNCTION_LOG takes the function name from the call site
+//
+//    Target:
+//        Decoded text equals fmt::format output of the same arguments
+//
+// ---------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <test_utils.hpp>
+
+#include <core/binary_log.hpp>
+#include <core/site_logger.hpp>
+
+using namespace labelimg::core::logger;
+
+namespace {
+
+class BinaryLogTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_path = test::common::utils::unique_temp_path("binary_log_test", ".blog");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(m_path);
+    }
+
+    // 与记录一同写入的参数编码
+    template <typename... Args>
+    static auto encode(const Args&... args) -> std::vector<std::byte> {
+        std::vector<std::byte> encoded(DeferredFormat<Args...>::encoded_size(args...));
+        DeferredFormat<Args...>::encode(encoded.data(), args...);
+        return encoded;
+    }
+
+    // 去掉每行开头的时间戳 "YYYY-MM-DD HH:MM:SS.ffffff "
+    static auto strip_timestamps(const std::string& text) -> std::vector<std::string> {
+        std::vector<std::string> lines;
+        std::istringstream stream{text};
+        for (std::string line; std::getline(stream, line);) lines.push_back(line.substr(27));
+        return lines;
+    }
+
+    std::filesystem::path m_path;
+};
+
+constexpr LogSiteInfo load_info{
+    .level = 1, .level_name = "INFO", .file = "loader.cpp", .line = 42,
+    .function = "load", .format = "loaded {} images from {} in {:.1f} ms"
+};
+
+constexpr LogSiteInfo pointer_info{
+    .level = 2, .level_name = "WARNING", .file = "canvas.cpp", .line = 7,
+    .function = "paint", .format = "{} {} {}"
+};
+
+} // namespace
+
+TEST_F(BinaryLogTest, RoundTripEventsAndText) {
+    const auto& load_site    = LogSiteRegistry::instance().add<int, std::string, double>(load_info, nullptr);
+    const auto& pointer_site = LogSiteRegistry::instance().add<char, bool, std::int16_t>(pointer_info, nullptr);
+
+    {
+        BinaryLogWriter writer{m_path};
+        ASSERT_TRUE(writer.is_open());
+
+        auto first = encode(3, std::string{"/data/set"}, 12.25);
+        writer.append_event(load_site, 100, first.data());
+        writer.append_text(110, "plain text\n");
+        writer.flush();
+
+        auto second = encode('x', true, std::int16_t{-5});
+        writer.append_event(pointer_site, 120, second.data());
+        auto third = encode(0, std::string{}, 0.0);
+        writer.append_event(load_site, 130, third.data());
+    }
+
+    BinaryLogDecoder decoder;
+    ASSERT_TRUE(decoder.open(m_path)) << decoder.error();
+    EXPECT_EQ(decoder.block_count(), 2u);
+    EXPECT_EQ(decoder.site_count(), 2u);
+    EXPECT_FALSE(decoder.truncated());
+
+    std::ostringstream out;
+    decoder.decode(out, 4);
+    auto lines = strip_timestamps(out.str());
+
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_EQ(lines[0], "[INFO] loader.cpp:42 load: loaded 3 images from /data/set in 12.2 ms");
+    EXPECT_EQ(lines[1], "plain text");
+    EXPECT_EQ(lines[2], "[WARNING] canvas.cpp:7 paint: x true -5");
+    EXPECT_EQ(lines[3], "[INFO] loader.cpp:42 load: loaded 0 images from  in 0.0 ms");
+}
+
+TEST_F(BinaryLogTest, TruncatedTailIsIgnored) {
+    const auto& site = LogSiteRegistry::instance().add<int, std::string, double>(load_info, nullptr);
+
+    {
+        BinaryLogWriter writer{m_path};
+        auto args = encode(1, std::string{"a"}, 1.0);
+        writer.append_event(site, 1, args.data());
+        writer.flush();
+        writer.append_event(site, 2, args.data());
+    }
+
+    // 模拟进程在写最后一块时退出
+    std::filesystem::resize_file(m_path, std::filesystem::file_size(m_path) - 3);
+
+    BinaryLogDecoder decoder;
+    ASSERT_TRUE(decoder.open(m_path)) << decoder.error();
+    EXPECT_TRUE(decoder.truncated());
+
+    std::ostringstream out;
+    decoder.decode(out, 1);
+    EXPECT_EQ(strip_timestamps(out.str()).size(), 1u);
+}
+
+TEST_F(BinaryLogTest, RejectsForeignFiles) {
+    std::ofstream{m_path} << "this is a plain text log file, not a binary one\n";
+
+    BinaryLogDecoder decoder;
+    EXPECT_FALSE(decoder.open(m_path));
+    EXPECT_FALSE(decoder.error().empty());
+}
+
+TEST_F(BinaryLogTest, EventsAreSmallerThanText) {
+    const auto& site = LogSiteRegistry::instance().add<int, std::string, double>(load_info, nullptr);
+    constexpr int records = 1000;
+
+    size_t text_bytes = 0;
+    {
+        BinaryLogWriter writer{m_path};
+        for (int i = 0; i < records; ++i) {
+            auto args = encode(i, std::string{"/data/set"}, i * 0.5);
+            writer.append_event(site, static_cast<std::uint64_t>(i), args.data());
+            text_bytes += fmt::format("2025-01-01 12:12:12.123456 [INFO] loader.cpp:42 load: loaded {} images from {} in {:.1f} ms\n",
+                                      i, "/data/set", i * 0.5).size();
+        }
+    }
+
+    const auto binary_bytes = std::filesystem::file_size(m_path);
+    EXPECT_LT(binary_bytes * 3, text_bytes);
+}
+
+TEST_F(BinaryLogTest, CallSiteRegisteredOnce) {
+    const size_t before = LogSiteRegistry::instance().size();
+
+    for (int i = 0; i < 10; ++i) {
+        LOG_AT_SITE(PlainLineFormat, 0, "INFO", "iteration {}", i);
+    }
+    EXPECT_EQ(LogSiteRegistry::instance().size(), before + 1);
+
+    LOG_AT_SITE(PlainLineFormat, 0, "INFO", "another call site");
+    EXPECT_EQ(LogSiteRegistry::instance().size(), before + 2);
+}
+
+namespace {
+
+auto traced_function(int value) -> int {
+    TRACE_FUNCTION_LOG();
+    return value * 2;
+}
+
+} // namespace
+
+TEST_F(BinaryLogTest, ThreadRingLoggerWritesBinaryFile) {
+    auto& logger = ThreadRingAsyncLogger::instance();
+    ASSERT_TRUE(logger.open_binary_log(m_path));
+
+    for (int i = 0; i < 3; ++i) {
+        LOG_AT_SITE(PlainLineFormat, 1, "INFO", "frame {} size {}x{}", i, 640, 480.5);
+    }
+    logger.write("raw text\n");
+    EXPECT_EQ(traced_function(21), 42);
+    logger.close_binary_log();
+
+    BinaryLogDecoder decoder;
+    ASSERT_TRUE(decoder.open(m_path)) << decoder.error();
+    EXPECT_EQ(decoder.site_count(), 2u);
+
+    std::ostringstream out;
+    decoder.decode(out);
+    auto lines = strip_timestamps(out.str());
+
+    ASSERT_EQ(lines.size(), 5u);
+    EXPECT_EQ(lines[0], "[INFO] test_binary_log.cpp:188 BinaryLogTest_ThreadRingLoggerWritesBinaryFile_Test::TestBody: frame 0 size 640x480.5");
+    EXPECT_EQ(lines[2], "[INFO] test_binary_log.cpp:188 BinaryLogTest_ThreadRingLoggerWritesBinaryFile_Test::TestBody: frame 2 size 640x480.5");
+    EXPECT_EQ(lines[3], "raw text");
+    EXPECT_TRUE(lines[4].starts_with("[TRACE] test_binary_log.cpp:")) << lines[4];
+    // 函数名来自调用点表, 记录本身只带耗时
+    EXPECT_NE(lines[4].find("traced_function: executed in "), std::string::npos) << lines[4];
+}
+
+// 没有二进制输出时, 函数名由调用点的文本格式补上
+TEST(SiteTracerTest, TextLineNamesFunction) {
+    class LineSink final: public LogSink {
+    public:
+        void write(std::span<const LogRecord> records) override {
+            std::lock_guard<std::mutex> lock{mutex};
+            for (const auto& record: records) lines.emplace_back(record.text);
+        }
+        void flush() override {}
+
+        std::mutex mutex;
+        std::vector<std::string> lines;
+    };
+
+    auto& logger = ThreadRingAsyncLogger::instance();
+    auto sink = std::make_shared<LineSink>();
+    logger.set_sink(sink);
+    EXPECT_EQ(traced_function(1), 2);
+
+    std::string line;
+    for (int i = 0; i < 5000 && line.empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        std::lock_guard<std::mutex> lock{sink->mutex};
+        if (!sink->lines.empty()) line = sink->lines.front();
+    }
+    logger.set_sink(std::make_shared<ConsoleSink>());
+
+    EXPECT_TRUE(line.starts_with("[TRACE] ")) << line;
+    EXPECT_NE(line.find("traced_function executed in "), std::string::npos) << line;
+    EXPECT_TRUE(line.ends_with(" cycles\n")) << line;
+}
@@ -0,0 +1,185 @@
+// ---------------Logger.FanoutSink--------------- //
+//
+//     Description:
+//          Test multi-sink fan-out and the in-memory ring sink
+//
+//     Components:
+//        1. Per-sink level filters
+//        2. Slow sinks do not stall the caller or other sinks
+//        3. RingSink keeps the most recent complete lines
+//        4. Destruction writes every queued batch
+//
+//    Target:
+//        Each sink sees its records in order, independently
+//
+// ----------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <core/async_logger.h>
+#include <core/log_sink.hpp>
+#include <core/site_logger.hpp>
+
+using namespace labelimg::core::logger;
+using namespace std::chrono_literals;
+
+namespace {
+
+// 模拟慢终端: 每次写入都停顿
+class SlowSink final: public LogSink {
+public:
+    void write(std::span<const LogRecord> records) override {
+        std::this_thread::sleep_for(20ms);
+        m_records += records.size();
+    }
+
+    void flush() override {}
+
+    [[nodiscard]] auto records() const -> size_t { return m_records; }
+private:
+    size_t m_records = 0;
+};
+
+// 第一次写入时阻塞, 直到测试放行; 用来让分支队列在析构前保持满
+class GatedSink final: public LogSink {
+public:
+    void write(std::span<const LogRecord> records) override {
+        m_entered.store(true);
+        m_entered.notify_all();
+        m_open.wait(false);
+        m_records += records.size();
+    }
+
+    void flush() override {}
+
+    void wait_entered() const { m_entered.wait(false); }
+    void open() {
+        m_open.store(true);
+        m_open.notify_all();
+    }
+
+    [[nodiscard]] auto records() const -> size_t { return m_records; }
+private:
+    std::atomic<bool> m_entered{false};
+    std::atomic<bool> m_open{false};
+    size_t m_records = 0;
+};
+
+auto count_lines(const std::string& text) -> size_t {
+    return static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+} // namespace
+
+TEST(RingSinkTest, KeepsMostRecentCompleteLines) {
+    RingSink ring{16};
+    const std::vector<LogRecord> first{{.text = "alpha\n"}, {.text = "beta\n"}};
+    ring.write(first);
+    EXPECT_EQ(ring.snapshot(), "alpha\nbeta\n");
+
+    const std::vector<LogRecord> second{{.text = "gamma\n"}, {.text = "delta\n"}};
+    ring.write(second);
+    EXPECT_EQ(ring.snapshot(), "gamma\ndelta\n");
+}
+
+TEST(FanoutSinkTest, FiltersByLevelPerSink) {
+    auto all    = std::make_shared<RingSink>(4096);
+    auto errors = std::make_shared<RingSink>(4096);
+
+    {
+        FanoutSink fanout;
+        fanout.add(all);
+        fanout.add(errors, LogLevel::ERROR);
+
+        const std::vector<LogRecord> batch{
+            {.text = "debug\n", .level = LogLevel::DEBUG},
+            {.text = "info\n",  .level = LogLevel::INFO},
+            {.text = "error\n", .level = LogLevel::ERROR},
+        };
+        fanout.write(batch);
+        fanout.wait_idle();
+    }
+
+    EXPECT_EQ(all->snapshot(), "debug\ninfo\nerror\n");
+    EXPECT_EQ(errors->snapshot(), "error\n");
+}
+
+TEST(FanoutSinkTest, SlowSinkDoesNotStallOthers) {
+    auto fast = std::make_shared<RingSink>(1 << 20);
+    auto slow = std::make_shared<SlowSink>();
+
+    FanoutSink fanout;
+    const size_t fast_index = fanout.add(fast);
+    const size_t slow_index = fanout.add(slow);
+
+    constexpr int batches = 3000;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < batches; ++i) {
+        const std::string line = std::to_string(i) + '\n';
+        const std::vector<LogRecord> batch{{.text = line}};
+        fanout.write(batch);
+    }
+    // 调用方只做一次拷贝和入队, 不等待慢 sink
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+
+    fanout.wait_idle();
+    // 每个批次要么写出, 要么计入该 sink 的丢弃数; 慢 sink 的积压只淘汰它自己的队列
+    EXPECT_EQ(count_lines(fast->snapshot()) + fanout.dropped(fast_index), static_cast<size_t>(batches));
+    EXPECT_EQ(slow->records() + fanout.dropped(slow_index), static_cast<size_t>(batches));
+    EXPECT_GT(fanout.dropped(slow_index), 0u);
+    EXPECT_TRUE(fast->snapshot().ends_with(std::to_string(batches - 1) + '\n'));
+}
+
+TEST(FanoutSinkTest, ThreadRingLoggerKeepsRecordLevels) {
+    auto all    = std::make_shared<RingSink>(4096);
+    auto errors = std::make_shared<RingSink>(4096);
+    auto fanout = std::make_shared<FanoutSink>();
+    fanout->add(all);
+    fanout->add(errors, LogLevel::ERROR);
+
+    auto& logger = ThreadRingAsyncLogger::instance();
+    logger.set_sink(fanout);
+    for (int i = 0; i < 3; ++i) {
+        LOG_AT_SITE(PlainLineFormat, LogLevel::INFO, "INFO", "loaded {}", i);
+        LOG_AT_SITE(PlainLineFormat, LogLevel::ERROR, "ERROR", "failed {}", i);
+    }
+    logger.set_sink(std::make_shared<ConsoleSink>());
+    fanout->wait_idle();
+
+    EXPECT_EQ(count_lines(all->snapshot()), 6u);
+    EXPECT_EQ(count_lines(errors->snapshot()), 3u);
+    EXPECT_EQ(errors->snapshot().find("loaded"), std::string::npos);
+}
+
+TEST(FanoutSinkTest, DestructorKeepsQueuedBatches) {
+    constexpr size_t queue_capacity = 1024;  // 与 FanoutSink 的分支队列容量一致
+    auto sink = std::make_shared<GatedSink>();
+    const std::vector<LogRecord> batch{{.text = "line\n"}};
+
+    std::thread opener;
+    {
+        FanoutSink fanout;
+        fanout.add(sink);
+
+        // 写线程卡在第一批上, 之后的批次恰好填满队列
+        fanout.write(batch);
+        sink->wait_entered();
+        for (size_t i = 0; i < queue_capacity; ++i) fanout.write(batch);
+        ASSERT_EQ(fanout.dropped(0), 0u);
+
+        // 析构开始后才放行写线程
+        opener = std::thread{[&sink] {
+            std::this_thread::sleep_for(50ms);
+            sink->open();
+        }};
+    }
+    opener.join();
+
+    EXPECT_EQ(sink->records(), queue_capacity + 1);
+}
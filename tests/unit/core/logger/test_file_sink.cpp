@@ -0,0 +1,232 @@
+// ---------------Logger.FileSink--------------- //
+//
+//     Description:
+//          Test the batched, rotating file sink
+//
+//     Components:
+//        1. Flush policy by bytes / level / idle flush
+//        2. Size rotation with bounded retained files
+//        3. Async logger back ends writing through a sink
+//        4. Record levels and flush points seen by the sink
+//
+//    Target:
+//        Records reach the file in order with few writev calls
+//
+// -------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <test_utils.hpp>
+
+#include <core/async_logger.h>
+#include <core/log_sink.hpp>
+
+using namespace labelimg::core::logger;
+
+namespace {
+
+class FileSinkTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_dir = test::common::utils::unique_temp_path("file_sink_test");
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+        m_path = m_dir / "app.log";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_dir);
+    }
+
+    [[nodiscard]] static auto read(const std::filesystem::path& path) -> std::string {
+        std::ifstream file{path, std::ios::binary};
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    [[nodiscard]] auto options() const -> FileSinkOptions {
+        return FileSinkOptions{.path = m_path};
+    }
+
+    std::filesystem::path m_dir;
+    std::filesystem::path m_path;
+};
+
+// 记录每条日志的级别以及 write / flush 次数
+class RecordingSink final: public LogSink {
+public:
+    void write(std::span<const LogRecord> records) override {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_writes;
+        for (const auto& record: records) m_records.emplace_back(std::string{record.text}, record.level);
+    }
+
+    void flush() override {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_flushes;
+    }
+
+    [[nodiscard]] auto records() const -> std::vector<std::pair<std::string, LogLevel>> {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_records;
+    }
+
+    [[nodiscard]] auto writes() const -> size_t {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_writes;
+    }
+
+    [[nodiscard]] auto flushes() const -> size_t {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_flushes;
+    }
+private:
+    mutable std::mutex m_mutex;
+    std::vector<std::pair<std::string, LogLevel>> m_records;
+    size_t m_writes  = 0;
+    size_t m_flushes = 0;
+};
+
+template <typename Pred>
+auto wait_until(Pred pred) -> bool {
+    for (int i = 0; i < 5000; ++i) {
+        if (pred()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return pred();
+}
+
+} // namespace
+
+TEST_F(FileSinkTest, SmallBatchesAreBufferedUntilFlush) {
+    FileSink sink{options()};
+    ASSERT_TRUE(sink.is_open());
+
+    const std::vector<LogRecord> batch{{.text = "first\n"}, {.text = "second\n"}};
+    sink.write(batch);
+    sink.write(batch);
+
+    EXPECT_EQ(sink.write_calls(), 0u);
+    EXPECT_EQ(sink.pending_bytes(), 26u);
+    EXPECT_TRUE(read(m_path).empty());
+
+    sink.flush();
+    EXPECT_EQ(sink.write_calls(), 1u);
+    EXPECT_EQ(read(m_path), "first\nsecond\nfirst\nsecond\n");
+}
+
+TEST_F(FileSinkTest, LargeBatchIsWrittenWithOneCall) {
+    auto config = options();
+    config.flush_bytes = 1024;
+    FileSink sink{config};
+
+    std::vector<std::string> lines;
+    for (int i = 0; i < 200; ++i) lines.push_back(fmt::format("line {:03}\n", i));
+
+    std::vector<LogRecord> batch;
+    for (const auto& line: lines) batch.push_back({.text = line});
+    sink.write(batch);
+
+    EXPECT_EQ(sink.write_calls(), 1u);
+    EXPECT_EQ(sink.pending_bytes(), 0u);
+    EXPECT_EQ(read(m_path).size(), 200u * 9u);
+    EXPECT_EQ(read(m_path).substr(0, 18), "line 000\nline 001\n");
+}
+
+TEST_F(FileSinkTest, ErrorLevelIsWrittenImmediately) {
+    FileSink sink{options()};
+
+    const std::vector<LogRecord> info{{.text = "loaded\n", .level = LogLevel::INFO}};
+    const std::vector<LogRecord> error{{.text = "failed\n", .level = LogLevel::ERROR}};
+    sink.write(info);
+    sink.write(error);
+
+    EXPECT_EQ(sink.write_calls(), 1u);
+    EXPECT_EQ(read(m_path), "loaded\nfailed\n");
+}
+
+TEST_F(FileSinkTest, ReopenAppends) {
+    const std::vector<LogRecord> batch{{.text = "run\n"}};
+    for (int i = 0; i < 2; ++i) {
+        FileSink sink{options()};
+        sink.write(batch);
+    }
+    EXPECT_EQ(read(m_path), "run\nrun\n");
+}
+
+TEST_F(FileSinkTest, RotatesBySizeAndKeepsMaxFiles) {
+    auto config = options();
+    config.flush_bytes  = 0;
+    config.rotate_bytes = 20;
+    config.max_files    = 2;
+    FileSink sink{config};
+
+    for (int i = 0; i < 5; ++i) {
+        const std::string line = fmt::format("record {} 0123\n", i);  // 14 字节
+        const std::vector<LogRecord> batch{{.text = line}};
+        sink.write(batch);
+    }
+
+    auto numbered = [this](int index) {
+        std::filesystem::path path = m_path;
+        path += fmt::format(".{}", index);
+        return path;
+    };
+    EXPECT_EQ(read(m_path), "record 4 0123\n");
+    EXPECT_EQ(read(numbered(1)), "record 3 0123\n");
+    EXPECT_EQ(read(numbered(2)), "record 2 0123\n");
+    EXPECT_FALSE(std::filesystem::exists(numbered(3)));
+}
+
+TEST_F(FileSinkTest, ThreadRingLoggerWritesThroughSink) {
+    auto sink = std::make_shared<FileSink>(options());
+    auto& logger = ThreadRingAsyncLogger::instance();
+    logger.set_sink(sink);
+
+    for (int i = 0; i < 100; ++i) logger.log_deferred("frame {}", i);
+    logger.set_sink(std::make_shared<ConsoleSink>());
+
+    const std::string content = read(m_path);
+    EXPECT_EQ(std::count(content.begin(), content.end(), '\n'), 100);
+    EXPECT_TRUE(content.starts_with("frame 0\nframe 1\n"));
+    EXPECT_LT(sink->write_calls(), 100u);
+}
+
+TEST(LogLevelRoutingTest, LogStreamLevelReachesSink) {
+    auto sink = std::make_shared<RecordingSink>();
+    auto& logger = ThreadRingAsyncLogger::instance();
+    logger.set_sink(sink);
+
+    async_log << "loaded";
+    LogStream{LogLevel::ERROR} << "failed";
+    ASSERT_TRUE(wait_until([&sink] { return sink->records().size() == 2; }));
+    logger.set_sink(std::make_shared<ConsoleSink>());
+
+    const auto records = sink->records();
+    EXPECT_EQ(records[0], std::pair(std::string{"loaded\n"}, LogLevel::INFO));
+    EXPECT_EQ(records[1], std::pair(std::string{"failed\n"}, LogLevel::ERROR));
+}
+
+TEST(LogLevelRoutingTest, CoroutineLoggerFlushesOnceDrained) {
+    auto sink = std::make_shared<RecordingSink>();
+    auto& logger = CoroutineAsncLogger::instance();
+    logger.set_sink(sink);
+
+    constexpr size_t count = 500;
+    for (size_t i = 0; i < count; ++i) logger.log_impl(fmt::format("line {}\n", i));
+    ASSERT_TRUE(wait_until([&sink] { return sink->records().size() == count; }));
+    // 最后一批写完时队列已空, 必然写出一次
+    ASSERT_TRUE(wait_until([&sink] { return sink->flushes() >= 1; }));
+    EXPECT_LE(sink->flushes(), sink->writes());
+
+    logger.set_sink(std::make_shared<ConsoleSink>());
+}
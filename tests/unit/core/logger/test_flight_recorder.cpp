@@ -0,0 +1,190 @@
+// ---------------Logger.FlightRecorder--------------- //
+//
+//     Description:
+//          Test the memory-mapped flight recorder ring and its reader
+//
+//     Components:
+//        1. Single- and multi-slot records, ring wrap-around
+//        2. Partially written records are skipped
+//        3. History survives SIGKILL and reopening
+//        4. Concurrent producers and the producer-side hook
+//
+//    Target:
+//        The reader returns the most recent complete records in order
+//
+// -------------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <test_utils.hpp>
+
+#include <core/async_logger.h>
+#include <core/flight_recorder.hpp>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace labelimg::core::logger;
+
+namespace {
+
+class FlightRecorderTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_path = test::common::utils::unique_temp_path("flight_recorder_test", ".bin");
+        std::filesystem::remove(m_path);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(m_path);
+    }
+
+    [[nodiscard]] auto options(size_t capacity = 64 * 1024, size_t slot_size = 64) const -> FlightRecorderOptions {
+        return FlightRecorderOptions{.path = m_path, .capacity = capacity, .slot_size = slot_size};
+    }
+
+    [[nodiscard]] auto read() const -> FlightRecordReader {
+        FlightRecordReader reader;
+        EXPECT_TRUE(reader.open(m_path)) << reader.error();
+        return reader;
+    }
+
+    std::filesystem::path m_path;
+};
+
+} // namespace
+
+TEST_F(FlightRecorderTest, RecordsRoundTrip) {
+    const std::string long_record = std::string(300, 'x') + '\n';
+    {
+        FlightRecorder recorder{options()};
+        ASSERT_TRUE(recorder.is_open());
+        recorder.record("first\n");
+        recorder.record(long_record);
+        recorder.record("last\n");
+    }
+
+    const auto reader = read();
+    ASSERT_EQ(reader.records().size(), 3u);
+    EXPECT_EQ(reader.records()[0], "first\n");
+    EXPECT_EQ(reader.records()[1], long_record);
+    EXPECT_EQ(reader.records()[2], "last\n");
+    EXPECT_EQ(reader.torn(), 0u);
+}
+
+TEST_F(FlightRecorderTest, KeepsMostRecentRecordsAfterWrap) {
+    FlightRecorder recorder{options(16 * 64)};
+    ASSERT_EQ(recorder.slot_count(), 16u);
+    for (int i = 0; i < 100; ++i) recorder.record("record " + std::to_string(i) + '\n');
+
+    const auto reader = read();
+    ASSERT_EQ(reader.records().size(), 16u);
+    EXPECT_EQ(reader.records().front(), "record 84\n");
+    EXPECT_EQ(reader.records().back(), "record 99\n");
+    EXPECT_EQ(reader.next_sequence(), 100u);
+}
+
+TEST_F(FlightRecorderTest, PartiallyWrittenRecordIsSkipped) {
+    {
+        FlightRecorder recorder{options()};
+        recorder.record("before\n");
+        recorder.record(std::string(150, 'y'));  // 占四个槽
+        recorder.record("after\n");
+    }
+
+    // 模拟拷贝中途被杀死: 中间槽的序号仍为 0
+    std::fstream file{m_path, std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(static_cast<std::streamoff>(sizeof(detail::FlightRecorderHeader) + 2 * 64));
+    const std::uint64_t zero = 0;
+    file.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+    file.close();
+
+    const auto reader = read();
+    ASSERT_EQ(reader.records().size(), 2u);
+    EXPECT_EQ(reader.records()[0], "before\n");
+    EXPECT_EQ(reader.records()[1], "after\n");
+    EXPECT_GT(reader.torn(), 0u);
+}
+
+TEST_F(FlightRecorderTest, ReopenContinuesHistory) {
+    {
+        FlightRecorder recorder{options()};
+        recorder.record("run 1\n");
+    }
+    {
+        FlightRecorder recorder{options()};
+        recorder.record("run 2\n");
+    }
+
+    const auto reader = read();
+    ASSERT_EQ(reader.records().size(), 2u);
+    EXPECT_EQ(reader.records()[0], "run 1\n");
+    EXPECT_EQ(reader.records()[1], "run 2\n");
+}
+
+#if !defined(_WIN32)
+TEST_F(FlightRecorderTest, HistorySurvivesSigkill) {
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        FlightRecorder recorder{options()};
+        for (int i = 0; i < 500; ++i) recorder.record("frame " + std::to_string(i) + '\n');
+        // 不执行任何析构与刷新
+        ::raise(SIGKILL);
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFSIGNALED(status));
+
+    const auto reader = read();
+    ASSERT_FALSE(reader.records().empty());
+    EXPECT_EQ(reader.records().back(), "frame 499\n");
+    EXPECT_EQ(reader.torn(), 0u);
+}
+#endif
+
+TEST_F(FlightRecorderTest, ConcurrentProducersKeepPerThreadOrder) {
+    FlightRecorder recorder{options(1024 * 1024)};
+
+    constexpr int threads = 4;
+    constexpr int per_thread = 1000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([&recorder, t] {
+            for (int i = 0; i < per_thread; ++i)
+                recorder.record(std::to_string(t) + ' ' + std::to_string(i) + '\n');
+        });
+    }
+    for (auto& producer: producers) producer.join();
+
+    const auto reader = read();
+    ASSERT_EQ(reader.records().size(), static_cast<size_t>(threads * per_thread));
+
+    std::vector<int> next(threads, 0);
+    for (const auto& record: reader.records()) {
+        const int t = record[0] - '0';
+        EXPECT_EQ(record, std::to_string(t) + ' ' + std::to_string(next[t]) + '\n');
+        ++next[t];
+    }
+}
+
+TEST_F(FlightRecorderTest, InstalledRecorderCapturesBeforeQueueing) {
+    auto recorder = std::make_shared<FlightRecorder>(options());
+    FlightRecorder::install(recorder);
+    async_log << "queued " << 42;
+    FlightRecorder::install(nullptr);
+
+    // 后台线程是否已写出无关紧要, 记录在入队前已完成
+    const auto reader = read();
+    ASSERT_EQ(reader.records().size(), 1u);
+    EXPECT_EQ(reader.records()[0], "queued 42\n");
+}
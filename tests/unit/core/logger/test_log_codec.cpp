@@ -0,0 +1,121 @@
+// ---------------Logger.LogCodec--------------- //
+//
+//     Description:
+//          Test binary argument capture for deferred formatting
+//
+//     Components:
+//        1. LogArgCodec for arithmetic / enum / string / path
+//        2. DeferredFormat encode -> format round trip
+//        3. User-provided LogArgCodec specializations
+//        4. Null C strings and compile-time-only format strings
+//
+//    Target:
+//        Deferred output equals eager fmt::format output
+//
+// --------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <core/log_codec.hpp>
+
+using namespace labelimg::core::logger;
+
+namespace {
+
+struct Point {
+    int x;
+    int y;
+};
+
+enum class Shape: std::uint8_t { Rect = 1, Polygon = 2 };
+
+// 模拟调用方编码, 日志线程解码
+template <typename... Args>
+auto round_trip(std::string_view format, const Args&... args) -> std::string {
+    std::vector<std::byte> encoded(DeferredFormat<Args...>::encoded_size(args...));
+    std::byte* end = DeferredFormat<Args...>::encode(encoded.data(), args...);
+    EXPECT_EQ(end, encoded.data() + encoded.size());
+
+    fmt::memory_buffer out;
+    DeferredFormat<Args...>::format(format, encoded.data(), out);
+    return fmt::to_string(out);
+}
+
+} // namespace
+
+// 自定义类型按两个整数编码, 解码为字符串
+template <>
+struct labelimg::core::logger::LogArgCodec<Point> {
+    using decoded_type = std::string;
+
+    static constexpr auto size(const Point&) noexcept -> size_t { return 2 * sizeof(int); }
+
+    static auto encode(std::byte* out, const Point& point) noexcept -> std::byte* {
+        out = detail::store(out, point.x);
+        return detail::store(out, point.y);
+    }
+
+    static auto decode(const std::byte*& in) -> std::string {
+        int x = detail::load<int>(in);
+        int y = detail::load<int>(in);
+        return fmt::format("({}, {})", x, y);
+    }
+};
+
+TEST(LogCodecTest, ArithmeticArgumentsRoundTrip) {
+    EXPECT_EQ(round_trip("{} {} {:.3f} {} {}", 42, -7LL, 3.14159, true, 'c'), "42 -7 3.142 true c");
+    EXPECT_EQ(round_trip("{:#x}", 255U), "0xff");
+}
+
+TEST(LogCodecTest, StringArgumentsAreCopied) {
+    std::string owned = "owned";
+    const char* pointer = "pointer";
+    std::string_view view = "view";
+
+    std::vector<std::byte> encoded(DeferredFormat<std::string>::encoded_size(owned));
+    DeferredFormat<std::string>::encode(encoded.data(), owned);
+    // 编码后修改原字符串不影响记录
+    owned.assign("changed");
+    fmt::memory_buffer out;
+    DeferredFormat<std::string>::format("{}", encoded.data(), out);
+    EXPECT_EQ(fmt::to_string(out), "owned");
+
+    EXPECT_EQ(round_trip("{}|{}|{}|{}", pointer, view, "literal", std::string{}), "pointer|view|literal|");
+}
+
+TEST(LogCodecTest, NullCStringIsEncodedAsNull) {
+    const char* null = nullptr;
+    char* mutable_null = nullptr;
+    EXPECT_EQ(round_trip("[{}] [{}]", null, mutable_null), "[(null)] [(null)]");
+}
+
+// 记录里只保存格式串指针, 运行时格式串在格式化前可能已被释放
+static_assert(!std::is_constructible_v<deferred_format_string<int>, decltype(fmt::runtime(""))>);
+
+TEST(LogCodecTest, DeferredFormatStringKeepsLiteral) {
+    constexpr deferred_format_string<int, std::string> format{"{} {}"};
+    static_assert(format.get() == "{} {}");
+    EXPECT_EQ(round_trip(format.get(), 1, std::string{"a"}), "1 a");
+}
+
+TEST(LogCodecTest, EnumsAndPathsAreEncoded) {
+    std::filesystem::path path = "images/cat 01.png";
+    EXPECT_EQ(round_trip("{} {}", Shape::Polygon, path), "2 images/cat 01.png");
+}
+
+TEST(LogCodecTest, UserSpecializationIsUsed) {
+    EXPECT_EQ(round_trip("box at {} size {}", Point{3, 4}, 10), "box at (3, 4) size 10");
+}
+
+TEST(LogCodecTest, FormatLineAppendsNewline) {
+    std::vector<std::byte> encoded(DeferredFormat<int>::encoded_size(1));
+    DeferredFormat<int>::encode(encoded.data(), 1);
+
+    fmt::memory_buffer out;
+    DeferredFormat<int>::format_line("n={}", encoded.data(), out);
+    EXPECT_EQ(fmt::to_string(out), "n=1\n");
+}
@@ -0,0 +1,97 @@
+// ---------------Logger.LogLevel--------------- //
+//
+//     Description:
+//          Test compile-time and runtime log level filtering
+//
+//     Components:
+//        1. LogFilter per-category thresholds
+//        2. LogFilter::configure spec parsing
+//        3. LOG_IF_ENABLED skips argument evaluation
+//
+//    Target:
+//        Disabled log statements do no work at all
+//
+// -------------------------------------------- //
+
+#include <gtest/gtest.h>
+
+#include <core/formatter/log_level.h>
+#include <core/site_logger.hpp>
+
+using namespace labelimg::core::formatter;
+using labelimg::core::logger::LogSiteRegistry;
+using labelimg::core::logger::PlainLineFormat;
+
+namespace {
+
+class LogLevelTest: public ::testing::Test {
+protected:
+    // 阈值是进程级状态, 每个用例结束后恢复默认
+    void TearDown() override {
+        LogFilter::set_threshold(LogLevel::INFO);
+    }
+};
+
+} // namespace
+
+TEST_F(LogLevelTest, DefaultThresholdIsInfo) {
+    EXPECT_EQ(LogFilter::threshold(LogCategory::GENERAL), LogLevel::INFO);
+    EXPECT_FALSE(LogFilter::enabled(LogCategory::WIDGET, LogLevel::DEBUG));
+    EXPECT_TRUE(LogFilter::enabled(LogCategory::WIDGET, LogLevel::INFO));
+    EXPECT_TRUE(LogFilter::enabled(LogCategory::CORE, LogLevel::FATAL_ERROR));
+}
+
+TEST_F(LogLevelTest, CategoriesAreIndependent) {
+    LogFilter::set_threshold(LogCategory::WIDGET, LogLevel::DEBUG);
+    LogFilter::set_threshold(LogCategory::CORE, LogLevel::ERROR);
+
+    EXPECT_TRUE(LogFilter::enabled(LogCategory::WIDGET, LogLevel::DEBUG));
+    EXPECT_FALSE(LogFilter::enabled(LogCategory::CORE, LogLevel::WARNING));
+    EXPECT_TRUE(LogFilter::enabled(LogCategory::CORE, LogLevel::ERROR));
+    EXPECT_FALSE(LogFilter::enabled(LogCategory::PAGE, LogLevel::DEBUG));
+}
+
+TEST_F(LogLevelTest, ConfigureAppliesItemsInOrder) {
+    EXPECT_TRUE(LogFilter::configure("warning,widget=debug,core=error"));
+
+    EXPECT_EQ(LogFilter::threshold(LogCategory::GENERAL), LogLevel::WARNING);
+    EXPECT_EQ(LogFilter::threshold(LogCategory::PAGE), LogLevel::WARNING);
+    EXPECT_EQ(LogFilter::threshold(LogCategory::WIDGET), LogLevel::DEBUG);
+    EXPECT_EQ(LogFilter::threshold(LogCategory::CORE), LogLevel::ERROR);
+}
+
+TEST_F(LogLevelTest, ConfigureReportsUnknownItems) {
+    EXPECT_FALSE(LogFilter::configure("page=verbose,camera=debug,,window=success"));
+
+    // 无法识别的项被跳过, 其余项仍然生效
+    EXPECT_EQ(LogFilter::threshold(LogCategory::PAGE), LogLevel::INFO);
+    EXPECT_EQ(LogFilter::threshold(LogCategory::WINDOW), LogLevel::SUCCESS);
+}
+
+TEST_F(LogLevelTest, DisabledStatementDoesNotEvaluateArguments) {
+    int evaluated = 0;
+    auto expensive = [&evaluated] { return ++evaluated; };
+
+    LOG_IF_ENABLED(LogCategory::WIDGET, LogLevel::DEBUG, (void)expensive());
+    EXPECT_EQ(evaluated, 0);
+
+    LogFilter::set_threshold(LogCategory::WIDGET, LogLevel::DEBUG);
+    LOG_IF_ENABLED(LogCategory::WIDGET, LogLevel::DEBUG, (void)expensive());
+    EXPECT_EQ(evaluated, 1);
+}
+
+TEST_F(LogLevelTest, DisabledCallSiteIsNotRegistered) {
+    LogFilter::set_threshold(LogLevel::WARNING);
+    const size_t before = LogSiteRegistry::instance().size();
+
+    for (int i = 0; i < 100; ++i) {
+        LOG_IF_ENABLED(LogCategory::CORE, LogLevel::INFO,
+                       LOG_AT_SITE(PlainLineFormat, LogLevel::INFO, "INFO", "scanned {}", i));
+    }
+    EXPECT_EQ(LogSiteRegistry::instance().size(), before);
+}
+
+TEST_F(LogLevelTest, CompileTimeMinimumLevel) {
+    static_assert(log_level_compiled<LogLevel::FATAL_ERROR>);
+    EXPECT_EQ(log_level_compiled<LogLevel::DEBUG>, min_log_level == LogLevel::DEBUG);
+}
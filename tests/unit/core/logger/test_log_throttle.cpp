@@ -0,0 +1,197 @@
+// ---------------Logger.LogThrottle--------------- //
+//
+//     Description:
+//          Test per-call-site rate limiting and duplicate collapsing
+//
+//     Components:
+//        1. Identical payloads are counted, not written
+//        2. Token bucket bounds distinct payloads per second
+//        3. Suppressed / repeated counts are reported on the next write
+//        4. Counts left when a flood stops are reported by the timer or on flush
+//
+//    Target:
+//        Bounded output under floods without losing the signal
+//
+// ----------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <core/log_throttle.hpp>
+
+using namespace labelimg::core::logger;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Clock = LogThrottle::Clock;
+
+// reporter 只能是函数指针, 收到的汇总记在这里
+struct Reports {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<ThrottleDecision> decisions;
+
+    static auto instance() -> Reports& {
+        static Reports reports;
+        return reports;
+    }
+
+    static void record(const ThrottleDecision& decision) {
+        auto& reports = instance();
+        {
+            std::lock_guard<std::mutex> lock{reports.mutex};
+            reports.decisions.push_back(decision);
+        }
+        reports.cond.notify_all();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock{mutex};
+        decisions.clear();
+    }
+
+    auto wait_for(size_t count, std::chrono::milliseconds timeout) -> std::vector<ThrottleDecision> {
+        std::unique_lock<std::mutex> lock{mutex};
+        cond.wait_for(lock, timeout, [&] { return decisions.size() >= count; });
+        return std::exchange(decisions, {});
+    }
+};
+
+class LogThrottleReportTest: public ::testing::Test {
+protected:
+    void SetUp() override { Reports::instance().clear(); }
+};
+
+} // namespace
+
+TEST(LogThrottleTest, SiteKeysDifferPerCallSite) {
+    constexpr auto first  = make_throttle_site_key(std::source_location::current());
+    constexpr auto second = make_throttle_site_key(std::source_location::current());
+    EXPECT_NE(first, second);
+
+    LOG_THROTTLE_AT_SITE(throttle);
+    EXPECT_NE(throttle.site_key(), 0u);
+}
+
+TEST(LogThrottleTest, CollapsesRepeatedPayload) {
+    LogThrottle throttle{1};
+    const auto start = Clock::now();
+
+    EXPECT_TRUE(throttle.admit("Mouse Released", start).emit);
+    for (int i = 0; i < 999; ++i) EXPECT_FALSE(throttle.admit("Mouse Released", start).emit);
+
+    const auto next = throttle.admit("other", start);
+    EXPECT_TRUE(next.emit);
+    EXPECT_EQ(next.repeated, 999u);
+    EXPECT_EQ(next.suppressed, 0u);
+}
+
+TEST(LogThrottleTest, ReportsOngoingRepeatsPerInterval) {
+    LogThrottle throttle{1, ThrottlePolicy{.report_interval = 100ms}};
+    const auto start = Clock::now();
+
+    EXPECT_TRUE(throttle.admit("tick", start).emit);
+    for (int i = 1; i <= 50; ++i) EXPECT_FALSE(throttle.admit("tick", start + 1ms * i).has_report());
+
+    // 到了报告间隔: 只写出汇总, 本条仍被折叠
+    const auto report = throttle.admit("tick", start + 100ms);
+    EXPECT_FALSE(report.emit);
+    EXPECT_EQ(report.repeated, 51u);
+
+    const auto next = throttle.admit("tock", start + 101ms);
+    EXPECT_TRUE(next.emit);
+    EXPECT_EQ(next.repeated, 0u);
+}
+
+TEST(LogThrottleTest, TokenBucketBoundsDistinctPayloads) {
+    LogThrottle throttle{1, ThrottlePolicy{.per_second = 10, .burst = 5}};
+    const auto start = Clock::now();
+
+    int emitted = 0;
+    for (int i = 0; i < 1000; ++i) emitted += throttle.admit(std::to_string(i), start).emit;
+    EXPECT_EQ(emitted, 5);
+
+    // 100ms 补充一个令牌; 丢弃的条数随下一次写出报告
+    const auto next = throttle.admit("after", start + 100ms);
+    EXPECT_TRUE(next.emit);
+    EXPECT_EQ(next.suppressed, 995u);
+    EXPECT_FALSE(throttle.admit("again", start + 100ms).emit);
+}
+
+TEST(LogThrottleTest, RepeatsOfSuppressedPayloadCountAsSuppressed) {
+    LogThrottle throttle{1, ThrottlePolicy{.per_second = 1, .burst = 1}};
+    const auto start = Clock::now();
+
+    EXPECT_TRUE(throttle.admit("a", start).emit);
+    EXPECT_FALSE(throttle.admit("b", start).emit);
+    EXPECT_FALSE(throttle.admit("b", start).emit);
+
+    const auto next = throttle.admit("c", start + 1s);
+    EXPECT_TRUE(next.emit);
+    EXPECT_EQ(next.repeated, 0u);
+    EXPECT_EQ(next.suppressed, 2u);
+}
+
+TEST(LogThrottleTest, TakePendingDrainsCountsWithoutToken) {
+    LogThrottle throttle{1, ThrottlePolicy{.per_second = 1, .burst = 1}};
+    const auto start = Clock::now();
+
+    EXPECT_TRUE(throttle.admit("a", start).emit);
+    for (int i = 0; i < 9; ++i) EXPECT_FALSE(throttle.admit("a", start).emit);
+    EXPECT_FALSE(throttle.admit("b", start).emit);
+
+    const auto pending = throttle.take_pending(start);
+    EXPECT_FALSE(pending.emit);
+    EXPECT_EQ(pending.repeated, 0u);
+    EXPECT_EQ(pending.suppressed, 10u);
+    EXPECT_FALSE(throttle.take_pending(start).has_report());
+}
+
+// 刷屏停止后没有下一次调用, 汇总仍由共享计时器在 report_interval 后写出
+TEST_F(LogThrottleReportTest, ReportsTailAfterFloodStops) {
+    LogThrottle throttle{1, ThrottlePolicy{.report_interval = 20ms}, &Reports::record};
+
+    int emitted = 0;
+    for (int i = 0; i < 100; ++i) emitted += throttle.admit("Mouse Released").emit;
+    EXPECT_EQ(emitted, 1);
+
+    const auto reports = Reports::instance().wait_for(1, 5s);
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_FALSE(reports[0].emit);
+    EXPECT_EQ(reports[0].repeated, 99u);
+    EXPECT_EQ(reports[0].suppressed, 0u);
+
+    // 已经报告过, 计时器不会再写出
+    EXPECT_TRUE(Reports::instance().wait_for(1, 100ms).empty());
+}
+
+TEST_F(LogThrottleReportTest, FlushReportsPendingCounts) {
+    LogThrottle throttle{1, ThrottlePolicy{.report_interval = std::chrono::hours(1)}, &Reports::record};
+
+    for (int i = 0; i < 5; ++i) std::ignore = throttle.admit("tick");
+    flush_throttles();
+
+    const auto reports = Reports::instance().wait_for(1, 0ms);
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_EQ(reports[0].repeated, 4u);
+
+    flush_throttles();
+    EXPECT_TRUE(Reports::instance().wait_for(1, 0ms).empty());
+}
+
+// 调用点析构时写出未报告的计数, 之后已登记的计时任务不再访问它
+TEST_F(LogThrottleReportTest, DestroyedThrottleReportsPendingOnce) {
+    {
+        LogThrottle throttle{1, ThrottlePolicy{.report_interval = 20ms}, &Reports::record};
+        for (int i = 0; i < 5; ++i) std::ignore = throttle.admit("tick");
+    }
+    const auto reports = Reports::instance().wait_for(2, 100ms);
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_EQ(reports[0].repeated, 4u);
+}
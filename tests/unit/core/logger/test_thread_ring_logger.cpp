@@ -0,0 +1,154 @@
+// ---------------Logger.ThreadRingLogger--------------- //
+//
+//     Description:
+//          Test the per-thread ring logger back end and its drain thread
+//
+//     Components:
+//        1. Threads started during sustained logging are drained
+//        2. Output switches complete under sustained logging
+//        3. An idle (parked) drain thread is woken by the next record
+//        4. async_log shares the back end with deferred records
+//
+//    Target:
+//        Every record is written, without the drain thread polling when idle
+//
+// ---------------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <core/async_logger.h>
+
+using namespace labelimg::core::logger;
+using namespace std::chrono_literals;
+
+namespace {
+
+// 按顺序保留非 "spam" 开头的行, 统计 spam 行数; delay 模拟较慢的输出端
+class CollectingSink final: public LogSink {
+public:
+    explicit CollectingSink(std::chrono::microseconds delay = {}): m_delay{delay} {}
+
+    void write(std::span<const LogRecord> records) override {
+        std::this_thread::sleep_for(m_delay);
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for (const auto& record: records) {
+            if (record.text.starts_with("spam")) ++m_spam;
+            else m_lines.emplace_back(record.text);
+        }
+    }
+
+    void flush() override {}
+
+    [[nodiscard]] auto contains(const std::string& line) const -> bool {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return std::ranges::find(m_lines, line) != m_lines.end();
+    }
+
+    [[nodiscard]] auto lines() const -> std::vector<std::string> {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_lines;
+    }
+
+    [[nodiscard]] auto spam() const -> size_t {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_spam;
+    }
+private:
+    const std::chrono::microseconds m_delay;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::string> m_lines;
+    size_t m_spam = 0;
+};
+
+template <typename Pred>
+auto wait_until(Pred pred, std::chrono::milliseconds timeout = 5s) -> bool {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(ThreadRingLoggerTest, NewThreadsAreDrainedDuringSustainedLogging) {
+    auto& logger = ThreadRingAsyncLogger::instance();
+    // 输出比写入慢: 写入线程的环在整个测试期间都不会被排空
+    auto sink = std::make_shared<CollectingSink>(500us);
+    logger.set_sink(sink);
+
+    std::atomic<bool> stop{false};
+    // 两个写入线程的长记录让输出缓冲在一轮中途就达到写出阈值, 慢输出端写出期间它们又填满各自的环
+    std::vector<std::thread> spammers;
+    for (int s = 0; s < 2; ++s) {
+        spammers.emplace_back([&logger, &stop] {
+            const std::string padding(1024, '.');
+            for (size_t i = 0; !stop.load(std::memory_order_relaxed); ++i) logger.log_deferred("spam {} {}", i, padding);
+        });
+    }
+    ASSERT_TRUE(wait_until([&sink] { return sink->spam() > 0; }));
+
+    // 每个新线程写完即退出, 它的环只能由后台线程在之后的轮次中发现
+    constexpr int threads = 8;
+    for (int t = 0; t < threads; ++t) {
+        std::thread{[&logger, t] { logger.log_deferred("late thread {}", t); }}.join();
+    }
+    for (int t = 0; t < threads; ++t) {
+        const std::string line = "late thread " + std::to_string(t) + "\n";
+        EXPECT_TRUE(wait_until([&sink, &line] { return sink->contains(line); })) << line;
+    }
+
+    // 切换输出端要等待排空轮次推进; 持续写入时也必须完成
+    auto next = std::make_shared<CollectingSink>(500us);
+    logger.set_sink(next);
+    EXPECT_TRUE(wait_until([&next] { return next->spam() > 0; }));
+
+    stop = true;
+    for (auto& spammer: spammers) spammer.join();
+    logger.set_sink(std::make_shared<ConsoleSink>());
+}
+
+TEST(ThreadRingLoggerTest, IdleDrainThreadIsWokenByNextRecord) {
+    auto& logger = ThreadRingAsyncLogger::instance();
+    auto sink = std::make_shared<CollectingSink>();
+    logger.set_sink(sink);
+
+    logger.log_deferred("before idle");
+    ASSERT_TRUE(wait_until([&sink] { return sink->contains("before idle\n"); }));
+
+    // 足够让空闲轮询退避到上限并停放
+    std::this_thread::sleep_for(200ms);
+
+    const auto start = std::chrono::steady_clock::now();
+    logger.log_deferred("after idle");
+    EXPECT_TRUE(wait_until([&sink] { return sink->contains("after idle\n"); }));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+
+    logger.set_sink(std::make_shared<ConsoleSink>());
+}
+
+TEST(ThreadRingLoggerTest, LogStreamSharesBackEndWithDeferredRecords) {
+    auto& logger = ThreadRingAsyncLogger::instance();
+    auto sink = std::make_shared<CollectingSink>();
+    logger.set_sink(sink);
+
+    // 两种写法进入同一个后台线程, 同一线程内保持先后顺序
+    async_log << "stream " << 1;
+    logger.log_deferred("deferred {}", 2);
+    async_log << "stream " << 3;
+    ASSERT_TRUE(wait_until([&sink] { return sink->contains("stream 3\n"); }));
+
+    const std::vector<std::string> expected{"stream 1\n", "deferred 2\n", "stream 3\n"};
+    EXPECT_EQ(sink->lines(), expected);
+
+    logger.set_sink(std::make_shared<ConsoleSink>());
+}
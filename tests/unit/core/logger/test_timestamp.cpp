@@ -0,0 +1,135 @@
+// ---------------Logger.Timestamp--------------- //
+//
+//     Description:
+//          Test the cached timestamp formatter
+//
+//     Components:
+//        1. Every TimestampFormat against strftime on the same time
+//        2. Millisecond patching within a cached second
+//        3. Per-thread caches under concurrent use
+//
+//    Target:
+//        Same text as strftime, without allocation or locks
+//
+// --------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <core/formatter/timestamp.h>
+
+using namespace labelimg::core::formatter;
+using namespace std::chrono_literals;
+using detail::TimestampFormatter;
+
+namespace {
+
+using Clock = TimestampFormatter::Clock;
+
+// 参照实现: strftime + 毫秒
+auto reference(TimestampFormat format, Clock::time_point now) -> std::string {
+    const auto second = std::chrono::floor<std::chrono::seconds>(now.time_since_epoch());
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch() - second).count();
+    const auto time = static_cast<std::time_t>(second.count());
+
+    std::tm parts{};
+#if defined(_WIN32)
+    if (format == TimestampFormat::IOS8601) gmtime_s(&parts, &time);
+    else                                    localtime_s(&parts, &time);
+#else
+    if (format == TimestampFormat::IOS8601) gmtime_r(&time, &parts);
+    else                                    localtime_r(&time, &parts);
+#endif
+
+    char text[64];
+    size_t size = 0;
+    switch (format) {
+        case TimestampFormat::IOS8601:   size = std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%S", &parts); break;
+        case TimestampFormat::SIMPLE:    size = std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &parts); break;
+        case TimestampFormat::TIME_ONLY: size = std::strftime(text, sizeof(text), "%H:%M:%S", &parts);          break;
+        case TimestampFormat::COMPACT:   size = std::strftime(text, sizeof(text), "%Y%m%d_%H%M%S", &parts);     break;
+        case TimestampFormat::RELATIVE:  break;
+    }
+    std::string result{text, size};
+
+    char suffix[8];
+    if (format == TimestampFormat::IOS8601) {
+        std::snprintf(suffix, sizeof(suffix), ".%03dZ", static_cast<int>(millis));
+        result += suffix;
+    } else if (format == TimestampFormat::TIME_ONLY) {
+        std::snprintf(suffix, sizeof(suffix), ".%03d", static_cast<int>(millis));
+        result += suffix;
+    }
+    return result;
+}
+
+auto format(TimestampFormat format, Clock::time_point now) -> std::string {
+    return std::string{TimestampFormatter::view(format, now)};
+}
+
+constexpr TimestampFormat wall_formats[] = {
+    TimestampFormat::IOS8601, TimestampFormat::SIMPLE, TimestampFormat::TIME_ONLY, TimestampFormat::COMPACT,
+};
+
+} // namespace
+
+TEST(TimestampFormatterTest, IsoIsUtcWithMilliseconds) {
+    // 2025-01-01T12:12:12.123Z
+    const Clock::time_point now{1735733532123ms};
+    EXPECT_EQ(format(TimestampFormat::IOS8601, now), "2025-01-01T12:12:12.123Z");
+}
+
+TEST(TimestampFormatterTest, MatchesStrftimeForAllWallFormats) {
+    const Clock::time_point base{1735733532000ms};
+    // 同一秒内的多个毫秒值, 跨秒、跨日、跨年的时间点
+    const std::vector<Clock::time_point> points{
+        base, base + 1ms, base + 999ms, base + 1s, base + 1s + 7ms,
+        base + 12h, base + 24h * 365 + 59s + 500ms, Clock::time_point{0ms}, Clock::time_point{999ms},
+    };
+
+    for (const auto format_kind: wall_formats) {
+        for (const auto point: points)
+            EXPECT_EQ(format(format_kind, point), reference(format_kind, point));
+    }
+}
+
+TEST(TimestampFormatterTest, TimeOnlyUsesSeparators) {
+    const auto text = format(TimestampFormat::TIME_ONLY, Clock::now());
+    EXPECT_TRUE(std::regex_match(text, std::regex{R"(\d\d:\d\d:\d\d\.\d{3})"})) << text;
+}
+
+TEST(TimestampFormatterTest, RelativeIsSecondsWithMilliseconds) {
+    const auto text = format(TimestampFormat::RELATIVE, Clock::now());
+    EXPECT_TRUE(std::regex_match(text, std::regex{R"(\+\d+\.\d{3}s)"})) << text;
+}
+
+TEST(TimestampFormatterTest, FixedWidthPadsWithSpaces) {
+    const auto text = TimestampFormatter::format_timestamp_fixed_width(TimestampFormat::COMPACT, 19);
+    ASSERT_EQ(text.size(), 19u);
+    EXPECT_EQ(text.substr(15), "    ");
+}
+
+TEST(TimestampFormatterTest, ThreadsKeepSeparateCaches) {
+    const Clock::time_point base{1735733532000ms};
+
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&mismatches, base, t] {
+            for (int i = 0; i < 2000; ++i) {
+                const auto point = base + std::chrono::milliseconds(i * 7 + t * 1000);
+                for (const auto format_kind: wall_formats)
+                    mismatches[t] += format(format_kind, point) != reference(format_kind, point);
+            }
+        });
+    }
+    for (auto& thread: threads) thread.join();
+
+    for (const int count: mismatches) EXPECT_EQ(count, 0);
+}
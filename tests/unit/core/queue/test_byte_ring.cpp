@@ -0,0 +1,130 @@
+// ---------------Queue.SpscByteRing--------------- //
+//
+//     Description:
+//          Test variable-length SPSC byte ring
+//
+//     Components:
+//        1. try_reserve / commit / front / pop
+//        2. Wrap-around padding
+//        3. Bounded consumption up to a published position
+//        4. Concurrent producer / consumer
+//
+//    Target:
+//        Records come out intact and in order
+//
+// ------------------------------------------------ //
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <core/queue/byte_ring.hpp>
+
+using namespace labelimg::core::queue;
+
+namespace {
+
+template <std::size_t Capacity>
+auto write(SpscByteRing<Capacity>& ring, std::string_view text) -> bool {
+    std::byte* bytes = ring.try_reserve(text.size());
+    if (bytes == nullptr) return false;
+    std::memcpy(bytes, text.data(), text.size());
+    ring.commit();
+    return true;
+}
+
+template <std::size_t Capacity>
+auto read(SpscByteRing<Capacity>& ring) -> std::string {
+    auto record = ring.front();
+    std::string text{reinterpret_cast<const char*>(record.data()), record.size()};
+    if (!record.empty()) ring.pop();
+    return text;
+}
+
+} // namespace
+
+TEST(ByteRingTest, RecordsRoundTripInOrder) {
+    SpscByteRing<256> ring;
+    EXPECT_TRUE(ring.front().empty());
+
+    ASSERT_TRUE(write(ring, "a"));
+    ASSERT_TRUE(write(ring, "hello"));
+    ASSERT_TRUE(write(ring, "0123456789abcdef"));
+
+    EXPECT_EQ(read(ring), "a");
+    EXPECT_EQ(read(ring), "hello");
+    EXPECT_EQ(read(ring), "0123456789abcdef");
+    EXPECT_TRUE(ring.front().empty());
+    EXPECT_EQ(ring.used_bytes(), 0U);
+}
+
+TEST(ByteRingTest, FullAndOversizedReservationsFail) {
+    SpscByteRing<128> ring;
+    const std::string record(40, 'x');
+
+    // 每条记录占 8 + 40 = 48 字节, 128 字节只放得下两条
+    EXPECT_TRUE(write(ring, record));
+    EXPECT_TRUE(write(ring, record));
+    EXPECT_FALSE(write(ring, record));
+    EXPECT_EQ(ring.try_reserve(SpscByteRing<128>::max_record_size + 1), nullptr);
+    EXPECT_EQ(ring.try_reserve(0), nullptr);
+
+    EXPECT_EQ(read(ring), record);
+    EXPECT_TRUE(write(ring, record));
+}
+
+TEST(ByteRingTest, WrapsAroundWithOddSizes) {
+    SpscByteRing<256> ring;
+
+    for (int i = 0; i < 1000; ++i) {
+        std::string text(static_cast<std::size_t>(1 + i % 37), static_cast<char>('a' + i % 26));
+        ASSERT_TRUE(write(ring, text)) << i;
+        ASSERT_EQ(read(ring), text) << i;
+    }
+    EXPECT_TRUE(ring.front().empty());
+}
+
+TEST(ByteRingTest, FrontStopsAtPublishedLimit) {
+    SpscByteRing<256> ring;
+
+    // 跨越回绕填充也恰好停在 limit
+    for (int round = 0; round < 50; ++round) {
+        const std::string text(static_cast<std::size_t>(1 + round % 29), 'x');
+        ASSERT_TRUE(write(ring, text));
+        ASSERT_TRUE(write(ring, text));
+        const std::size_t limit = ring.published();
+        ASSERT_TRUE(write(ring, "later"));
+
+        for (int i = 0; i < 2; ++i) {
+            auto record = ring.front(limit);
+            ASSERT_EQ(record.size(), text.size()) << round;
+            ring.pop();
+        }
+        EXPECT_TRUE(ring.front(limit).empty());
+        EXPECT_EQ(read(ring), "later");
+    }
+}
+
+TEST(ByteRingTest, ConcurrentProducerConsumer) {
+    SpscByteRing<1024> ring;
+    constexpr int count = 100'000;
+
+    std::thread producer{[&] {
+        for (int i = 0; i < count; ++i) {
+            std::string text = std::to_string(i) + std::string(static_cast<std::size_t>(i % 50), '.');
+            while (!write(ring, text)) std::this_thread::yield();
+        }
+    }};
+
+    for (int i = 0; i < count; ++i) {
+        std::string expected = std::to_string(i) + std::string(static_cast<std::size_t>(i % 50), '.');
+        std::string text;
+        while ((text = read(ring)).empty()) std::this_thread::yield();
+        ASSERT_EQ(text, expected);
+    }
+
+    producer.join();
+    EXPECT_TRUE(ring.front().empty());
+}
@@ -0,0 +1,643 @@
+// ---------------Queue.MessageQueue--------------- //
+//         
+//     Description: 
+//          Test MessageQueue under its concurrency policies
+//  
+//     Policies: 
+//        1. MutexPolicy
+//        2. LockFreePolicy
+//        3. SpscPolicy
+//        4. CoroutinePolicy
+//        5. PriorityPolicy
+//        6. Instrumented<> (enabled and disabled)
+//        7. CondVarWait / AtomicWait / SpinWait
+//        8. ShardedPolicy
+//
+//    Target:
+//        Correctness under concurrent producers / consumers
+//
+// ------------------------------------------------ //
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <core/executor.hpp>
+#include <core/message_queue.hpp>
+#include <core/queue/instrumented_queue.hpp>
+#include <core/queue/lock_free_queue.hpp>
+#include <core/queue/priority_queue.hpp>
+#include <core/queue/sharded_queue.hpp>
+#include <core/queue/spsc_queue.hpp>
+#include <core/queue/wait_strategy.hpp>
+
+using namespace labelimg::core::queue;
+
+// 多生产者多消费者: 所有元素恰好被消费一次
+template <typename Q>
+void run_mpmc_round_trip(Q& queue, int producers, int consumers, int per_producer) {
+    std::atomic<int> consumed{0};
+    std::vector<std::atomic<int>> seen(static_cast<size_t>(producers * per_producer));
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ++i) queue.push(p * per_producer + i);
+        });
+    }
+
+    const int total = producers * per_producer;
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            int value = 0;
+            while (consumed.load() < total) {
+                if (queue.wait_for_pop(value, std::chrono::milliseconds(10))) {
+                    seen[static_cast<size_t>(value)].fetch_add(1);
+                    consumed.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (auto& t: threads) t.join();
+
+    EXPECT_EQ(consumed.load(), total);
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](const auto& s) { return s.load() == 1; }));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MutexQueueTest, FifoOrder) {
+    MessageQueue<int, MutexPolicy> queue;
+    for (int i = 0; i < 10; ++i) queue.push(i);
+
+    int value = -1;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(MutexQueueTest, BulkPushAndPop) {
+    MessageQueue<std::string, MutexPolicy> queue;
+    std::vector<std::string> input{"a", "b", "c", "d", "e"};
+    queue.push_bulk(std::move(input));
+    EXPECT_EQ(queue.size(), 5U);
+
+    std::vector<std::string> out;
+    EXPECT_EQ(queue.try_pop_bulk(std::back_inserter(out), 3), 3U);
+    EXPECT_EQ(out, (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(queue.size(), 2U);
+}
+
+TEST(MutexQueueTest, DrainIntoTakesWholeBacklog) {
+    MessageQueue<int, MutexPolicy> queue;
+    std::vector<int> out{-1};
+    EXPECT_EQ(queue.drain_into(out), 0U);
+
+    const std::vector<int> input{1, 2, 3, 4};
+    queue.push_bulk(input);
+    EXPECT_EQ(queue.drain_into(out), 4U);
+    EXPECT_EQ(out, (std::vector<int>{-1, 1, 2, 3, 4}));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MutexQueueTest, WaitForDrainIntoWakesOnPush) {
+    MessageQueue<int, MutexPolicy> queue;
+    std::vector<int> out;
+    EXPECT_EQ(queue.wait_for_drain_into(out, std::chrono::milliseconds(5)), 0U);
+
+    std::thread producer([&] { queue.push(42); });
+    while (out.empty()) queue.wait_for_drain_into(out, std::chrono::milliseconds(100));
+    producer.join();
+
+    EXPECT_EQ(out, (std::vector<int>{42}));
+}
+
+TEST(BoundedMutexQueueTest, DropNewestRejectsOverflow) {
+    MessageQueue<int, BoundedMutexPolicy<3, OverflowPolicy::DropNewest>> queue;
+    for (int i = 0; i < 5; ++i) queue.push(i);
+
+    EXPECT_EQ(queue.size(), 3U);
+    EXPECT_EQ(queue.dropped_count(), 2U);
+    EXPECT_FALSE(queue.try_push(99));
+
+    std::vector<int> out;
+    queue.drain_into(out);
+    EXPECT_EQ(out, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(BoundedMutexQueueTest, DropOldestKeepsLatest) {
+    MessageQueue<int, BoundedMutexPolicy<3, OverflowPolicy::DropOldest>> queue;
+    for (int i = 0; i < 5; ++i) queue.push(i);
+    EXPECT_TRUE(queue.try_push(5));
+
+    std::vector<int> out;
+    queue.drain_into(out);
+    EXPECT_EQ(out, (std::vector<int>{3, 4, 5}));
+    EXPECT_EQ(queue.dropped_count(), 3U);
+}
+
+TEST(BoundedMutexQueueTest, SpillHandsOverflowToHandler) {
+    MessageQueue<std::string, BoundedMutexPolicy<2, OverflowPolicy::Spill>> queue;
+    std::vector<std::string> spilled;
+    queue.set_spill_handler([&](std::string&& value) { spilled.push_back(std::move(value)); });
+
+    queue.push_bulk(std::vector<std::string>{"a", "b", "c", "d"});
+
+    EXPECT_EQ(queue.size(), 2U);
+    EXPECT_EQ(spilled, (std::vector<std::string>{"c", "d"}));
+    EXPECT_EQ(queue.spilled_count(), 2U);
+}
+
+TEST(BoundedMutexQueueTest, BlockAppliesBackpressure) {
+    MessageQueue<int, BoundedMutexPolicy<4, OverflowPolicy::Block>> queue;
+    constexpr int count = 10000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) queue.push(i);
+    });
+
+    int value = -1;
+    bool ordered = true;
+    for (int i = 0; i < count; ++i) {
+        queue.wait_and_pop(value);
+        ordered = ordered && (value == i);
+        EXPECT_LE(queue.size(), 4U);
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(queue.dropped_count(), 0U);
+    EXPECT_GT(queue.blocked_count(), 0U);
+}
+
+TEST(MutexQueueTest, ConcurrentProducersConsumers) {
+    MessageQueue<int, MutexPolicy> queue;
+    run_mpmc_round_trip(queue, 4, 4, 5000);
+}
+
+TEST(LockFreeQueueTest, FifoOrderSingleThread) {
+    MessageQueue<std::string, LockFreePolicy<8>> queue;
+    for (int i = 0; i < 8; ++i) EXPECT_TRUE(queue.try_push(std::to_string(i)));
+    EXPECT_EQ(queue.size(), 8U);
+
+    std::string value;
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, std::to_string(i));
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(LockFreeQueueTest, TryPushRejectsWhenFull) {
+    MessageQueue<std::string, LockFreePolicy<4>> queue;
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(queue.try_push(std::string("x")));
+
+    std::string rejected = "keep me";
+    EXPECT_FALSE(queue.try_push(std::move(rejected)));
+    EXPECT_EQ(rejected, "keep me");
+
+    queue.pop();
+    EXPECT_TRUE(queue.try_push(std::move(rejected)));
+}
+
+TEST(LockFreeQueueTest, WrapAroundKeepsOrder) {
+    MessageQueue<int, LockFreePolicy<4>> queue;
+    int value = 0;
+    for (int round = 0; round < 100; ++round) {
+        queue.push(round);
+        queue.push(round + 1000);
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, round);
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, round + 1000);
+    }
+}
+
+TEST(LockFreeQueueTest, WaitForPopTimesOut) {
+    MessageQueue<int, LockFreePolicy<16>> queue;
+    int value = 0;
+    EXPECT_FALSE(queue.wait_for_pop(value, std::chrono::milliseconds(5)));
+}
+
+TEST(LockFreeQueueTest, ConcurrentProducersConsumers) {
+    MessageQueue<int, LockFreePolicy<256>> queue;
+    run_mpmc_round_trip(queue, 8, 4, 5000);
+}
+
+// 通过 CRTP 基类访问的通用接口
+template <typename Derived>
+auto drain_through_base(Queue<Derived, int>& queue) -> int {
+    int sum = 0;
+    while (!queue.empty()) {
+        sum += queue.front();
+        queue.pop();
+    }
+    return sum;
+}
+
+TEST(SpscQueueTest, UsableThroughCrtpBase) {
+    MessageQueue<int, SpscPolicy<16>> queue;
+    for (int i = 1; i <= 10; ++i) queue.push(i);
+    EXPECT_EQ(drain_through_base(queue), 55);
+}
+
+TEST(SpscQueueTest, TryPushRejectsWhenFull) {
+    MessageQueue<std::string, SpscPolicy<2>> queue;
+    EXPECT_TRUE(queue.try_push(std::string("a")));
+    EXPECT_TRUE(queue.try_push(std::string("b")));
+
+    std::string rejected = "c";
+    EXPECT_FALSE(queue.try_push(std::move(rejected)));
+    EXPECT_EQ(rejected, "c");
+}
+
+TEST(SpscQueueTest, BlockingHandoffPreservesOrder) {
+    constexpr int count = 100000;
+    MessageQueue<int, SpscPolicy<64>> queue;
+
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) queue.push(i);
+    });
+
+    int value = -1;
+    bool ordered = true;
+    for (int i = 0; i < count; ++i) {
+        queue.wait_and_pop(value);
+        ordered = ordered && (value == i);
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(PriorityQueueTest, HigherLaneServedFirst) {
+    using Policy = PriorityPolicy<3>;
+    MessageQueue<int, Policy> queue;
+    queue.push(30, Policy::lowest);
+    queue.push(10, Policy::highest);
+    queue.push(20);                       // 默认 normal 通道
+    queue.push(11, Policy::highest);
+
+    std::vector<int> order;
+    int value = 0;
+    while (queue.try_pop(value)) order.push_back(value);
+    EXPECT_EQ(order, (std::vector<int>{10, 11, 20, 30}));
+}
+
+TEST(PriorityQueueTest, LowLaneIsNotStarved) {
+    using Policy = PriorityPolicy<3>;
+    MessageQueue<int, Policy> queue{4};
+    queue.push(-1, Policy::lowest);
+    for (int i = 0; i < 20; ++i) queue.push(i, Policy::highest);
+
+    // 高优先级通道持续有元素, 低优先级元素在被跳过 4 次后得到服务
+    int value = 0;
+    int position = 0;
+    for (; queue.try_pop(value); ++position) {
+        if (value == -1) break;
+    }
+    EXPECT_EQ(value, -1);
+    EXPECT_EQ(position, 4);
+}
+
+TEST(PriorityQueueTest, ReprioritizeMovesQueuedItem) {
+    using Policy = PriorityPolicy<3>;
+    MessageQueue<std::string, Policy> queue;
+    queue.push("visible", Policy::normal);
+    auto ticket = queue.push("clicked", Policy::lowest);
+
+    EXPECT_TRUE(queue.reprioritize(ticket, Policy::highest));
+    EXPECT_EQ(queue.lane_size(Policy::lowest), 0U);
+    EXPECT_EQ(queue.front(), "clicked");
+
+    std::string value;
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, "clicked");
+    // 已出队的元素, 其 ticket 失效 (槽位复用后也不会误改新元素)
+    auto reused = queue.push("next", Policy::lowest);
+    EXPECT_EQ(reused.index, ticket.index);
+    EXPECT_FALSE(queue.reprioritize(ticket, Policy::highest));
+    EXPECT_EQ(queue.lane_size(Policy::lowest), 1U);
+}
+
+TEST(PriorityQueueTest, ConcurrentProducersConsumers) {
+    MessageQueue<int, PriorityPolicy<3>> queue;
+    run_mpmc_round_trip(queue, 4, 4, 5000);
+}
+
+TEST(ShardedQueueTest, ProducersMapToDistinctShards) {
+    using Sharded = MessageQueue<int, ShardedPolicy<16, 64>>;
+    std::vector<size_t> shards;
+    for (int i = 0; i < 4; ++i) {
+        std::thread([&] { shards.push_back(Sharded::producer_shard()); }).join();
+    }
+    std::ranges::sort(shards);
+    EXPECT_EQ(std::ranges::adjacent_find(shards), shards.end());
+}
+
+TEST(ShardedQueueTest, TryPushRejectsWhenOwnShardFull) {
+    MessageQueue<std::string, ShardedPolicy<4, 2>> queue;
+    EXPECT_TRUE(queue.try_push(std::string("a")));
+    EXPECT_TRUE(queue.try_push(std::string("b")));
+
+    std::string rejected = "keep me";
+    EXPECT_FALSE(queue.try_push(std::move(rejected)));
+    EXPECT_EQ(rejected, "keep me");
+    EXPECT_EQ(queue.size(), 2U);
+
+    std::string value;
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, "a");
+    EXPECT_TRUE(queue.try_push(std::move(rejected)));
+}
+
+TEST(ShardedQueueTest, PerProducerOrderIsPreserved) {
+    constexpr int producers    = 8;
+    constexpr int per_producer = 5000;
+    // 分片少于生产者, 覆盖多个生产者共享分片的情况
+    MessageQueue<int, ShardedPolicy<4, 64>> queue;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ++i) queue.push(p * per_producer + i);
+        });
+    }
+
+    std::vector<int> last(producers, -1);
+    bool ordered = true;
+    int value = 0;
+    for (int i = 0; i < producers * per_producer; ++i) {
+        queue.wait_and_pop(value);
+        int producer = value / per_producer;
+        ordered = ordered && (value % per_producer > last[static_cast<size_t>(producer)]);
+        last[static_cast<size_t>(producer)] = value % per_producer;
+    }
+    for (auto& t: threads) t.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(ShardedQueueTest, ConcurrentProducersConsumers) {
+    MessageQueue<int, ShardedPolicy<4, 64>> queue;
+    run_mpmc_round_trip(queue, 8, 4, 5000);
+
+    MessageQueue<int, ShardedPolicy<16, 256, SpinWait>> spinning;
+    run_mpmc_round_trip(spinning, 8, 4, 5000);
+}
+
+// 消费者先进入等待, 生产者稍后逐个入队: 每个元素都必须唤醒消费者
+template <typename Q>
+void run_blocking_handoff(Q& queue, int count) {
+    std::vector<int> received;
+    std::thread consumer([&] {
+        int value = 0;
+        for (int i = 0; i < count; ++i) {
+            queue.wait_and_pop(value);
+            received.push_back(value);
+        }
+    });
+
+    for (int i = 0; i < count; ++i) {
+        if (i % 8 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        queue.push(i);
+    }
+    consumer.join();
+
+    ASSERT_EQ(received.size(), static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) EXPECT_EQ(received[static_cast<size_t>(i)], i);
+}
+
+TEST(WaitStrategyTest, BlockingHandoffWakesConsumer) {
+    MessageQueue<int, BoundedMutexPolicy<0, OverflowPolicy::Block, AtomicWait>> mutex_atomic;
+    run_blocking_handoff(mutex_atomic, 64);
+
+    MessageQueue<int, BoundedMutexPolicy<0, OverflowPolicy::Block, SpinWait>> mutex_spin;
+    run_blocking_handoff(mutex_spin, 64);
+
+    MessageQueue<int, LockFreePolicy<16, AtomicWait>> lock_free_atomic;
+    run_blocking_handoff(lock_free_atomic, 64);
+
+    MessageQueue<int, LockFreePolicy<16, CondVarWait>> lock_free_cond;
+    run_blocking_handoff(lock_free_cond, 64);
+
+    MessageQueue<int, SpscPolicy<16, CondVarWait>> spsc_cond;
+    run_blocking_handoff(spsc_cond, 64);
+
+    MessageQueue<int, PriorityPolicy<3, AtomicWait>> priority_atomic;
+    run_blocking_handoff(priority_atomic, 64);
+}
+
+TEST(WaitStrategyTest, TimedWaitExpires) {
+    using namespace std::chrono_literals;
+    int value = 0;
+
+    MessageQueue<int, BoundedMutexPolicy<0, OverflowPolicy::Block, AtomicWait>> mutex_atomic;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(mutex_atomic.wait_for_pop(value, 20ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+
+    MessageQueue<int, SpscPolicy<16>> spsc;
+    start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(spsc.wait_for_pop(value, 20ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+
+    MessageQueue<int, LockFreePolicy<16, CondVarWait>> lock_free_cond;
+    EXPECT_FALSE(lock_free_cond.wait_for_pop(value, 5ms));
+}
+
+TEST(WaitStrategyTest, TimedWaitWakesOnPush) {
+    MessageQueue<int, BoundedMutexPolicy<0, OverflowPolicy::Block, AtomicWait>> queue;
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        queue.push(42);
+    });
+
+    int value = 0;
+    EXPECT_TRUE(queue.wait_for_pop(value, std::chrono::seconds(10)));
+    EXPECT_EQ(value, 42);
+    producer.join();
+}
+
+TEST(WaitStrategyTest, AtomicWaitBlocksFullProducers) {
+    MessageQueue<int, BoundedMutexPolicy<4, OverflowPolicy::Block, AtomicWait>> bounded;
+    run_blocking_handoff(bounded, 2000);
+    EXPECT_EQ(bounded.dropped_count(), 0U);
+
+    MessageQueue<int, SpscPolicy<4, AtomicWait>> spsc;
+    run_blocking_handoff(spsc, 2000);
+
+    MessageQueue<int, LockFreePolicy<4, AtomicWait>> lock_free;
+    run_mpmc_round_trip(lock_free, 4, 2, 2000);
+}
+
+TEST(WaitStrategyTest, ConcurrentProducersConsumers) {
+    MessageQueue<int, BoundedMutexPolicy<0, OverflowPolicy::Block, AtomicWait>> mutex_atomic;
+    run_mpmc_round_trip(mutex_atomic, 4, 4, 5000);
+
+    MessageQueue<int, BoundedMutexPolicy<64, OverflowPolicy::Block, AtomicWait>> bounded_atomic;
+    run_mpmc_round_trip(bounded_atomic, 4, 4, 5000);
+
+    MessageQueue<int, LockFreePolicy<64, CondVarWait>> lock_free_cond;
+    run_mpmc_round_trip(lock_free_cond, 4, 4, 5000);
+
+    MessageQueue<int, PriorityPolicy<3, AtomicWait>> priority_atomic;
+    run_mpmc_round_trip(priority_atomic, 4, 4, 5000);
+}
+
+TEST(InstrumentedQueueTest, TracksDepthAndLatency) {
+    MessageQueue<int, Instrumented<MutexPolicy>> queue;
+    for (int i = 0; i < 10; ++i) queue.push(i);
+
+    int value = 0;
+    for (int i = 0; i < 4; ++i) ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 3);
+
+    auto stats = queue.snapshot();
+    EXPECT_EQ(stats.depth, 6U);
+    EXPECT_EQ(stats.high_water, 10U);
+    EXPECT_EQ(stats.pushes, 10U);
+    EXPECT_EQ(stats.pops, 4U);
+
+    std::uint64_t samples = 0;
+    for (auto count: stats.latency_histogram) samples += count;
+    EXPECT_EQ(samples, 4U);
+    EXPECT_GT(stats.latency_p50_ns, 0.0);
+    EXPECT_LE(stats.latency_p50_ns, stats.latency_p999_ns);
+    EXPECT_FALSE(stats.to_string().empty());
+
+    queue.reset();
+    stats = queue.snapshot();
+    EXPECT_EQ(stats.pushes, 0U);
+    EXPECT_EQ(stats.high_water, 6U);
+}
+
+TEST(InstrumentedQueueTest, DroppedItemsDoNotInflateDepth) {
+    MessageQueue<int, Instrumented<BoundedMutexPolicy<4, OverflowPolicy::DropNewest>>> queue;
+    for (int i = 0; i < 100; ++i) queue.push(i);
+
+    auto stats = queue.snapshot();
+    EXPECT_EQ(stats.depth, 4U);
+    EXPECT_LE(stats.high_water, 5U);
+}
+
+TEST(InstrumentedQueueTest, WrapsLockFreeAndPriorityPolicies) {
+    MessageQueue<int, Instrumented<LockFreePolicy<64>>> lock_free;
+    run_mpmc_round_trip(lock_free, 4, 2, 2000);
+    EXPECT_EQ(lock_free.snapshot().pops, 8000U);
+    EXPECT_EQ(lock_free.snapshot().contended, 0U);
+
+    using Policy = PriorityPolicy<3>;
+    MessageQueue<int, Instrumented<Policy>> priority;
+    priority.push(2, Policy::lowest);
+    auto ticket = priority.push(1, Policy::lowest);
+    EXPECT_TRUE(priority.inner().reprioritize(ticket, Policy::highest));
+
+    int value = 0;
+    ASSERT_TRUE(priority.try_pop(value));
+    EXPECT_EQ(value, 1);
+}
+
+TEST(InstrumentedQueueTest, ConcurrentCountsAreConsistent) {
+    MessageQueue<int, Instrumented<MutexPolicy>> queue;
+    run_mpmc_round_trip(queue, 8, 4, 5000);
+    auto stats = queue.snapshot();
+    EXPECT_EQ(stats.pushes, 40000U);
+    EXPECT_EQ(stats.pops, 40000U);
+    EXPECT_EQ(stats.depth, 0U);
+}
+
+TEST(InstrumentedQueueTest, DisabledIsPlainQueue) {
+    using Disabled = MessageQueue<int, Instrumented<BoundedMutexPolicy<4, OverflowPolicy::DropNewest>, false>>;
+    static_assert(sizeof(Disabled) == sizeof(MessageQueue<int, BoundedMutexPolicy<4, OverflowPolicy::DropNewest>>));
+    static_assert(std::is_base_of_v<MessageQueue<int, BoundedMutexPolicy<4, OverflowPolicy::DropNewest>>, Disabled>);
+
+    Disabled queue;
+    for (int i = 0; i < 10; ++i) queue.push(i);
+    EXPECT_EQ(queue.size(), 4U);
+    EXPECT_EQ(queue.dropped_count(), 6U);
+
+    int value = 0;
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0);
+
+    auto stats = queue.snapshot();
+    EXPECT_EQ(stats.pushes, 0U);
+    EXPECT_EQ(stats.depth, 0U);
+    EXPECT_EQ(queue.contended_count(), 0U);
+}
+
+TEST(InstrumentedQueueTest, ContentionIsCountedOnlyInsideInstrumentedQueues) {
+    // 未经 Instrumented<> 包装的加锁策略不携带计数器
+    static_assert(std::is_empty_v<detail::LockCounter<false>>);
+    static_assert(!detail::counts_lock_contention<int>);
+    static_assert(detail::counts_lock_contention<Stamped<int>>);
+
+    MessageQueue<int, Instrumented<MutexPolicy>> queue;
+    run_mpmc_round_trip(queue, 8, 4, 5000);
+    EXPECT_EQ(queue.snapshot().contended, queue.inner().contended_count());
+}
+
+TEST(CoroutineQueueTest, InlineExecutorResumesOnPush) {
+    MessageQueue<int, CoroutinePolicy> queue;
+    std::vector<int> received;
+
+    auto consumer = [&]() -> Task<void> {
+        for (int i = 0; i < 3; ++i) received.push_back(co_await queue.async_pop());
+    };
+    auto task = consumer();
+    EXPECT_FALSE(task.is_ready());
+
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    EXPECT_TRUE(task.is_ready());
+    EXPECT_EQ(received, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(CoroutineQueueTest, ConcurrentProducersResumeOnExecutor) {
+    constexpr int producers = 4;
+    constexpr int per_producer = 2000;
+    constexpr int total = producers * per_producer;
+
+    ThreadExecutor executor;
+    MessageQueue<int, BasicCoroutinePolicy<ThreadExecutor>> queue{executor};
+
+    std::atomic<long long> sum{0};
+    std::atomic<bool> finished{false};
+    std::atomic<bool> resumed_off_producer{true};
+
+    auto consumer = [&]() -> Task<void> {
+        for (int i = 0; i < total; ++i) {
+            sum.fetch_add(co_await queue.async_pop());
+            if (i > 0 && !executor.is_current_thread()) resumed_off_producer = false;
+        }
+        finished = true;
+        finished.notify_all();
+    };
+    auto task = consumer();
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            for (int i = 1; i <= per_producer; ++i) queue.push(i);
+        });
+    }
+    for (auto& t: threads) t.join();
+
+    finished.wait(false);
+    executor.shutdown();
+
+    EXPECT_EQ(sum.load(), static_cast<long long>(producers) * per_producer * (per_producer + 1) / 2);
+    EXPECT_TRUE(resumed_off_producer.load());
+}
@@ -0,0 +1,139 @@
+// ---------------Queue.TaskCombinators--------------- //
+//
+//     Description:
+//          Test awaitable Task and its combinators
+//
+//     Components:
+//        1. co_await Task (symmetric transfer)
+//        2. when_all / when_any
+//        3. then / sync_wait
+//        4. FrameAllocator
+//
+//    Target:
+//        Tasks compose without blocking threads
+//
+// ---------------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <core/task_combinators.hpp>
+#include <core/thread_pool.hpp>
+
+using namespace labelimg::core::queue;
+
+namespace {
+
+// 由测试手动触发完成的任务
+auto wait_value(MessageQueue<int, CoroutinePolicy>& queue) -> Task<int> {
+    co_return co_await queue.async_pop();
+}
+
+} // namespace
+
+TEST(TaskTest, AwaitResumesWhenInnerTaskCompletes) {
+    MessageQueue<int, CoroutinePolicy> queue;
+    auto outer = [&]() -> Task<int> {
+        int value = co_await wait_value(queue);
+        co_return value * 2;
+    }();
+
+    EXPECT_FALSE(outer.is_ready());
+    queue.push(21);
+    ASSERT_TRUE(outer.is_ready());
+    EXPECT_EQ(outer.get(), 42);
+}
+
+TEST(TaskTest, ExceptionPropagatesThroughAwait) {
+    auto failing = []() -> Task<int> {
+        throw std::runtime_error("boom");
+        co_return 0;
+    };
+    auto outer = [&]() -> Task<void> { co_await failing(); }();
+
+    ASSERT_TRUE(outer.is_ready());
+    EXPECT_THROW(outer.get(), std::runtime_error);
+}
+
+TEST(TaskTest, WhenAllCollectsResultsInOrder) {
+    MessageQueue<int, CoroutinePolicy> first;
+    MessageQueue<int, CoroutinePolicy> second;
+    auto no_value = []() -> Task<void> { co_return; };
+
+    auto all = when_all(wait_value(first), no_value(), wait_value(second));
+    second.push(2);
+    EXPECT_FALSE(all.is_ready());
+    first.push(1);
+
+    ASSERT_TRUE(all.is_ready());
+    auto [a, unit, b] = std::move(all).get();
+    EXPECT_EQ(a, 1);
+    EXPECT_EQ(b, 2);
+    EXPECT_EQ(unit, std::monostate{});
+}
+
+TEST(TaskTest, WhenAnyReturnsFirstCompleted) {
+    MessageQueue<int, CoroutinePolicy> slow;
+    MessageQueue<int, CoroutinePolicy> fast;
+
+    auto any = when_any(wait_value(slow), wait_value(fast));
+    EXPECT_FALSE(any.is_ready());
+    fast.push(7);
+
+    ASSERT_TRUE(any.is_ready());
+    auto result = std::move(any).get();
+    EXPECT_EQ(result.index, 1U);
+    EXPECT_EQ(result.value, 7);
+
+    // 落选任务在 when_any 结束后仍可安全完成
+    slow.push(1);
+}
+
+TEST(TaskTest, ThenChainsContinuations) {
+    MessageQueue<int, CoroutinePolicy> queue;
+    auto chained = then(then(wait_value(queue), [](int v) { return std::to_string(v); }),
+                        [](std::string s) -> Task<std::size_t> { co_return s.size(); });
+
+    EXPECT_FALSE(chained.is_ready());
+    queue.push(12345);
+    EXPECT_EQ(sync_wait(chained), 5U);
+}
+
+TEST(TaskTest, FanOutOnPoolAndJoin) {
+    constexpr int count = 256;
+    WorkStealingPool pool{4};
+    std::atomic<int> started{0};
+
+    auto decode = [&](int i) -> Task<int> {
+        co_await pool.schedule();
+        started.fetch_add(1, std::memory_order_relaxed);
+        co_return i * i;
+    };
+
+    std::vector<Task<int>> tasks;
+    tasks.reserve(count);
+    for (int i = 0; i < count; ++i) tasks.push_back(decode(i));
+
+    auto results = sync_wait(when_all(std::move(tasks)));
+    ASSERT_EQ(results.size(), static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i) EXPECT_EQ(results[i], i * i);
+    EXPECT_EQ(started.load(), count);
+}
+
+TEST(FrameAllocatorTest, ShortLivedTasksReuseFrames) {
+    auto job = [](int i) -> Task<int> { co_return i + 1; };
+
+    // 先热身一次, 让当前线程的空闲链表里有一块同尺寸的帧
+    EXPECT_EQ(sync_wait(job(0)), 1);
+    auto before = FrameAllocator::thread_stats();
+    for (int i = 0; i < 1000; ++i) EXPECT_EQ(sync_wait(job(i)), i + 1);
+    auto after = FrameAllocator::thread_stats();
+
+    EXPECT_EQ(after.misses, before.misses);
+    EXPECT_GE(after.hits - before.hits, 1000U);
+    EXPECT_GT(after.peak_pooled_bytes, 0U);
+    EXPECT_GT(FrameAllocator::stats().hit_rate(), 0.0);
+}
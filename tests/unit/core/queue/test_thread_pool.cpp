@@ -0,0 +1,104 @@
+// ---------------Queue.WorkStealingPool--------------- //
+//         
+//     Description: 
+//          Test the work-stealing thread pool executor
+//  
+//     Components: 
+//        1. ChaseLevDeque
+//        2. WorkStealingPool
+//
+//    Target:
+//        Coroutines scheduled onto workers complete exactly once
+//
+// ---------------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <core/queue/detail/chase_lev_deque.hpp>
+#include <core/thread_pool.hpp>
+
+using namespace labelimg::core::queue;
+
+TEST(ChaseLevDequeTest, OwnerIsLifoThiefIsFifo) {
+    detail::ChaseLevDeque<int> deque{2};
+    for (int i = 0; i < 10; ++i) deque.push(i);   // 触发扩容
+    EXPECT_EQ(deque.size(), 10U);
+
+    EXPECT_EQ(deque.pop(), 9);
+    EXPECT_EQ(deque.steal(), 0);
+    EXPECT_EQ(deque.pop(), 8);
+    EXPECT_EQ(deque.steal(), 1);
+    EXPECT_EQ(deque.size(), 6U);
+}
+
+TEST(ChaseLevDequeTest, ConcurrentStealsTakeEachItemOnce) {
+    constexpr int count = 50000;
+    detail::ChaseLevDeque<int> deque{64};
+    std::vector<std::atomic<int>> taken(count);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            while (!done.load() || !deque.empty()) {
+                if (auto v = deque.steal()) taken[static_cast<size_t>(*v)].fetch_add(1);
+            }
+        });
+    }
+
+    for (int i = 0; i < count; ++i) {
+        deque.push(i);
+        if (i % 3 == 0) {
+            if (auto v = deque.pop()) taken[static_cast<size_t>(*v)].fetch_add(1);
+        }
+    }
+    while (auto v = deque.pop()) taken[static_cast<size_t>(*v)].fetch_add(1);
+    done = true;
+    for (auto& t: thieves) t.join();
+
+    for (int i = 0; i < count; ++i) EXPECT_EQ(taken[static_cast<size_t>(i)].load(), 1) << i;
+}
+
+TEST(WorkStealingPoolTest, ScheduleHopsOntoWorker) {
+    std::atomic<bool> on_worker{false};
+    std::vector<Task<void>> tasks;
+    {
+        WorkStealingPool pool{2};
+        auto job = [&]() -> Task<void> {
+            co_await pool.schedule();
+            on_worker = pool.is_worker_thread();
+        };
+        tasks.push_back(job());
+        pool.shutdown();
+    }
+    EXPECT_TRUE(on_worker.load());
+}
+
+TEST(WorkStealingPoolTest, ManyTasksRunExactlyOnce) {
+    constexpr int count = 20000;
+    std::atomic<int> executed{0};
+    std::mutex ids_mutex;
+    std::set<std::thread::id> thread_ids;
+    std::vector<Task<void>> tasks;
+    tasks.reserve(count);
+
+    WorkStealingPool pool{4};
+    auto job = [&]() -> Task<void> {
+        co_await pool.schedule();
+        executed.fetch_add(1);
+        // 在工作线程上再次投递, 进入本地队列, 供其他线程窃取
+        co_await pool.schedule();
+        std::lock_guard<std::mutex> lock{ids_mutex};
+        thread_ids.insert(std::this_thread::get_id());
+    };
+    for (int i = 0; i < count; ++i) tasks.push_back(job());
+    pool.shutdown();
+
+    EXPECT_EQ(executed.load(), count);
+    EXPECT_FALSE(thread_ids.contains(std::this_thread::get_id()));
+    for (const auto& task: tasks) EXPECT_TRUE(const_cast<Task<void>&>(task).is_ready());
+}
@@ -0,0 +1,137 @@
+// ---------------Queue.TimerWheel--------------- //
+//
+//     Description:
+//          Test hierarchical timer wheel
+//
+//     Components:
+//        1. schedule_after / cancel
+//        2. Cascading between levels
+//        3. co_await sleep_for (timer thread / executor)
+//
+//    Target:
+//        Timers never fire early and cancelled timers never fire
+//
+// ---------------------------------------------- //
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <latch>
+#include <mutex>
+#include <vector>
+
+#include <core/executor.hpp>
+#include <core/task_combinators.hpp>
+#include <core/timer_wheel.hpp>
+
+using namespace labelimg::core::queue;
+using namespace std::chrono_literals;
+
+TEST(TimerWheelTest, FiresAfterDelay) {
+    TimerWheel timer;
+    std::latch fired{1};
+
+    auto start = TimerWheel::Clock::now();
+    TimerWheel::Clock::time_point at;
+    timer.schedule_after(20ms, [&] {
+        at = TimerWheel::Clock::now();
+        fired.count_down();
+    });
+
+    fired.wait();
+    EXPECT_GE(at - start, 20ms);
+    EXPECT_EQ(timer.pending(), 0U);
+}
+
+TEST(TimerWheelTest, FiresInDeadlineOrder) {
+    TimerWheel timer;
+    std::mutex mutex;
+    std::vector<int> order;
+    std::latch fired{3};
+
+    auto record = [&](int value) {
+        return [&, value] {
+            std::lock_guard<std::mutex> lock{mutex};
+            order.push_back(value);
+            fired.count_down();
+        };
+    };
+    timer.schedule_after(30ms, record(3));
+    timer.schedule_after(10ms, record(1));
+    timer.schedule_after(20ms, record(2));
+
+    fired.wait();
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(TimerWheelTest, CancelledTimerNeverFires) {
+    TimerWheel timer;
+    std::atomic<bool> cancelled_fired{false};
+    std::latch fired{1};
+
+    auto id = timer.schedule_after(10ms, [&] { cancelled_fired = true; });
+    timer.schedule_after(30ms, [&] { fired.count_down(); });
+
+    EXPECT_TRUE(timer.cancel(id));
+    EXPECT_FALSE(timer.cancel(id));
+    fired.wait();
+    EXPECT_FALSE(cancelled_fired);
+}
+
+TEST(TimerWheelTest, ManyTimersNeverFireEarly) {
+    // 1µs 的 tick 让 0..50ms 的延迟跨越多层, 覆盖级联路径
+    TimerWheel timer{1us};
+    constexpr int count = 10'000;
+    std::atomic<int> early{0};
+    std::latch fired{count};
+
+    for (int i = 0; i < count; ++i) {
+        auto delay = std::chrono::microseconds((i * 7919) % 50'000);
+        auto deadline = TimerWheel::Clock::now() + delay;
+        timer.schedule_at(deadline, [&, deadline] {
+            if (TimerWheel::Clock::now() < deadline) early.fetch_add(1);
+            fired.count_down();
+        });
+    }
+
+    fired.wait();
+    EXPECT_EQ(early.load(), 0);
+}
+
+TEST(TimerWheelTest, FarTimerBeyondTopLevelCanBeCancelled) {
+    // 1ns 的 tick 下 4 层只覆盖约 4.3s, 10s 的任务停在顶层循环
+    TimerWheel timer{1ns};
+    std::latch fired{1};
+
+    auto far = timer.schedule_after(10s, [] {});
+    timer.schedule_after(5ms, [&] { fired.count_down(); });
+    fired.wait();
+
+    EXPECT_EQ(timer.pending(), 1U);
+    EXPECT_TRUE(timer.cancel(far));
+    EXPECT_EQ(timer.pending(), 0U);
+}
+
+TEST(TimerWheelTest, SleepForResumesCoroutine) {
+    TimerWheel timer;
+    auto start = TimerWheel::Clock::now();
+
+    // 协程参数保存在协程帧中, 不依赖临时 lambda 的捕获
+    auto task = [](TimerWheel& timer) -> Task<int> {
+        co_await timer.sleep_for(15ms);
+        co_return 7;
+    }(timer);
+
+    EXPECT_EQ(sync_wait(task), 7);
+    EXPECT_GE(TimerWheel::Clock::now() - start, 15ms);
+}
+
+TEST(TimerWheelTest, SleepForResumesOnExecutor) {
+    ThreadExecutor executor;
+
+    auto task = [](ThreadExecutor& executor) -> Task<bool> {
+        co_await sleep_for(10ms, executor);
+        co_return executor.is_current_thread();
+    }(executor);
+
+    EXPECT_TRUE(sync_wait(task));
+}